@@ -0,0 +1,90 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/bench/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/FindZLIB.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/SelectLibraryConfigurations.cmake"
+  "/usr/share/eigen3/cmake/Eigen3Config.cmake"
+  "/usr/share/eigen3/cmake/Eigen3ConfigVersion.cmake"
+  "/usr/share/eigen3/cmake/Eigen3Targets.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "bench/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "test/CMakeFiles/bl_test_support.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_octtree_build.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_octtree_cull.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_json_dump.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_bin_file.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_linear_octtree.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_cull_batch.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_obb_sat.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_ray_packet.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_gjk.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_intersect.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_json_parse.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_octtree_moves.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_octtree_knn.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_octtree_snapshot.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_hash_grid.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_sweep_prune.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_sweep.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_mesh_bounds.dir/DependInfo.cmake"
+  "test/CMakeFiles/test_rigid_body.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_octtree_slab.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_octtree_fit.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_octtree_fit_scalar.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_octtree_build.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_octtree_pairs.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_bvh.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_hash_grid.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_cull_batch.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_ray_packet.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_rigid_body.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_json.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench_sweep_prune.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_bvh.dir/bench_bvh.cpp.o"
+  "CMakeFiles/bench_bvh.dir/bench_bvh.cpp.o.d"
+  "bench_bvh"
+  "bench_bvh.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_bvh.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_cull_batch.dir/bench_cull_batch.cpp.o"
+  "CMakeFiles/bench_cull_batch.dir/bench_cull_batch.cpp.o.d"
+  "bench_cull_batch"
+  "bench_cull_batch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_cull_batch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_hash_grid.dir/bench_hash_grid.cpp.o"
+  "CMakeFiles/bench_hash_grid.dir/bench_hash_grid.cpp.o.d"
+  "bench_hash_grid"
+  "bench_hash_grid.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_hash_grid.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
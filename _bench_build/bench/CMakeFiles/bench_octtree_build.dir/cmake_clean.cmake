@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_octtree_build.dir/bench_octtree_build.cpp.o"
+  "CMakeFiles/bench_octtree_build.dir/bench_octtree_build.cpp.o.d"
+  "bench_octtree_build"
+  "bench_octtree_build.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_octtree_build.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
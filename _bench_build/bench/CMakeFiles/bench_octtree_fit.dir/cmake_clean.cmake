@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_octtree_fit.dir/bench_octtree_fit.cpp.o"
+  "CMakeFiles/bench_octtree_fit.dir/bench_octtree_fit.cpp.o.d"
+  "bench_octtree_fit"
+  "bench_octtree_fit.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_octtree_fit.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_octtree_fit_scalar.dir/bench_octtree_fit.cpp.o"
+  "CMakeFiles/bench_octtree_fit_scalar.dir/bench_octtree_fit.cpp.o.d"
+  "bench_octtree_fit_scalar"
+  "bench_octtree_fit_scalar.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_octtree_fit_scalar.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
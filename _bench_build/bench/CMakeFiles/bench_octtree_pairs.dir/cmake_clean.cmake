@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_octtree_pairs.dir/bench_octtree_pairs.cpp.o"
+  "CMakeFiles/bench_octtree_pairs.dir/bench_octtree_pairs.cpp.o.d"
+  "bench_octtree_pairs"
+  "bench_octtree_pairs.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_octtree_pairs.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
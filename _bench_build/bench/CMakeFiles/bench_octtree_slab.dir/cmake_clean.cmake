@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_octtree_slab.dir/bench_octtree_slab.cpp.o"
+  "CMakeFiles/bench_octtree_slab.dir/bench_octtree_slab.cpp.o.d"
+  "bench_octtree_slab"
+  "bench_octtree_slab.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_octtree_slab.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
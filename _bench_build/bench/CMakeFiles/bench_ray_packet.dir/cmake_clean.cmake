@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_ray_packet.dir/bench_ray_packet.cpp.o"
+  "CMakeFiles/bench_ray_packet.dir/bench_ray_packet.cpp.o.d"
+  "bench_ray_packet"
+  "bench_ray_packet.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_ray_packet.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
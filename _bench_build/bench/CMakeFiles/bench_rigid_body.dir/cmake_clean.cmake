@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_rigid_body.dir/bench_rigid_body.cpp.o"
+  "CMakeFiles/bench_rigid_body.dir/bench_rigid_body.cpp.o.d"
+  "bench_rigid_body"
+  "bench_rigid_body.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_rigid_body.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_sweep_prune.dir/bench_sweep_prune.cpp.o"
+  "CMakeFiles/bench_sweep_prune.dir/bench_sweep_prune.cpp.o.d"
+  "bench_sweep_prune"
+  "bench_sweep_prune.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_sweep_prune.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
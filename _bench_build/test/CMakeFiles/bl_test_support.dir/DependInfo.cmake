@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/bl_JSON.cpp" "test/CMakeFiles/bl_test_support.dir/__/src/bl_JSON.cpp.o" "gcc" "test/CMakeFiles/bl_test_support.dir/__/src/bl_JSON.cpp.o.d"
+  "/root/repo/src/bl_utility.cpp" "test/CMakeFiles/bl_test_support.dir/__/src/bl_utility.cpp.o" "gcc" "test/CMakeFiles/bl_test_support.dir/__/src/bl_utility.cpp.o.d"
+  "/root/repo/utility_program/bl_log.cpp" "test/CMakeFiles/bl_test_support.dir/__/utility_program/bl_log.cpp.o" "gcc" "test/CMakeFiles/bl_test_support.dir/__/utility_program/bl_log.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
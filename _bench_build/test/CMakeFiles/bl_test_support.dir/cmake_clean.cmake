@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bl_test_support.dir/__/src/bl_JSON.cpp.o"
+  "CMakeFiles/bl_test_support.dir/__/src/bl_JSON.cpp.o.d"
+  "CMakeFiles/bl_test_support.dir/__/src/bl_utility.cpp.o"
+  "CMakeFiles/bl_test_support.dir/__/src/bl_utility.cpp.o.d"
+  "CMakeFiles/bl_test_support.dir/__/utility_program/bl_log.cpp.o"
+  "CMakeFiles/bl_test_support.dir/__/utility_program/bl_log.cpp.o.d"
+  "libbl_test_support.a"
+  "libbl_test_support.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bl_test_support.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libbl_test_support.a"
+)
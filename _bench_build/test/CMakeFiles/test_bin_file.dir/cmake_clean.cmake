@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_bin_file.dir/test_bin_file.cpp.o"
+  "CMakeFiles/test_bin_file.dir/test_bin_file.cpp.o.d"
+  "test_bin_file"
+  "test_bin_file.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_bin_file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
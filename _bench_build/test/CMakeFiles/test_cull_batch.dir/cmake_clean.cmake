@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_cull_batch.dir/test_cull_batch.cpp.o"
+  "CMakeFiles/test_cull_batch.dir/test_cull_batch.cpp.o.d"
+  "test_cull_batch"
+  "test_cull_batch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_cull_batch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
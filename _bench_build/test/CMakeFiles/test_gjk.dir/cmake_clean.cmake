@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_gjk.dir/test_gjk.cpp.o"
+  "CMakeFiles/test_gjk.dir/test_gjk.cpp.o.d"
+  "test_gjk"
+  "test_gjk.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_gjk.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_hash_grid.dir/test_hash_grid.cpp.o"
+  "CMakeFiles/test_hash_grid.dir/test_hash_grid.cpp.o.d"
+  "test_hash_grid"
+  "test_hash_grid.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_hash_grid.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
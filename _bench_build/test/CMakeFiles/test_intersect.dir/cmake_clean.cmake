@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_intersect.dir/test_intersect.cpp.o"
+  "CMakeFiles/test_intersect.dir/test_intersect.cpp.o.d"
+  "test_intersect"
+  "test_intersect.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_intersect.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
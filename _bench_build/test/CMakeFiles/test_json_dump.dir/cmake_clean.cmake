@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_json_dump.dir/test_json_dump.cpp.o"
+  "CMakeFiles/test_json_dump.dir/test_json_dump.cpp.o.d"
+  "test_json_dump"
+  "test_json_dump.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_json_dump.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
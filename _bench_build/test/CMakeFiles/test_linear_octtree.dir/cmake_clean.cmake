@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_linear_octtree.dir/test_linear_octtree.cpp.o"
+  "CMakeFiles/test_linear_octtree.dir/test_linear_octtree.cpp.o.d"
+  "test_linear_octtree"
+  "test_linear_octtree.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_linear_octtree.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
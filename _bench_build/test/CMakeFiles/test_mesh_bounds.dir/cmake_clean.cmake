@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mesh_bounds.dir/test_mesh_bounds.cpp.o"
+  "CMakeFiles/test_mesh_bounds.dir/test_mesh_bounds.cpp.o.d"
+  "test_mesh_bounds"
+  "test_mesh_bounds.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mesh_bounds.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
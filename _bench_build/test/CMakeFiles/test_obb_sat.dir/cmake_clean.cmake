@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_obb_sat.dir/test_obb_sat.cpp.o"
+  "CMakeFiles/test_obb_sat.dir/test_obb_sat.cpp.o.d"
+  "test_obb_sat"
+  "test_obb_sat.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_obb_sat.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
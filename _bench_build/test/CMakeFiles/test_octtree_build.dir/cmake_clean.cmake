@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_octtree_build.dir/test_octtree_build.cpp.o"
+  "CMakeFiles/test_octtree_build.dir/test_octtree_build.cpp.o.d"
+  "test_octtree_build"
+  "test_octtree_build.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_octtree_build.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_octtree_cull.dir/test_octtree_cull.cpp.o"
+  "CMakeFiles/test_octtree_cull.dir/test_octtree_cull.cpp.o.d"
+  "test_octtree_cull"
+  "test_octtree_cull.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_octtree_cull.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
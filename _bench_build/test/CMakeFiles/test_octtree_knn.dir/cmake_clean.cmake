@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_octtree_knn.dir/test_octtree_knn.cpp.o"
+  "CMakeFiles/test_octtree_knn.dir/test_octtree_knn.cpp.o.d"
+  "test_octtree_knn"
+  "test_octtree_knn.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_octtree_knn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_octtree_moves.dir/test_octtree_moves.cpp.o"
+  "CMakeFiles/test_octtree_moves.dir/test_octtree_moves.cpp.o.d"
+  "test_octtree_moves"
+  "test_octtree_moves.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_octtree_moves.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
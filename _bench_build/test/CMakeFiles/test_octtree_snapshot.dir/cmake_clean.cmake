@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_octtree_snapshot.dir/test_octtree_snapshot.cpp.o"
+  "CMakeFiles/test_octtree_snapshot.dir/test_octtree_snapshot.cpp.o.d"
+  "test_octtree_snapshot"
+  "test_octtree_snapshot.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_octtree_snapshot.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_ray_packet.dir/test_ray_packet.cpp.o"
+  "CMakeFiles/test_ray_packet.dir/test_ray_packet.cpp.o.d"
+  "test_ray_packet"
+  "test_ray_packet.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_ray_packet.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
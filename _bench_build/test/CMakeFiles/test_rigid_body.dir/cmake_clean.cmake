@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_rigid_body.dir/test_rigid_body.cpp.o"
+  "CMakeFiles/test_rigid_body.dir/test_rigid_body.cpp.o.d"
+  "test_rigid_body"
+  "test_rigid_body.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_rigid_body.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
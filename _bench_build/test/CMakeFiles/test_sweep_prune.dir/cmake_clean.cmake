@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sweep_prune.dir/test_sweep_prune.cpp.o"
+  "CMakeFiles/test_sweep_prune.dir/test_sweep_prune.cpp.o.d"
+  "test_sweep_prune"
+  "test_sweep_prune.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sweep_prune.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
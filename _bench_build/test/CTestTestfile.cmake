@@ -0,0 +1,44 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_bench_build/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[test_octtree_build]=] "/root/repo/_bench_build/test/test_octtree_build")
+set_tests_properties([=[test_octtree_build]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;22;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_octtree_cull]=] "/root/repo/_bench_build/test/test_octtree_cull")
+set_tests_properties([=[test_octtree_cull]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;23;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_json_dump]=] "/root/repo/_bench_build/test/test_json_dump")
+set_tests_properties([=[test_json_dump]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;24;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_bin_file]=] "/root/repo/_bench_build/test/test_bin_file")
+set_tests_properties([=[test_bin_file]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;25;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_linear_octtree]=] "/root/repo/_bench_build/test/test_linear_octtree")
+set_tests_properties([=[test_linear_octtree]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;26;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_cull_batch]=] "/root/repo/_bench_build/test/test_cull_batch")
+set_tests_properties([=[test_cull_batch]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;27;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_obb_sat]=] "/root/repo/_bench_build/test/test_obb_sat")
+set_tests_properties([=[test_obb_sat]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;28;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_ray_packet]=] "/root/repo/_bench_build/test/test_ray_packet")
+set_tests_properties([=[test_ray_packet]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;29;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_gjk]=] "/root/repo/_bench_build/test/test_gjk")
+set_tests_properties([=[test_gjk]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;30;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_intersect]=] "/root/repo/_bench_build/test/test_intersect")
+set_tests_properties([=[test_intersect]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;31;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_json_parse]=] "/root/repo/_bench_build/test/test_json_parse")
+set_tests_properties([=[test_json_parse]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;32;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_octtree_moves]=] "/root/repo/_bench_build/test/test_octtree_moves")
+set_tests_properties([=[test_octtree_moves]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;33;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_octtree_knn]=] "/root/repo/_bench_build/test/test_octtree_knn")
+set_tests_properties([=[test_octtree_knn]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;34;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_octtree_snapshot]=] "/root/repo/_bench_build/test/test_octtree_snapshot")
+set_tests_properties([=[test_octtree_snapshot]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;35;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_hash_grid]=] "/root/repo/_bench_build/test/test_hash_grid")
+set_tests_properties([=[test_hash_grid]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;36;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_sweep_prune]=] "/root/repo/_bench_build/test/test_sweep_prune")
+set_tests_properties([=[test_sweep_prune]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;37;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_sweep]=] "/root/repo/_bench_build/test/test_sweep")
+set_tests_properties([=[test_sweep]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;38;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_mesh_bounds]=] "/root/repo/_bench_build/test/test_mesh_bounds")
+set_tests_properties([=[test_mesh_bounds]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;39;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test([=[test_rigid_body]=] "/root/repo/_bench_build/test/test_rigid_body")
+set_tests_properties([=[test_rigid_body]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;40;bl_add_test;/root/repo/test/CMakeLists.txt;0;")
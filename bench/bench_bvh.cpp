@@ -0,0 +1,99 @@
+// 用法: bench_bvh [对象数=200000] [射线数=100000]
+// BVH的建树与refit耗时, 以及射线, 盒与视锥体查询和OctTree的对比
+// 场景中1%的对象放大10倍, 模拟卡在八叉树浅层节点的大物体
+#include <vector>
+#include "bl_bench.hpp"
+#include "bl_bvh.hpp"
+#include "bl_octtree.hpp"
+using namespace BL::Math;
+using Bvh = BVH<uint32_t, float>;
+using Tree = OctTree<uint32_t, float>;
+using Vec3 = Bvh::Vec3;
+int main(int argc, char** argv) {
+    bench_header("BVH vs OctTree");
+    uint32_t n = bench_arg(argc, argv, 1, 200000);
+    uint32_t nr = bench_arg(argc, argv, 2, 100000);
+    std::mt19937 rng(8);
+    std::vector<Bvh::Box> boxes(n);
+    std::vector<uint32_t> data(n), data2(n);
+    for (uint32_t i = 0; i < n; i++) {
+        boxes[i] = i % 100 == 0 ? random_box(rng, 90, 0.5f, 15)
+                                : random_box(rng, 90, 0.05f, 1.5f);
+        data[i] = data2[i] = i;
+    }
+    Bvh bvh;
+    double build = bench_ms(3, [&] {
+        for (uint32_t i = 0; i < n; i++)
+            data[i] = i;
+        bvh.build(boxes, std::span<uint32_t>(data));
+    });
+    Tree tree;
+    tree.create({{100, 100, 100}, {-100, -100, -100}});
+    tree.build(boxes, std::span<uint32_t>(data2));
+    std::uniform_real_distribution<float> u(-90, 90), d(-0.3f, 0.3f);
+    for (uint32_t i = 0; i < n; i++) {
+        Vec3 delta(d(rng), d(rng), d(rng));
+        bvh.updateBox(i, {boxes[i].max() + delta, boxes[i].min() + delta});
+    }
+    double refit = bench_ms(3, [&] { bvh.refit(); });
+    std::printf("%u boxes: build %.1f ms (%u nodes), refit %.2f ms\n", n,
+                build, bvh.nodeSize(), refit);
+    // refit后两棵树的对象不同, 查询对比前以原位置重新refit
+    bvh.refit(boxes);
+
+    std::vector<Vec3> origins(nr), dirs(nr);
+    for (uint32_t i = 0; i < nr; i++) {
+        origins[i] = {u(rng), u(rng), u(rng)};
+        dirs[i] = Vec3(u(rng), u(rng), u(rng)).normalized();
+    }
+    float sum = 0;
+    double rb = bench_ms(3, [&] {
+        for (uint32_t i = 0; i < nr; i++)
+            sum += bvh.raycast(origins[i], dirs[i], 300).t;
+    });
+    double ro = bench_ms(3, [&] {
+        for (uint32_t i = 0; i < nr; i++)
+            sum += tree.raycast(origins[i], dirs[i], 300).t;
+    });
+    std::printf("%u rays:     BVH %8.1f ms, OctTree %8.1f ms\n", nr, rb, ro);
+
+    std::vector<Bvh::Box> queries(20000);
+    for (auto& q : queries)
+        q = random_box(rng, 90, 4, 4);
+    uint64_t hits = 0;
+    double fb = bench_ms(3, [&] {
+        for (auto& q : queries)
+            bvh.find(q, [&](const Bvh::Box&, uint32_t& v) { hits += v; });
+    });
+    double fo = bench_ms(3, [&] {
+        for (auto& q : queries)
+            tree.find(q, [&](const Tree::Box&, uint32_t& v) { hits += v; });
+    });
+    std::printf("%zu finds:  BVH %8.1f ms, OctTree %8.1f ms\n",
+                queries.size(), fb, fo);
+
+    std::vector<std::array<Plane<float>, 6>> frusta(200);
+    for (auto& planes : frusta) {
+        Vec3 c(u(rng), u(rng), u(rng));
+        for (auto& p : planes) {
+            Vec3 nrm = Vec3(u(rng), u(rng), u(rng)).normalized();
+            p.set(nrm, -nrm.dot(c) - 25);
+        }
+    }
+    std::vector<uint32_t> visible;
+    double cb = bench_ms(3, [&] {
+        for (auto& planes : frusta) {
+            visible.clear();
+            bvh.cull(planes, visible);
+        }
+    });
+    double co = bench_ms(3, [&] {
+        for (auto& planes : frusta) {
+            visible.clear();
+            tree.cull(planes, visible);
+        }
+    });
+    std::printf("%zu culls:    BVH %8.1f ms, OctTree %8.1f ms\n",
+                frusta.size(), cb, co);
+    std::printf("checksum %g %llu\n", sum, (unsigned long long)hits);
+}
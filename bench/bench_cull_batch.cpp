@@ -0,0 +1,46 @@
+// 用法: bench_cull_batch [盒数=1000000]
+// cullFrustumBatch在各指令集下的耗时, 有无平面缓存, 以及按盒数据量折算的带宽
+#include <vector>
+#include "bl_bench.hpp"
+#include "bl_collision_batch.hpp"
+using namespace BL::Math;
+using BL::vec3;
+// 法线朝外, 随cx平移的斜视锥体, 约3%的盒可见
+static std::array<Plane<float>, 6> frustum(float cx) {
+    std::array<Plane<float>, 6> p;
+    p[0].set(vec3<float>(-1, 0.2f, 0), cx - 30);
+    p[1].set(vec3<float>(1, 0.1f, 0), -cx - 30);
+    p[2].set(vec3<float>(0, -1, 0.3f), -30);
+    p[3].set(vec3<float>(0.2f, 1, 0), -30);
+    p[4].set(vec3<float>(0, 0, -1), -30);
+    p[5].set(vec3<float>(0, 0.1f, 1), -30);
+    return p;
+}
+int main(int argc, char** argv) {
+    bench_header("cullFrustumBatch");
+    uint32_t n = bench_arg(argc, argv, 1, 1000000);
+    std::mt19937 rng(9);
+    AABBSoA soa;
+    soa.resize(n);
+    for (uint32_t i = 0; i < n; i++)
+        soa.set(i, random_box(rng, 100, 1, 1));
+    std::vector<uint32_t> visible;
+    visible.reserve(n);
+    const char* names[] = {"scalar", "sse4.1", "avx2"};
+    for (int level = int(detect_simd_level()); level >= 0; level--) {
+        set_simd_level(SimdLevel(level));
+        for (int useCache = 0; useCache < 2; useCache++) {
+            std::vector<uint8_t> cache;
+            CullBatchScratch scratch;
+            int frame = 0;
+            double t = bench_ms(20, [&] {
+                visible.clear();
+                cullFrustumBatch(frustum(0.1f * frame++), soa, visible,
+                                 scratch, useCache ? &cache : nullptr);
+            });
+            double gbs = n * 6.0 * sizeof(float) / (t * 1e6);
+            std::printf("%-6s cache %d: %.3f ms (%.1f GB/s), %zu visible\n",
+                        names[level], useCache, t, gbs, visible.size());
+        }
+    }
+}
@@ -0,0 +1,47 @@
+// 用法: bench_hash_grid [点数=1000000] [格子边长=1]
+// SpatialHashGrid每帧完全重建的耗时, 以及同一场景的盒查询与相交对
+#include <vector>
+#include "bl_bench.hpp"
+#include "bl_hash_grid.hpp"
+using namespace BL::Math;
+using Grid = SpatialHashGrid<uint32_t, float>;
+int main(int argc, char** argv) {
+    bench_header("SpatialHashGrid rebuild");
+    uint32_t n = bench_arg(argc, argv, 1, 1000000);
+    float cell = argc > 2 ? std::atof(argv[2]) : 1.0f;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> u(-100, 100);
+    std::vector<AABB<float>> boxes(n);
+    std::vector<uint32_t> data(n);
+    for (uint32_t i = 0; i < n; i++) {
+        BL::vec3<float> c(u(rng), u(rng), u(rng));
+        boxes[i] = {c, c};
+        data[i] = i;
+    }
+    Grid g;
+    g.setCellSize(cell);
+    // 首次重建分配内存, 不计入
+    g.build(boxes, data);
+    double rebuild = bench_ms(30, [&] { g.build(boxes, data); });
+    std::printf("%u points, cell %g: rebuild %.2f ms (best of 30)\n", n, cell,
+                rebuild);
+    // 小物体场景的查询
+    for (uint32_t i = 0; i < n; i++) {
+        BL::vec3<float> c = boxes[i].c();
+        boxes[i] = {c + BL::vec3<float>::Constant(0.25f),
+                    c - BL::vec3<float>::Constant(0.25f)};
+    }
+    g.build(boxes, data);
+    uint64_t hits = 0;
+    double find = bench_ms(3, [&] {
+        for (int q = 0; q < 10000; q++) {
+            AABB<float> qb = random_box(rng, 95, 2, 2);
+            g.find(qb, [&](const AABB<float>&, uint32_t& v) { hits += v; });
+        }
+    });
+    Grid::PairList pairs;
+    double collect = bench_ms(3, [&] { g.collectPairs(pairs); });
+    std::printf("10000 finds %.1f ms, collectPairs %.1f ms (%zu pairs)\n",
+                find, collect, pairs.size());
+    std::printf("checksum %llu\n", (unsigned long long)hits);
+}
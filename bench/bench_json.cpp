@@ -0,0 +1,58 @@
+// 用法: bench_json [节点数=20000] [缩进=0] [测试递归实现=0]
+// 生成场景描述形式的JSON文档, 测试parse的吞吐量(GB/s)
+// 第三个参数非0时同时测试原递归下降实现parse_recursive
+#include <string>
+#include "bl_JSON.hpp"
+#include "bl_bench.hpp"
+using namespace BL::JSON;
+namespace BL::JSON {
+std::pair<JSONObject, size_t> parse_recursive(std::string_view json);
+}  // namespace BL::JSON
+// 缩进为0时不换行
+static std::string scene(uint32_t n, uint32_t indent) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> u(-100, 100), v(0, 1);
+    std::string nl = indent ? "\n" + std::string(indent, ' ') : "";
+    std::string nl2 = indent ? "\n" + std::string(indent * 2, ' ') : "";
+    std::string s = "{\"scene\": \"bench\", \"version\": 3, \"nodes\": [";
+    for (uint32_t i = 0; i < n; i++) {
+        s += (i ? "," : "") + nl + "{" + nl2;
+        s += "\"name\": \"node_" + std::to_string(i) + "\"," + nl2;
+        s += "\"mesh\": \"assets/meshes/m" + std::to_string(i % 97) +
+             ".mesh\"," + nl2;
+        s += std::string("\"visible\": ") + (i % 3 ? "true" : "false") + "," +
+             nl2 + "\"transform\": [";
+        for (int k = 0; k < 16; k++)
+            s += (k ? ", " : "") + std::to_string(u(rng));
+        s += "]," + nl2 + "\"material\": {\"albedo\": [";
+        for (int k = 0; k < 3; k++)
+            s += (k ? ", " : "") + std::to_string(v(rng));
+        s += "], \"roughness\": " + std::to_string(v(rng)) +
+             ", \"metal\": " + (i % 2 ? "false" : "true") +
+             ", \"tex\": \"textures/t\\\"" + std::to_string(i) +
+             "\\\".ktx\"}," + nl2;
+        s += "\"tags\": [\"static\", \"lod" + std::to_string(i % 4) + "\"]," +
+             nl2 + "\"children\": [" + std::to_string(i * 2 + 1) + ", " +
+             std::to_string(i * 2 + 2) + "]" + nl + "}";
+    }
+    return s + "]}";
+}
+int main(int argc, char** argv) {
+    bench_header("JSON parse");
+    uint32_t n = bench_arg(argc, argv, 1, 20000);
+    uint32_t indent = bench_arg(argc, argv, 2, 0);
+    bool recursive = bench_arg(argc, argv, 3, 0) != 0;
+    std::string text = scene(n, indent);
+    double gb = text.size() / 1e9;
+    size_t eaten = 0;
+    double ms = bench_ms(7, [&] { eaten = parse(text).second; });
+    std::printf("%.1f MB, %u nodes: parse %.1f ms, %.3f GB/s (eaten %zu)\n",
+                text.size() / 1e6, n, ms, gb / ms * 1e3, eaten);
+    if (recursive) {
+        // 递归实现遇到错误时写日志, 正常文档不会输出
+        ms = bench_ms(1, [&] { eaten = parse_recursive(text).second; });
+        std::printf("parse_recursive %.1f ms, %.4f GB/s (eaten %zu)\n", ms,
+                    gb / ms * 1e3, eaten);
+    }
+    return 0;
+}
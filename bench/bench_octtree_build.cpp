@@ -0,0 +1,36 @@
+// 用法: bench_octtree_build [对象数=500000]
+// 比较OctTree::build与逐个insert装载同一场景的耗时
+#include <vector>
+#include "bl_bench.hpp"
+#include "bl_octtree.hpp"
+using namespace BL::Math;
+using Tree = OctTree<uint32_t, float>;
+int main(int argc, char** argv) {
+    bench_header("OctTree build vs insert");
+    uint32_t n = bench_arg(argc, argv, 1, 500000);
+    std::mt19937 rng(2);
+    std::vector<Tree::Box> boxes(n);
+    for (auto& b : boxes)
+        b = random_box(rng, 99, 0.01f, 2);
+    std::vector<uint32_t> data(n);
+    uint32_t count = 0;
+    double ins = bench_ms(3, [&] {
+        Tree t;
+        t.create({{100, 100, 100}, {-100, -100, -100}});
+        uint32_t node;
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t h = t.insert(boxes[i], &node);
+            if (h != Tree::NULL_NEXT)
+                t.data(h) = i;
+        }
+    });
+    Tree t;
+    t.create({{100, 100, 100}, {-100, -100, -100}});
+    double bld = bench_ms(3, [&] {
+        for (uint32_t i = 0; i < n; i++)
+            data[i] = i;
+        count = t.build(boxes, std::span<uint32_t>(data));
+    });
+    std::printf("%u boxes (%u inside root): insert %.1f ms, build %.1f ms\n",
+                n, count, ins, bld);
+}
@@ -0,0 +1,52 @@
+// 用法: bench_octtree_fit [对象数=100000] [查询数=20000]
+// bench_octtree_fit_scalar为同一程序以BL_MATH_NO_SIMD编译, 两者对比即
+// intersectTest8的SIMD加速
+#include <vector>
+#include "bl_bench.hpp"
+#include "bl_octtree.hpp"
+using namespace BL::Math;
+using Tree = OctTree<uint32_t, float>;
+int main(int argc, char** argv) {
+#ifdef BL_MATH_NO_SIMD
+    bench_header("OctTree fit test (scalar)");
+#else
+    bench_header("OctTree fit test (SIMD)");
+#endif
+    uint32_t n = bench_arg(argc, argv, 1, 100000);
+    uint32_t nq = bench_arg(argc, argv, 2, 20000);
+    std::mt19937 rng(8);
+    std::vector<Tree::Box> boxes(n), queries(nq);
+    std::vector<Tree::Vec3> moves(n);
+    std::uniform_real_distribution<float> d(-0.5f, 0.5f);
+    for (uint32_t i = 0; i < n; i++) {
+        boxes[i] = random_box(rng, 90, 0.05f, 1.5f);
+        moves[i] = {d(rng), d(rng), d(rng)};
+    }
+    for (auto& q : queries)
+        q = random_box(rng, 90, 4, 4);
+    std::vector<uint32_t> handles(n);
+    uint64_t sum = 0;
+    double ins = 1e30, mv = 1e30, fnd = 1e30;
+    for (int rep = 0; rep < 3; rep++) {
+        Tree t;
+        t.create({{100, 100, 100}, {-100, -100, -100}});
+        uint32_t node;
+        ins = std::min(ins, bench_ms(1, [&] {
+            for (uint32_t i = 0; i < n; i++) {
+                handles[i] = t.insert(boxes[i], &node);
+                t.data(handles[i]) = i;
+            }
+        }));
+        fnd = std::min(fnd, bench_ms(1, [&] {
+            for (auto& q : queries)
+                t.find(q, [&](const Tree::Box&, uint32_t& v) { sum += v; });
+        }));
+        mv = std::min(mv, bench_ms(1, [&] {
+            for (uint32_t i = 0; i < n; i++)
+                t.move(handles[i], moves[i]);
+        }));
+    }
+    std::printf("%u boxes: insert %.1f ms, move %.1f ms, %u finds %.1f ms\n",
+                n, ins, mv, nq, fnd);
+    std::printf("checksum %llu\n", (unsigned long long)sum);
+}
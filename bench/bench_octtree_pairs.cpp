@@ -0,0 +1,47 @@
+// 用法: bench_octtree_pairs [对象数...], 缺省为10000 100000 1000000
+// 比较collectPairs与对每个对象调用一次find得到全部相交对的耗时
+#include <vector>
+#include "bl_bench.hpp"
+#include "bl_octtree.hpp"
+using namespace BL::Math;
+using Tree = OctTree<uint32_t, float>;
+static void run(uint32_t n) {
+    std::mt19937 rng(6);
+    std::vector<Tree::Box> boxes(n);
+    std::vector<uint32_t> data(n);
+    for (uint32_t i = 0; i < n; i++) {
+        boxes[i] = random_box(rng, 90, 0.05f, 1.5f);
+        data[i] = i;
+    }
+    Tree t;
+    t.create({{100, 100, 100}, {-100, -100, -100}});
+    t.build(boxes, std::span<uint32_t>(data));
+    Tree::PairList pairs;
+    double collect = bench_ms(3, [&] {
+        pairs.clear();
+        t.collectPairs(pairs);
+    });
+    // find对每对相交对象会各报告一次, 且包含对象自身
+    uint64_t hits = 0;
+    double finds = bench_ms(1, [&] {
+        hits = 0;
+        for (uint32_t i = 0; i < n; i++)
+            t.find(boxes[i], [&](const Tree::Box&, uint32_t& v) {
+                hits += v != i;
+            });
+    });
+    std::printf("%8u boxes: collectPairs %9.1f ms (%zu pairs), "
+                "N x find %9.1f ms (%llu pairs)\n",
+                n, collect, pairs.size(), finds,
+                (unsigned long long)hits / 2);
+}
+int main(int argc, char** argv) {
+    bench_header("OctTree collectPairs vs N x find");
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++)
+            run(bench_arg(argc, argv, i, 0));
+    } else {
+        for (uint32_t n : {10000u, 100000u, 1000000u})
+            run(n);
+    }
+}
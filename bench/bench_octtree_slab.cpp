@@ -0,0 +1,45 @@
+// 用法: bench_octtree_slab [对象数=1000000]
+// 插入, 移动并删除全部对象, 测量OctTree数据块池的开销
+#include <vector>
+#include "bl_bench.hpp"
+#include "bl_octtree.hpp"
+using namespace BL::Math;
+using Tree = OctTree<uint32_t, float>;
+int main(int argc, char** argv) {
+    bench_header("OctTree insert/move/drop");
+    uint32_t n = bench_arg(argc, argv, 1, 1000000);
+    std::mt19937 rng(1);
+    std::vector<Tree::Box> boxes(n);
+    std::vector<Tree::Vec3> moves(n);
+    std::uniform_real_distribution<float> d(-0.5f, 0.5f);
+    for (uint32_t i = 0; i < n; i++) {
+        boxes[i] = random_box(rng, 95, 0.05f, 1.5f);
+        moves[i] = {d(rng), d(rng), d(rng)};
+    }
+    std::vector<uint32_t> handles(n);
+    double ins = 0, mv = 0, drop = 0;
+    for (int rep = 0; rep < 3; rep++) {
+        Tree t;
+        t.create({{100, 100, 100}, {-100, -100, -100}});
+        uint32_t node;
+        double a = bench_ms(1, [&] {
+            for (uint32_t i = 0; i < n; i++) {
+                handles[i] = t.insert(boxes[i], &node);
+                t.data(handles[i]) = i;
+            }
+        });
+        double b = bench_ms(1, [&] {
+            for (uint32_t i = 0; i < n; i++)
+                t.move(handles[i], moves[i]);
+        });
+        double c = bench_ms(1, [&] {
+            for (uint32_t i = 0; i < n; i++)
+                t.drop(handles[i]);
+        });
+        ins = rep ? std::min(ins, a) : a;
+        mv = rep ? std::min(mv, b) : b;
+        drop = rep ? std::min(drop, c) : c;
+    }
+    std::printf("%u boxes: insert %.1f ms, move %.1f ms, drop %.1f ms\n", n,
+                ins, mv, drop);
+}
@@ -0,0 +1,52 @@
+// 用法: bench_rigid_body [每层边长=50] [层数=4] [步数=300] [随机朝向=0]
+// 无渲染的落箱场景: nx * nx * 层数个单位盒落到地面上, 以1/60秒步进
+// 输出每秒模拟时间的状态与每步的平均/最坏耗时
+#include "bl_bench.hpp"
+#include "bl_rigid_body.hpp"
+using namespace BL::Math;
+using World = RigidWorld<float>;
+using V = World::Vec3;
+int main(int argc, char** argv) {
+    bench_header("rigid body falling boxes");
+    int nx = bench_arg(argc, argv, 1, 50);
+    int layers = bench_arg(argc, argv, 2, 4);
+    int steps = bench_arg(argc, argv, 3, 300);
+    bool rot = bench_arg(argc, argv, 4, 0) != 0;
+    World w;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> u(-1, 1);
+    w.addBox(V(200, 1, 200), V(0, -1, 0), 0);
+    for (int l = 0; l < layers; l++)
+        for (int i = 0; i < nx; i++)
+            for (int k = 0; k < nx; k++) {
+                World::Quat q = World::Quat::Identity();
+                if (rot)
+                    q = World::Quat(Eigen::AngleAxis<float>(
+                        u(rng) * 3.14f,
+                        V(u(rng), u(rng), u(rng)).normalized()));
+                V p((i - nx / 2) * 1.5f + u(rng) * 0.1f, 1 + l * 1.5f,
+                    (k - nx / 2) * 1.5f + u(rng) * 0.1f);
+                w.addBox(V(0.5f, 0.5f, 0.5f), p, 1, q);
+            }
+    double total = 0, worst = 0;
+    for (int s = 0; s < steps; s++) {
+        double ms = bench_ms(1, [&] { w.step(1.0f / 60); });
+        total += ms;
+        worst = std::max(worst, ms);
+        if (s % 60 != 59)
+            continue;
+        float maxV = 0, maxPen = 0;
+        for (uint32_t i = 1; i < w.bodyCount(); i++)
+            maxV = std::max(maxV, w.body(i).linearVelocity.norm());
+        for (const auto& m : w.getManifolds())
+            for (uint32_t p = 0; p < m.count; p++)
+                maxPen = std::max(maxPen, -m.points[p].separation);
+        std::printf("t=%ds: %u islands, %u contacts, max v %.3f, "
+                    "max penetration %.4f\n",
+                    (s + 1) / 60, w.islandCount(), w.contactCount(), maxV,
+                    maxPen);
+    }
+    std::printf("%d bodies: %.2f ms/step avg, worst %.2f ms\n",
+                nx * nx * layers, total / steps, worst);
+    return 0;
+}
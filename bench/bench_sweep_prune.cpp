@@ -0,0 +1,85 @@
+// 用法: bench_sweep_prune [对象数=100000] [帧数=60] [速度...]
+// 速度缺省依次为0.002 0.01 0.05, 即每帧移动的最大距离(对象半边长0.05到1.5)
+// 对象以各自的恒定速度移动(碰到边界反弹), 比较每帧得到相交对的耗时:
+// SweepAndPrune的move+commit(增量的added/removed, 以及再collectPairs得到全部对)
+// 与OctTree的queueMove+commitMoves+collectPairs
+#include <vector>
+#include "bl_bench.hpp"
+#include "bl_octtree.hpp"
+#include "bl_sweep_prune.hpp"
+using namespace BL::Math;
+using Tree = OctTree<uint32_t, float>;
+using SAP = SweepAndPrune<uint32_t, float>;
+using Vec3 = BL::vec3<float>;
+static void run(uint32_t n, int frames, float speed) {
+    std::mt19937 rng(15);
+    std::uniform_real_distribution<float> d(-speed, speed);
+    std::vector<Tree::Box> boxes(n);
+    std::vector<Vec3> vel(n);
+    std::vector<uint32_t> data(n), handles(n);
+    for (uint32_t i = 0; i < n; i++) {
+        boxes[i] = random_box(rng, 90, 0.05f, 1.5f);
+        vel[i] = Vec3(d(rng), d(rng), d(rng));
+        data[i] = i;
+    }
+    Tree t;
+    t.create({{100, 100, 100}, {-100, -100, -100}});
+    t.build(boxes, std::span<uint32_t>(data), handles);
+    SAP sap;
+    std::vector<uint32_t> sapHandles(n);
+    for (uint32_t i = 0; i < n; i++) {
+        sapHandles[i] = sap.insert(boxes[i]);
+        sap.data(sapHandles[i]) = i;
+    }
+    sap.commit();
+    double sapMs = 0, sapAllMs = 0, treeMs = 0;
+    size_t changes = 0, sapPairs = 0, treePairs = 0;
+    SAP::PairList sapList;
+    Tree::PairList treeList;
+    for (int f = 0; f < frames; f++) {
+        for (uint32_t i = 0; i < n; i++) {
+            Vec3 c = boxes[i].c() + vel[i];
+            if ((c.array().abs() > 95).any())
+                vel[i] = -vel[i];
+            boxes[i] = {boxes[i].max() + vel[i], boxes[i].min() + vel[i]};
+        }
+        sapMs += bench_ms(1, [&] {
+            for (uint32_t i = 0; i < n; i++)
+                sap.move(sapHandles[i], vel[i]);
+            sap.commit();
+        });
+        changes += sap.added().size() + sap.removed().size();
+        sapAllMs += bench_ms(1, [&] { sap.collectPairs(sapList); });
+        treeMs += bench_ms(1, [&] {
+            for (uint32_t i = 0; i < n; i++)
+                t.queueMove(handles[i], vel[i]);
+            t.commitMoves();
+            treeList.clear();
+            t.collectPairs(treeList);
+        });
+        sapPairs = sapList.size();
+        treePairs = treeList.size();
+    }
+    sapAllMs += sapMs;
+    std::printf("%u boxes, %d frames, speed %g: %zu pairs (octree %zu), "
+                "%.1f added+removed per frame\n",
+                n, frames, speed, sapPairs, treePairs,
+                double(changes) / frames);
+    std::printf("SweepAndPrune commit %.2f ms/frame, +collectPairs %.2f ms\n",
+                sapMs / frames, sapAllMs / frames);
+    std::printf("OctTree commitMoves+collectPairs %.2f ms/frame (%.1fx)\n",
+                treeMs / frames, treeMs / sapMs);
+}
+int main(int argc, char** argv) {
+    bench_header("SweepAndPrune vs OctTree pairs on coherent motion");
+    uint32_t n = bench_arg(argc, argv, 1, 100000);
+    int frames = bench_arg(argc, argv, 2, 60);
+    if (argc > 3) {
+        for (int i = 3; i < argc; i++)
+            run(n, frames, std::atof(argv[i]));
+    } else {
+        for (float speed : {0.002f, 0.01f, 0.05f})
+            run(n, frames, speed);
+    }
+    return 0;
+}
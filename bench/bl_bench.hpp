@@ -0,0 +1,32 @@
+#ifndef _BOUNDLESS_BENCH_HPP_FILE_
+#define _BOUNDLESS_BENCH_HPP_FILE_
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "bl_test.hpp"
+/*
+ * 基准用的计时工具, 结果取多次运行的最小值以减少干扰
+ */
+template <typename F>
+double bench_ms(int reps, F&& fn) {
+    double best = 1e30;
+    for (int i = 0; i < reps; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(
+            best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    return best;
+}
+// 第i个命令行参数, 没有时返回def
+inline long bench_arg(int argc, char** argv, int i, long def) {
+    return argc > i ? std::atol(argv[i]) : def;
+}
+inline void bench_header(const char* name) {
+    std::printf("%s (%u hardware threads)\n", name,
+                std::thread::hardware_concurrency());
+}
+#endif  //!_BOUNDLESS_BENCH_HPP_FILE_
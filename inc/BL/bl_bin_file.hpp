@@ -2,6 +2,7 @@
 #define _BOUNDLESS_BIN_FILE_CXX_HPP_
 #include <zlib.h>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <vector>
 #include "bl_log.hpp"
@@ -27,6 +28,7 @@ struct CompressedBlock {
 class FileReader {
     std::ifstream _file;
     uint32_t crc32;
+    uint32_t headCrc32 = 0;
 
    public:
     FileReader() = default;
@@ -35,15 +37,19 @@ class FileReader {
         if (!_file.is_open())
             print_error("FileReader", "Could not open file:", path);
         HeadBlock h;
-        _file.read((char*)h, sizeof(h));
+        _file.read((char*)&h, sizeof(h));
         if (_file.bad())
             print_error("FileReader", "Read Error!");
-        if (h.head != head || h.type != type)
+        if (h.head != head || h.type != type) {
             print_error("FileReader", "File head error!");
+            _file.setstate(std::ios::failbit);
+        }
+        headCrc32 = h.crc32;
     }
     FileReader(const FileReader&) = delete;
     FileReader(FileReader&& other) { _file = std::move(other._file); }
-    std::ifstream& file() { return file; }
+    std::ifstream& file() { return _file; }
+    bool good() const { return _file.good(); }
     void close() {
         crc32 = (~0u);
         _file.close();
@@ -64,25 +70,27 @@ class FileReader {
         uint8_t* data = new uint8_t[bp->compressSize];
         uint8_t* realData = new uint8_t[bp->realSize];
         _file.read((char*)data, bp->compressSize);
-        uint32_t destLen = bp->realSize;
-        int r = uncompress((Bytef*)realData, (uLongf*)&destLen, (Bytef*)data,
-                           (uLong)bp->compress_size);
+        uLongf destLen = bp->realSize;
+        int r = uncompress((Bytef*)realData, &destLen, (Bytef*)data,
+                           (uLong)bp->compressSize);
+        delete[] data;
         if (r != Z_OK) {
+            delete[] realData;
             *save = nullptr;
             print_error("FileReader", "Uncompressing failed! Code:", r);
+            return;
         }
-        delete[] data;
         *save = realData;
     }
     template <size_t len>
     void read(StringBlock<len>* bp, ReferenceBlock* ref) {
         _file.seekg(ref->offset);
-        _file.read((char*)bp, std::min(sizeof(*bp), ref->size));
+        _file.read((char*)bp, std::min<size_t>(sizeof(*bp), ref->size));
     }
     template <typename T>
     void read(T* bp, ReferenceBlock* ref) {
         _file.seekg(ref->offset);
-        _file.read((char*)bp, std::min(sizeof(*bp), ref->size));
+        _file.read((char*)bp, std::min<size_t>(sizeof(*bp), ref->size));
     }
     void read(ReferenceBlock* bp, ReferenceBlock* ref) {
         _file.seekg(ref->offset);
@@ -108,6 +116,26 @@ class FileReader {
             _file.read((char*)&bp[i], sizeof(uint32_t) * 2);
         }
     }
+    // 一次读入头部之后的全部内容并校验CRC32, 失败时返回false
+    bool read_all(std::vector<uint8_t>& out) {
+        if (!_file.good())
+            return false;
+        std::streampos begin = _file.tellg();
+        _file.seekg(0, std::ios::end);
+        std::streamoff size = _file.tellg() - begin;
+        _file.seekg(begin);
+        out.resize(size);
+        _file.read((char*)out.data(), size);
+        if (_file.bad()) {
+            print_error("FileReader", "Read Error!");
+            return false;
+        }
+        if (calcCRC32(~0u, out.data(), out.size()) != headCrc32) {
+            print_error("FileReader", "CRC32 check failed!");
+            return false;
+        }
+        return true;
+    }
 };
 class FileWriter {
     std::ofstream file;
@@ -121,8 +149,8 @@ class FileWriter {
         file.open(path, std::ios::binary | std::ios::trunc);
         if (!file.is_open())
             print_error("FileWriter", "Could not open file:", path);
-        HeadBlock h{.head = head, .type = type};
-        file.write((char*)h, sizeof(h));
+        HeadBlock h{.head = head, .type = type, .crc32 = 0};
+        file.write((char*)&h, sizeof(h));
         curEof += sizeof(h);
         if (file.bad())
             print_error("FileWriter", "Write Error!");
@@ -147,27 +175,34 @@ class FileWriter {
     void write(const StringBlock<len>* bp) {
         size_t st = temp.size();
         temp.resize(st + sizeof(*bp));
-        memcpy((void*)temp.data() + st, (void*)bp, sizeof(*bp));
+        memcpy(temp.data() + st, (const void*)bp, sizeof(*bp));
     }
     template <typename T>
     void write(T* bp) {
         size_t st = temp.size();
         temp.resize(st + sizeof(*bp));
-        memcpy((void*)temp.data() + st, (void*)bp, sizeof(*bp));
+        memcpy(temp.data() + st, (const void*)bp, sizeof(*bp));
+    }
+    template <typename T>
+    void write_array(const T* bp, size_t count) {
+        size_t st = temp.size();
+        temp.resize(st + sizeof(T) * count);
+        memcpy(temp.data() + st, (const void*)bp, sizeof(T) * count);
     }
     void addRef(ReferenceBlock* bp) {
         bp->refOffset = temp.size();
         temp.resize(temp.size() + sizeof(uint32_t) * 2);
     }
     void write(ReferenceBlock* bp) {
-        memcpy((void*)temp.data() + bp->refOffset, (void*)bp,
+        memcpy(temp.data() + bp->refOffset, (const void*)bp,
                sizeof(uint32_t) * 2);
     }
     void write(const uint8_t* data, uint32_t size, int compress_level = 7) {
-        uint32_t allocSize = compressBound(size);
+        // uLongf在部分平台上为64位, 不能以uint32_t的地址传入
+        uLongf allocSize = compressBound(size);
         size_t st = temp.size();
         temp.resize(st + allocSize);
-        int r = compress2((Bytef*)temp.data() + st, (uLongf*)&allocSize,
+        int r = compress2((Bytef*)temp.data() + st, &allocSize,
                           (Bytef*)data, (uLong)size, compress_level);
         if (r != Z_OK) {
             print_error("FileWriter", "Compressing failed! Code:", r);
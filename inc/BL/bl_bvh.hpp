@@ -0,0 +1,460 @@
+#ifndef _BOUNDLESS_BVH_CXX_HPP_
+#define _BOUNDLESS_BVH_CXX_HPP_
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <vector>
+#include "bl_collision.hpp"
+#include "bl_collision_batch.hpp"
+#include "bl_parallel.hpp"
+namespace BL::Math {
+// 面向静态物体的层次包围盒树, 以分桶SAH自顶向下建树
+// 节点扁平存放, 内部节点的两个子节点相邻, 且下标总大于父节点, refit可逆序一次完成
+template <typename T, std::floating_point Scalar>
+class BVH {
+   public:
+    using Box = AABB<Scalar>;
+    using Vec3 = vec3<Scalar>;
+    using IterateFunction = std::function<void(const Box&, T&)>;
+    static constexpr uint32_t NULL_NEXT = (~0u);
+    static constexpr uint32_t BIN_COUNT = 16;
+    // 树的最大深度, 决定遍历栈的大小, 到达时强制生成叶节点
+    static constexpr uint32_t DEPTH_LIMIT = 64;
+    // 对象数超过该值的节点在线程池中并行分桶与建立子树
+    static constexpr uint32_t PARALLEL_THRESHOLD = 4096;
+    struct Node {
+        Box box;
+        // 内部节点为左子节点(右子节点为first+1), 叶节点为prims中的起点
+        uint32_t first;
+        uint32_t count;  // 叶节点的对象数, 内部节点为0
+    };
+    static_assert(!std::same_as<Scalar, float> || sizeof(Node) == 32);
+    struct RayHit {
+        uint32_t prim = NULL_NEXT;
+        Scalar t;
+    };
+
+   private:
+    std::vector<Node> nodes;
+    std::vector<uint32_t> prims;  // 按叶节点顺序排列的对象序号
+    std::vector<Box> boxes;       // 以对象序号为下标
+    std::vector<Vec3> centroids;
+    std::vector<T> objects;
+    std::atomic<uint32_t> nodeCount = 0;
+    uint32_t nodeMaxData = 4;
+
+    struct Bin {
+        Box box = emptyBox();
+        uint32_t count = 0;
+    };
+    using BinSet = std::array<std::array<Bin, BIN_COUNT>, 3>;
+    static Box emptyBox() {
+        constexpr Scalar inf = std::numeric_limits<Scalar>::infinity();
+        return {Vec3::Constant(-inf), Vec3::Constant(inf)};
+    }
+    static void grow(Box& a, const Box& b) {
+        a.max() = a.max().cwiseMax(b.max());
+        a.min() = a.min().cwiseMin(b.min());
+    }
+    static void grow(Box& a, const Vec3& p) {
+        a.max() = a.max().cwiseMax(p);
+        a.min() = a.min().cwiseMin(p);
+    }
+    // 表面积的一半, 仅用于比较
+    static Scalar halfArea(const Box& b) {
+        Vec3 e = b.max() - b.min();
+        return e.x() * e.y() + e.y() * e.z() + e.z() * e.x();
+    }
+    // prims[begin, end)的包围盒与中心点包围盒, 大区间在线程池中并行计算
+    std::pair<Box, Box> rangeBounds(uint32_t begin, uint32_t end) const {
+        auto fn = [&](uint32_t b, uint32_t e, std::pair<Box, Box>& res) {
+            for (uint32_t i = b; i < e; i++) {
+                grow(res.first, boxes[prims[i]]);
+                grow(res.second, centroids[prims[i]]);
+            }
+        };
+        std::pair<Box, Box> res = {emptyBox(), emptyBox()};
+        if (end - begin <= PARALLEL_THRESHOLD) {
+            fn(begin, end, res);
+            return res;
+        }
+        ThreadPool& pool = default_thread_pool();
+        std::vector<std::pair<Box, Box>> part(pool.size(), res);
+        pool.parallel_for(end - begin, PARALLEL_THRESHOLD / 4,
+                          [&](uint32_t b, uint32_t e, uint32_t s) {
+                              fn(begin + b, begin + e, part[s]);
+                          });
+        for (const auto& p : part) {
+            grow(res.first, p.first);
+            grow(res.second, p.second);
+        }
+        return res;
+    }
+    static uint32_t binOf(Scalar c, Scalar lo, Scalar scale) {
+        return std::min(uint32_t(std::max((c - lo) * scale, Scalar(0))),
+                        BIN_COUNT - 1);
+    }
+    void binRange(uint32_t begin,
+                  uint32_t end,
+                  const Vec3& lo,
+                  const Vec3& scale,
+                  BinSet& bins) const {
+        auto fn = [&](uint32_t b, uint32_t e, BinSet& res) {
+            for (uint32_t i = b; i < e; i++) {
+                uint32_t p = prims[i];
+                for (uint32_t a = 0; a < 3; a++) {
+                    Bin& bin = res[a][binOf(centroids[p][a], lo[a], scale[a])];
+                    bin.count++;
+                    grow(bin.box, boxes[p]);
+                }
+            }
+        };
+        bins = BinSet();
+        if (end - begin <= PARALLEL_THRESHOLD) {
+            fn(begin, end, bins);
+            return;
+        }
+        ThreadPool& pool = default_thread_pool();
+        std::vector<BinSet> part(pool.size());
+        pool.parallel_for(end - begin, PARALLEL_THRESHOLD / 4,
+                          [&](uint32_t b, uint32_t e, uint32_t s) {
+                              fn(begin + b, begin + e, part[s]);
+                          });
+        for (const BinSet& p : part)
+            for (uint32_t a = 0; a < 3; a++)
+                for (uint32_t k = 0; k < BIN_COUNT; k++) {
+                    bins[a][k].count += p[a][k].count;
+                    grow(bins[a][k].box, p[a][k].box);
+                }
+    }
+    void buildNode(uint32_t node,
+                   uint32_t begin,
+                   uint32_t end,
+                   uint32_t depth) {
+        auto [bounds, cb] = rangeBounds(begin, end);
+        uint32_t count = end - begin;
+        nodes[node] = {bounds, begin, count};
+        if (count <= 1 || depth + 1 >= DEPTH_LIMIT)
+            return;
+        Vec3 extent = cb.max() - cb.min();
+        uint32_t axis = NULL_NEXT, split = 0;
+        Scalar bestCost = std::numeric_limits<Scalar>::infinity();
+        Vec3 scale = Vec3::Zero();
+        if ((extent.array() > Scalar(0)).any()) {
+            for (uint32_t a = 0; a < 3; a++)
+                if (extent[a] > Scalar(0))
+                    scale[a] = Scalar(BIN_COUNT) / extent[a];
+            BinSet bins;
+            binRange(begin, end, cb.min(), scale, bins);
+            // 自左向右累计左侧代价, 再自右向左求各划分的总代价
+            for (uint32_t a = 0; a < 3; a++) {
+                if (extent[a] <= Scalar(0))
+                    continue;
+                std::array<Scalar, BIN_COUNT> leftCost;
+                Box acc = emptyBox();
+                uint32_t n = 0;
+                for (uint32_t k = 0; k + 1 < BIN_COUNT; k++) {
+                    grow(acc, bins[a][k].box);
+                    n += bins[a][k].count;
+                    leftCost[k] = n == 0 ? Scalar(0) : halfArea(acc) * n;
+                }
+                acc = emptyBox();
+                n = 0;
+                for (uint32_t k = BIN_COUNT - 1; k > 0; k--) {
+                    grow(acc, bins[a][k].box);
+                    n += bins[a][k].count;
+                    if (n == 0 || n == count)
+                        continue;
+                    Scalar cost = leftCost[k - 1] + halfArea(acc) * n;
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        axis = a;
+                        split = k;
+                    }
+                }
+            }
+        }
+        // 代价以遍历一个节点等于测试一个对象计
+        Scalar leafCost = halfArea(bounds) * count;
+        if (count <= nodeMaxData &&
+            (axis == NULL_NEXT || halfArea(bounds) + bestCost >= leafCost))
+            return;
+        auto first = prims.begin() + begin, last = prims.begin() + end;
+        uint32_t mid;
+        if (axis != NULL_NEXT) {
+            mid = std::partition(first, last,
+                                 [&](uint32_t p) {
+                                     return binOf(centroids[p][axis],
+                                                  cb.min()[axis],
+                                                  scale[axis]) < split;
+                                 }) -
+                  prims.begin();
+        } else {
+            // 中心点全部重合, 按序号对半分
+            mid = begin + count / 2;
+        }
+        uint32_t left = nodeCount.fetch_add(2);
+        nodes[node].first = left;
+        nodes[node].count = 0;
+        if (count > PARALLEL_THRESHOLD) {
+            default_thread_pool().parallel_for(
+                2, 1, [&](uint32_t b, uint32_t e, uint32_t) {
+                    for (uint32_t i = b; i < e; i++) {
+                        if (i == 0)
+                            buildNode(left, begin, mid, depth + 1);
+                        else
+                            buildNode(left + 1, mid, end, depth + 1);
+                    }
+                });
+        } else {
+            buildNode(left, begin, mid, depth + 1);
+            buildNode(left + 1, mid, end, depth + 1);
+        }
+    }
+
+   public:
+    BVH() = default;
+    BVH(const BVH&) = delete;
+    // 叶节点对象数的上限, 超过时总是继续划分, 在下次build时生效
+    void setNodeMaxData(uint32_t n) { nodeMaxData = std::max(n, 1u); }
+    uint32_t getNodeMaxData() const { return nodeMaxData; }
+    uint32_t size() const { return boxes.size(); }
+    T& data(uint32_t i) { return objects[i]; }
+    const Box& box(uint32_t i) const { return boxes[i]; }
+    const Node& node(uint32_t n) const { return nodes[n]; }
+    uint32_t nodeSize() const { return nodeCount.load(); }
+    // 以boxes[i], data[i]为对象建树, data中的元素被移入树中, 对象序号即i
+    void build(std::span<const Box> objectBoxes, std::span<T> data) {
+        uint32_t n = objectBoxes.size();
+        boxes.assign(objectBoxes.begin(), objectBoxes.end());
+        objects.assign(std::make_move_iterator(data.begin()),
+                       std::make_move_iterator(data.end()));
+        centroids.resize(n);
+        prims.resize(n);
+        for (uint32_t i = 0; i < n; i++) {
+            centroids[i] = boxes[i].c();
+            prims[i] = i;
+        }
+        nodes.clear();
+        nodeCount = 0;
+        if (n == 0)
+            return;
+        nodes.resize(2 * n - 1);
+        nodeCount = 1;
+        buildNode(0, 0, n, 0);
+        nodes.resize(nodeCount);
+    }
+    // 修改对象的包围盒, 在refit后生效
+    void updateBox(uint32_t i, const Box& b) { boxes[i] = b; }
+    // 保持树的结构, 自底向上重新计算所有节点的包围盒
+    // 对象移动较大时树的质量会下降, 此时应重新build
+    void refit() {
+        for (uint32_t n = nodes.size(); n-- > 0;) {
+            Node& cur = nodes[n];
+            if (cur.count > 0) {
+                cur.box = emptyBox();
+                for (uint32_t i = cur.first; i < cur.first + cur.count; i++)
+                    grow(cur.box, boxes[prims[i]]);
+            } else {
+                cur.box = nodes[cur.first].box;
+                grow(cur.box, nodes[cur.first + 1].box);
+            }
+        }
+    }
+    void refit(std::span<const Box> objectBoxes) {
+        std::copy(objectBoxes.begin(), objectBoxes.end(), boxes.begin());
+        refit();
+    }
+    // 射线o+t*d(t在[0,tMax]内)与对象盒的最近交点, 未命中时hit.prim为NULL_NEXT
+    RayHit raycast(const Vec3& o, const Vec3& d, Scalar tMax) const {
+        struct Entry {
+            uint32_t node;
+            Scalar t;
+        };
+        RayHit hit = {NULL_NEXT, tMax};
+        Vec3 invD = d.cwiseInverse();
+        Scalar t, t2;
+        if (nodes.empty() ||
+            !intersectRay(o, invD, nodes[0].box, Scalar(0), tMax, &t))
+            return hit;
+        std::array<Entry, DEPTH_LIMIT + 1> stack;
+        uint32_t top = 0;
+        stack[top++] = {0, t};
+        while (top > 0) {
+            Entry e = stack[--top];
+            if (e.t > hit.t)
+                continue;
+            const Node& cur = nodes[e.node];
+            if (cur.count > 0) {
+                for (uint32_t i = cur.first; i < cur.first + cur.count; i++)
+                    if (intersectRay(o, invD, boxes[prims[i]], Scalar(0),
+                                     hit.t, &t) &&
+                        (t < hit.t || hit.prim == NULL_NEXT))
+                        hit = {prims[i], t};
+                continue;
+            }
+            bool hl = intersectRay(o, invD, nodes[cur.first].box, Scalar(0),
+                                   hit.t, &t);
+            bool hr = intersectRay(o, invD, nodes[cur.first + 1].box,
+                                   Scalar(0), hit.t, &t2);
+            // 远的先入栈, 使近的子节点先被访问
+            if (hl && hr) {
+                if (t <= t2) {
+                    stack[top++] = {cur.first + 1, t2};
+                    stack[top++] = {cur.first, t};
+                } else {
+                    stack[top++] = {cur.first, t};
+                    stack[top++] = {cur.first + 1, t2};
+                }
+            } else if (hl) {
+                stack[top++] = {cur.first, t};
+            } else if (hr) {
+                stack[top++] = {cur.first + 1, t2};
+            }
+        }
+        return hit;
+    }
+    // 射线包遍历: 包内射线共享节点访问, 每个节点只对仍与其相交的射线测试
+    // 结果同逐条raycast(t上限为rays.tMax), 不在active中的射线其hits不变
+    // 方向一致的射线(如同一像素块的主光线)收益最大
+    template <uint32_t N>
+        requires std::same_as<Scalar, float>
+    void raycastPacket(const RayPacket<N>& rays,
+                       std::array<RayHit, size_t(N)>& hits,
+                       uint32_t active = RayPacket<N>::ALL) const {
+        struct Entry {
+            uint32_t node;
+            uint32_t mask;
+        };
+        alignas(32) float tBest[N], tHit[N];
+        for (uint32_t i = 0; i < N; i++) {
+            tBest[i] = rays.tMax[i];
+            if (active >> i & 1)
+                hits[i] = {NULL_NEXT, rays.tMax[i]};
+        }
+        if (nodes.empty() || !active)
+            return;
+        // 以首条活跃射线的方向决定子节点的访问顺序
+        uint32_t lead = std::countr_zero(active);
+        Vec3 dir(rays.d[0][lead], rays.d[1][lead], rays.d[2][lead]);
+        std::array<Entry, DEPTH_LIMIT + 1> stack;
+        uint32_t top = 0;
+        stack[top++] = {0, active};
+        while (top > 0) {
+            Entry e = stack[--top];
+            const Node& cur = nodes[e.node];
+            // 出栈时以当前最近距离重新测试, 已找到更近交点的射线被剔除
+            uint32_t m = intersectRayPacket(rays, cur.box, tBest, tHit, e.mask);
+            if (!m)
+                continue;
+            if (cur.count > 0) {
+                for (uint32_t i = cur.first; i < cur.first + cur.count; i++) {
+                    uint32_t hm = intersectRayPacket(rays, boxes[prims[i]],
+                                                     tBest, tHit, m);
+                    for (; hm; hm &= hm - 1) {
+                        uint32_t r = std::countr_zero(hm);
+                        if (tHit[r] < tBest[r] || hits[r].prim == NULL_NEXT) {
+                            hits[r] = {prims[i], tHit[r]};
+                            tBest[r] = tHit[r];
+                        }
+                    }
+                }
+                continue;
+            }
+            // 远的先入栈, 使近的子节点先被访问
+            const Box& l = nodes[cur.first].box;
+            const Box& r = nodes[cur.first + 1].box;
+            if (dir.dot(r.c() - l.c()) >= 0) {
+                stack[top++] = {cur.first + 1, m};
+                stack[top++] = {cur.first, m};
+            } else {
+                stack[top++] = {cur.first, m};
+                stack[top++] = {cur.first + 1, m};
+            }
+        }
+    }
+    // 对与size相交的每个对象调用fn(box, data)
+    template <typename Visitor>
+        requires std::invocable<Visitor&, const Box&, T&>
+    void find(const Box& size, Visitor&& fn) {
+        if (nodes.empty())
+            return;
+        std::array<uint32_t, DEPTH_LIMIT + 1> stack;
+        uint32_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& cur = nodes[stack[--top]];
+            if (intersectTest(size, cur.box) == CollisionResult::outer)
+                continue;
+            if (cur.count == 0) {
+                stack[top++] = cur.first + 1;
+                stack[top++] = cur.first;
+                continue;
+            }
+            for (uint32_t i = cur.first; i < cur.first + cur.count; i++) {
+                uint32_t p = prims[i];
+                if (intersectTest(size, boxes[p]) >= CollisionResult::intersect)
+                    fn(boxes[p], objects[p]);
+            }
+        }
+    }
+    void find(const Box& size, const IterateFunction& fn) {
+        find<const IterateFunction&>(size, fn);
+    }
+    // 视锥体剔除, 将与视锥体相交的对象序号追加到out
+    // 节点完全位于某平面内侧时, 其子树不再测试该平面
+    void cull(const std::array<Plane<Scalar>, 6>& planes,
+              std::vector<uint32_t>& out) const {
+        struct Entry {
+            uint32_t node, mask;
+        };
+        if (nodes.empty())
+            return;
+        std::array<Entry, DEPTH_LIMIT + 1> stack;
+        uint32_t top = 0;
+        stack[top++] = {0, 0x3F};
+        while (top > 0) {
+            auto [n, mask] = stack[--top];
+            const Node& cur = nodes[n];
+            bool outside = false;
+            for (uint32_t m = mask; m != 0; m &= m - 1) {
+                uint32_t i = std::countr_zero(m);
+                CollisionResult r = intersectTest(planes[i], cur.box);
+                if (r == CollisionResult::outer) {
+                    outside = true;
+                    break;
+                }
+                if (r == CollisionResult::inner)
+                    mask &= ~(1u << i);
+            }
+            if (outside)
+                continue;
+            if (cur.count == 0) {
+                stack[top++] = {cur.first + 1, mask};
+                stack[top++] = {cur.first, mask};
+                continue;
+            }
+            for (uint32_t i = cur.first; i < cur.first + cur.count; i++) {
+                bool visible = true;
+                for (uint32_t m = mask; m != 0; m &= m - 1) {
+                    if (intersectTest(planes[std::countr_zero(m)],
+                                      boxes[prims[i]]) ==
+                        CollisionResult::outer) {
+                        visible = false;
+                        break;
+                    }
+                }
+                if (visible)
+                    out.push_back(prims[i]);
+            }
+        }
+    }
+};
+}  // namespace BL::Math
+#endif  //!_BOUNDLESS_BVH_CXX_HPP_
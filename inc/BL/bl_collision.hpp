@@ -1,8 +1,22 @@
 #ifndef _BOUNDLESS_COLLISION_CXX_HPP_
 #define _BOUNDLESS_COLLISION_CXX_HPP_
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
 #include <concepts>
+#include <cstdint>
+#include <limits>
 #include "bl_log.hpp"
 #include "bl_math_types.hpp"
+// 定义BL_MATH_NO_SIMD以强制使用标量实现
+#if !defined(BL_MATH_NO_SIMD) && defined(__AVX__)
+#define BL_MATH_SIMD_AVX
+#include <immintrin.h>
+#elif !defined(BL_MATH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define BL_MATH_SIMD_SSE
+#include <immintrin.h>
+#endif
 namespace BL::Math {
 template <std::floating_point Real>
 struct AABB {
@@ -13,12 +27,35 @@ struct AABB {
     Vec3 v() const { return Vec3::UnitY(); }
     Vec3 w() const { return Vec3::UnitZ(); }
     Vec3 h() const { return (_max - _min) / static_cast<Real>(2.0); }
-    float h_u() const { return (_max.x() - _min.x()) / static_cast<Real>(2.0); }
-    float h_v() const { return (_max.y() - _min.y()) / static_cast<Real>(2.0); }
-    float h_w() const { return (_max.z() - _min.z()) / static_cast<Real>(2.0); }
-    Vec3& max() const { return _max; }
-    Vec3& min() const { return _min; }
+    Real h_u() const { return (_max.x() - _min.x()) / static_cast<Real>(2.0); }
+    Real h_v() const { return (_max.y() - _min.y()) / static_cast<Real>(2.0); }
+    Real h_w() const { return (_max.z() - _min.z()) / static_cast<Real>(2.0); }
+    Vec3& max() { return _max; }
+    Vec3& min() { return _min; }
+    const Vec3& max() const { return _max; }
+    const Vec3& min() const { return _min; }
 };
+// max与min连续存放, 不为SIMD填充到32字节, 以保持BVH节点等结构的大小
+// SSE实现以两次重叠的非对齐加载读取, 不越过盒的末尾
+static_assert(sizeof(AABB<float>) == 24);
+#if defined(BL_MATH_SIMD_AVX) || defined(BL_MATH_SIMD_SSE)
+// mx为(max, min.x), mn为(min, min.z), 使用前3个分量
+inline void aabb_load_sse(const AABB<float>& A, __m128& mx, __m128& mn) {
+    const float* p = A.max().data();
+    mx = _mm_loadu_ps(p);
+    mn = _mm_loadu_ps(p + 2);
+    mn = _mm_shuffle_ps(mn, mn, _MM_SHUFFLE(3, 3, 2, 1));
+}
+inline __m128 vec3_load_sse(const vec3<float>& v) {
+    return _mm_setr_ps(v.x(), v.y(), v.z(), 0);
+}
+// 前3个分量的和, 结果在第0个分量
+inline __m128 hsum3_sse(__m128 v) {
+    __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+    __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+    return _mm_add_ss(_mm_add_ss(v, y), z);
+}
+#endif
 template <std::floating_point Real>
 struct OBB {
     using Vec3 = vec3<Real>;
@@ -28,11 +65,11 @@ struct OBB {
     Vec3 v() const { return _v; }
     Vec3 w() const { return _u.cross(_v); }
     Vec3 h() const { return _h; }
-    float h_u() const { return _h.x(); }
-    float h_v() const { return _h.y(); }
-    float h_w() const { return _h.z(); }
+    Real h_u() const { return _h.x(); }
+    Real h_v() const { return _h.y(); }
+    Real h_w() const { return _h.z(); }
     void setCenter(const Vec3& new_c) { _c = new_c; }
-    void setBoxSize(const Vec3& x, const Vec3& y, float h_z) {
+    void setBoxSize(const Vec3& x, const Vec3& y, Real h_z) {
         _h.x() = x.norm();
         _u = x / _h.x();
         _h.y() = y.norm();
@@ -40,33 +77,44 @@ struct OBB {
         _h.z() = h_z;
     }
 };
+// 球, 以球心与半径表示
+template <std::floating_point Real>
+struct Sphere {
+    using Vec3 = vec3<Real>;
+    Vec3 _c;
+    Real _r;
+    Vec3 c() const { return _c; }
+    Real r() const { return _r; }
+};
 template <std::floating_point Real>
 struct Ray {
     using Vec3 = vec3<Real>;
     Vec3 _o, _d;
-    Vec3& o() const { return _o; }
-    Vec3& d() const { return _d; }
+    Vec3& o() { return _o; }
+    Vec3& d() { return _d; }
+    const Vec3& o() const { return _o; }
+    const Vec3& d() const { return _d; }
 };
 template <std::floating_point Real>
 struct Plane {
     using Vec3 = vec3<Real>;
     using Vec4 = vec4<Real>;
     Vec4 data;
-    Vec3 n() const { return data.block<3, 1>(0, 0); }
+    Vec3 n() const { return data.template block<3, 1>(0, 0); }
     Real d() const { return data[3]; }
     // set自动归一化向量
     void set(const Vec3& nn, Real nd) {
         Real rec_len = 1 / nn.norm();
-        data.block<3, 1>(0, 0) = nn;
+        data.template block<3, 1>(0, 0) = nn;
         data[3] = nd;
         data *= rec_len;
     }
     void norm() {
-        Real rec_len = 1 / data.block<3, 1>(0, 0).norm();
+        Real rec_len = 1 / data.template block<3, 1>(0, 0).norm();
         data *= rec_len;
     }
     void set_nonorm(const Vec3& nn, Real nd) {
-        data.block<3, 1>(0, 0) = nn;
+        data.template block<3, 1>(0, 0) = nn;
         data[3] = nd;
     }
 };
@@ -96,148 +144,479 @@ vec2<Real> projAABB(const AABB<Real>& b, vec3<Real> d) {
 }
 template <std::floating_point Real>
 bool testSAT(vec2<Real> a, vec2<Real> b) {
-    return (a.x() < b.y() && b.x() < a.y())
+    return (a.x() < b.y() && b.x() < a.y());
 }
 template <std::floating_point Real>
 bool testSAT_inner(vec2<Real> a, vec2<Real> b) {
-    return (a.x() < b.x() && b.y() < a.y())
+    return (a.x() < b.x() && b.y() < a.y());
 }
 template <std::floating_point Real>
 bool testSAT_inner2(vec2<Real> a, vec2<Real> b) {
-    return (a.x() < b.x() && b.y() < a.y() || b.x() < a.x() && a.y() < b.y())
+    return (a.x() < b.x() && b.y() < a.y() || b.x() < a.x() && a.y() < b.y());
 }
 
 enum struct CollisionResult { outer = 0x0, intersect = 0x1, inner = 0x2 };
 template <typename T>
-concept Collisions = std::same_as<T, AABB> || std::same_as<T, OBB>;
+concept Collisions =
+    std::same_as<T, AABB<float>> || std::same_as<T, AABB<double>> ||
+    std::same_as<T, OBB<float>> || std::same_as<T, OBB<double>>;
 
 template <std::floating_point Real>
 CollisionResult intersectTest(const AABB<Real>& A, const AABB<Real>& B) {
+#if defined(BL_MATH_SIMD_AVX) || defined(BL_MATH_SIMD_SSE)
+    if constexpr (std::same_as<Real, float>) {
+        __m128 amax, amin, bmax, bmin;
+        aabb_load_sse(A, amax, amin);
+        aabb_load_sse(B, bmax, bmin);
+        __m128 outer = _mm_or_ps(_mm_cmpgt_ps(amin, bmax),
+                                 _mm_cmpgt_ps(bmin, amax));
+        if (_mm_movemask_ps(outer) & 7)
+            return CollisionResult::outer;
+        __m128 inner = _mm_and_ps(_mm_cmplt_ps(amin, bmin),
+                                  _mm_cmpgt_ps(amax, bmax));
+        if ((_mm_movemask_ps(inner) & 7) == 7)
+            return CollisionResult::inner;
+        return CollisionResult::intersect;
+    }
+#endif
     if ((A.min().array() > B.max().array()).any() ||
         (B.min().array() > A.max().array()).any())
         return CollisionResult::outer;
-    else if ((A.min() < B.min()).all() && (A.max() > B.max()).all())
+    else if ((A.min().array() < B.min().array()).all() &&
+             (A.max().array() > B.max().array()).all())
         return CollisionResult::inner;
     return CollisionResult::intersect;
 }
 
+// 点p到AABB的距离的平方, p在盒内时为0
 template <std::floating_point Real>
-CollisionResult intersectTest(const OBB<Real>& A, const OBB<Real>& B) {
-    int c = 0;
-    vec3<Real> d1 = A.w();
-    vec3<Real> d2 = B.w();
-    vec2<Real> s1 = projOBB2(A, A.u(), d1), s2 = projOBB2(B, A.u(), d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    s1 = projOBB2(A, A.v(), d1), s2 = projOBB2(B, A.v(), d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    s1 = projOBB2(A, d1, d1), s2 = projOBB2(B, d1, d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-
-    s1 = projOBB2(A, B.u(), d1), s2 = projOBB2(B, B.u(), d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    s1 = projOBB2(A, B.v(), d1), s2 = projOBB2(B, B.v(), d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    s1 = projOBB2(A, d2, d1), s2 = projOBB2(B, d2, d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-
-    vec3<Real> d = A.u().cross(B.v());
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    d = A.u().cross(d2);
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
+Real distanceSquared(const vec3<Real>& p, const AABB<Real>& A) {
+#if defined(BL_MATH_SIMD_AVX) || defined(BL_MATH_SIMD_SSE)
+    if constexpr (std::same_as<Real, float>) {
+        __m128 mx, mn, q = vec3_load_sse(p), zero = _mm_setzero_ps();
+        aabb_load_sse(A, mx, mn);
+        __m128 e = _mm_add_ps(_mm_max_ps(_mm_sub_ps(mn, q), zero),
+                              _mm_max_ps(_mm_sub_ps(q, mx), zero));
+        return _mm_cvtss_f32(hsum3_sse(_mm_mul_ps(e, e)));
+    }
+#endif
+    vec3<Real> e = (A.min() - p).cwiseMax(Real(0)) +
+                   (p - A.max()).cwiseMax(Real(0));
+    return e.dot(e);
+}
+// 球与AABB相交测试, 同intersect_sphere_AABB
+template <std::floating_point Real>
+bool intersectSphere(const vec3<Real>& c, Real r, const AABB<Real>& A) {
+    return distanceSquared(c, A) <= r * r;
+}
+// 以法线方向为面外: outer在面外, inner在面内, 否则相交
+template <std::floating_point Real>
+CollisionResult intersectTest(const Plane<Real>& P, const AABB<Real>& A) {
+#if defined(BL_MATH_SIMD_AVX) || defined(BL_MATH_SIMD_SSE)
+    if constexpr (std::same_as<Real, float>) {
+        __m128 mx, mn, n = _mm_loadu_ps(P.data.data());
+        aabb_load_sse(A, mx, mn);
+        __m128 half = _mm_set1_ps(0.5f);
+        __m128 c = _mm_mul_ps(_mm_add_ps(mx, mn), half);
+        __m128 h = _mm_mul_ps(_mm_sub_ps(mx, mn), half);
+        __m128 absN = _mm_andnot_ps(_mm_set1_ps(-0.0f), n);
+        float e = _mm_cvtss_f32(hsum3_sse(_mm_mul_ps(h, absN)));
+        float s = _mm_cvtss_f32(hsum3_sse(_mm_mul_ps(c, n))) + P.d();
+        if (s - e > 0)
+            return CollisionResult::outer;
+        if (s + e < 0)
+            return CollisionResult::inner;
+        return CollisionResult::intersect;
+    }
+#endif
+    vec3<Real> n = P.n();
+    Real e = A.h().dot(n.cwiseAbs());
+    Real s = A.c().dot(n) + P.d();
+    if (s - e > 0)
         return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
+    if (s + e < 0)
+        return CollisionResult::inner;
+    return CollisionResult::intersect;
+}
 
-    d = A.v().cross(B.u());
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
+template <std::floating_point Real>
+CollisionResult intersectTest(const Plane<Real>& P, const OBB<Real>& A) {
+    vec3<Real> n = P.n();
+    Real e = A.h_u() * std::abs(A.u().dot(n)) +
+             A.h_v() * std::abs(A.v().dot(n)) +
+             A.h_w() * std::abs(A.w().dot(n));
+    Real s = A.c().dot(n) + P.d();
+    if (s - e > 0)
         return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    d = A.v().cross(d2);
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
+    if (s + e < 0)
+        return CollisionResult::inner;
+    return CollisionResult::intersect;
+}
+template <std::floating_point Real>
+CollisionResult intersectTest(const Plane<Real>& P, const Sphere<Real>& S) {
+    Real s = S.c().dot(P.n()) + P.d();
+    if (s - S.r() > 0)
         return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-
-    d = d1.cross(B.u());
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
+    if (s + S.r() < 0)
+        return CollisionResult::inner;
+    return CollisionResult::intersect;
+}
+// inner为B严格在A内
+template <std::floating_point Real>
+CollisionResult intersectTest(const Sphere<Real>& A, const Sphere<Real>& B) {
+    Real d2 = (B.c() - A.c()).squaredNorm();
+    Real r = A.r() + B.r();
+    if (d2 > r * r)
         return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    d = d1.cross(B.v());
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
+    Real k = A.r() - B.r();
+    if (k > 0 && d2 < k * k)
+        return CollisionResult::inner;
+    return CollisionResult::intersect;
+}
+// inner为球严格在盒内
+template <std::floating_point Real>
+CollisionResult intersectTest(const AABB<Real>& A, const Sphere<Real>& S) {
+    Real r2 = S.r() * S.r();
+    if (distanceSquared(S.c(), A) > r2)
         return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
+    if (((S.c() - A.min()).array() > S.r()).all() &&
+        ((A.max() - S.c()).array() > S.r()).all())
+        return CollisionResult::inner;
+    return CollisionResult::intersect;
+}
+// 从投影与视图矩阵之积vp(列向量, 深度[0,1])提取视锥体的6个平面
+// 顺序为左右上下近远, 法线朝向视锥体外部, 已归一化
+template <std::floating_point Real>
+void spawnFrustumPlanes(const mat4<Real>& vp,
+                        std::array<Plane<Real>, 6>& planes) {
+    vec4<Real> r0 = vp.row(0).transpose(), r1 = vp.row(1).transpose();
+    vec4<Real> r2 = vp.row(2).transpose(), r3 = vp.row(3).transpose();
+    // r·p >= 0为内侧, 取反使法线朝外
+    planes[0].data = -(r3 + r0);
+    planes[1].data = -(r3 - r0);
+    planes[2].data = -(r3 - r1);
+    planes[3].data = -(r3 + r1);
+    planes[4].data = -r2;
+    planes[5].data = -(r3 - r2);
+    for (Plane<Real>& p : planes)
+        p.norm();
+}
+// 以planes中mask选中的平面测试A, 与A相交的平面保留在mask中
+// 返回outer时mask不再有效; mask为0即A完全在视锥体内
+template <std::floating_point Real, typename Shape>
+CollisionResult intersectFrustum(const std::array<Plane<Real>, 6>& planes,
+                                 const Shape& A,
+                                 uint32_t& mask) {
+    for (uint32_t m = mask; m != 0; m &= m - 1) {
+        uint32_t i = std::countr_zero(m);
+        CollisionResult r = intersectTest(planes[i], A);
+        if (r == CollisionResult::outer)
+            return CollisionResult::outer;
+        if (r == CollisionResult::inner)
+            mask &= ~(1u << i);
+    }
+    return mask == 0 ? CollisionResult::inner : CollisionResult::intersect;
+}
+template <std::floating_point Real, typename Shape>
+CollisionResult intersectFrustum(const std::array<Plane<Real>, 6>& planes,
+                                 const Shape& A) {
+    uint32_t mask = 0x3F;
+    return intersectFrustum(planes, A, mask);
+}
+// 8个AABB的SoA存储, 每轴8个分量连续, 用于一次测试一组八叉树子节点
+template <std::floating_point Real>
+struct AABB8 {
+    alignas(32) Real max[3][8];
+    alignas(32) Real min[3][8];
+    void set(uint32_t i, const AABB<Real>& b) {
+        for (uint32_t k = 0; k < 3; k++) {
+            max[k][i] = b.max()[k];
+            min[k][i] = b.min()[k];
+        }
+    }
+};
+// 对8个盒A[i]同时进行intersectTest(A[i], B)
+// 结果: 低8位为结果>=intersect的掩码, 高8位为结果==inner的掩码
+template <std::floating_point Real>
+uint32_t intersectTest8(const AABB8<Real>& A, const AABB<Real>& B) {
+#if defined(BL_MATH_SIMD_AVX)
+    if constexpr (std::same_as<Real, float>) {
+        __m256 outer = _mm256_setzero_ps();
+        __m256 inner = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (uint32_t k = 0; k < 3; k++) {
+            __m256 amax = _mm256_load_ps(A.max[k]);
+            __m256 amin = _mm256_load_ps(A.min[k]);
+            __m256 bmax = _mm256_set1_ps(B.max()[k]);
+            __m256 bmin = _mm256_set1_ps(B.min()[k]);
+            outer = _mm256_or_ps(
+                outer, _mm256_or_ps(_mm256_cmp_ps(amin, bmax, _CMP_GT_OQ),
+                                    _mm256_cmp_ps(bmin, amax, _CMP_GT_OQ)));
+            inner = _mm256_and_ps(
+                inner, _mm256_and_ps(_mm256_cmp_ps(amin, bmin, _CMP_LT_OQ),
+                                     _mm256_cmp_ps(amax, bmax, _CMP_GT_OQ)));
+        }
+        uint32_t o = _mm256_movemask_ps(outer);
+        uint32_t i = _mm256_movemask_ps(inner);
+        return (~o & 0xFFu) | (i << 8);
+    }
+#elif defined(BL_MATH_SIMD_SSE)
+    if constexpr (std::same_as<Real, float>) {
+        uint32_t o = 0, i = 0;
+        for (uint32_t h = 0; h < 8; h += 4) {
+            __m128 outer = _mm_setzero_ps();
+            __m128 inner = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (uint32_t k = 0; k < 3; k++) {
+                __m128 amax = _mm_load_ps(A.max[k] + h);
+                __m128 amin = _mm_load_ps(A.min[k] + h);
+                __m128 bmax = _mm_set1_ps(B.max()[k]);
+                __m128 bmin = _mm_set1_ps(B.min()[k]);
+                outer = _mm_or_ps(outer, _mm_or_ps(_mm_cmpgt_ps(amin, bmax),
+                                                   _mm_cmpgt_ps(bmin, amax)));
+                inner = _mm_and_ps(inner, _mm_and_ps(_mm_cmplt_ps(amin, bmin),
+                                                     _mm_cmpgt_ps(amax, bmax)));
+            }
+            o |= uint32_t(_mm_movemask_ps(outer)) << h;
+            i |= uint32_t(_mm_movemask_ps(inner)) << h;
+        }
+        return (~o & 0xFFu) | (i << 8);
+    }
+#endif
+    uint32_t o = 0, i = 0;
+    for (uint32_t j = 0; j < 8; j++) {
+        bool out = false, in = true;
+        for (uint32_t k = 0; k < 3; k++) {
+            out |= A.min[k][j] > B.max()[k] || B.min()[k] > A.max[k][j];
+            in &= A.min[k][j] < B.min()[k] && A.max[k][j] > B.max()[k];
+        }
+        o |= uint32_t(out) << j;
+        i |= uint32_t(in) << j;
+    }
+    return (~o & 0xFFu) | (i << 8);
+}
 
-    d = B.u().cross(A.v());
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    d = B.u().cross(d1);
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
+// 射线o+t*d与AABB的slab测试, invD为d各分量的倒数(可为无穷)
+// 命中时t为进入距离, 截断到[tMin,tMax]内
+template <std::floating_point Real>
+bool intersectRay(const vec3<Real>& o,
+                  const vec3<Real>& invD,
+                  const AABB<Real>& A,
+                  Real tMin,
+                  Real tMax,
+                  Real* t) {
+#if defined(BL_MATH_SIMD_AVX) || defined(BL_MATH_SIMD_SSE)
+    if constexpr (std::same_as<Real, float>) {
+        // 操作数顺序使含NaN(0 * inf)的分量与标量实现一样被忽略
+        __m128 mx, mn, q = vec3_load_sse(o), inv = vec3_load_sse(invD);
+        aabb_load_sse(A, mx, mn);
+        __m128 t1 = _mm_mul_ps(_mm_sub_ps(mn, q), inv);
+        __m128 t2 = _mm_mul_ps(_mm_sub_ps(mx, q), inv);
+        __m128 lo = _mm_max_ps(_mm_min_ps(t2, t1), _mm_set1_ps(tMin));
+        __m128 hi = _mm_min_ps(_mm_max_ps(t2, t1), _mm_set1_ps(tMax));
+        lo = _mm_max_ps(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(3, 0, 2, 1)));
+        lo = _mm_max_ss(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(3, 3, 3, 2)));
+        hi = _mm_min_ps(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(3, 0, 2, 1)));
+        hi = _mm_min_ss(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(3, 3, 3, 2)));
+        *t = _mm_cvtss_f32(lo);
+        return *t <= _mm_cvtss_f32(hi);
+    }
+#endif
+    for (uint32_t k = 0; k < 3; k++) {
+        Real t1 = (A.min()[k] - o[k]) * invD[k];
+        Real t2 = (A.max()[k] - o[k]) * invD[k];
+        tMin = std::max(tMin, std::min(t1, t2));
+        tMax = std::min(tMax, std::max(t1, t2));
+    }
+    *t = tMin;
+    return tMin <= tMax;
+}
+// 以Ray表示的射线测试, t在[tMin,tMax]内, 起点在形状内时t为tMin
+template <std::floating_point Real>
+bool intersectRay(const Ray<Real>& R,
+                  const AABB<Real>& A,
+                  Real tMin,
+                  Real tMax,
+                  Real* t) {
+    return intersectRay(R.o(), vec3<Real>(R.d().cwiseInverse()), A, tMin,
+                        tMax, t);
+}
+// OBB: 变换到盒的局部坐标系后进行slab测试
+template <std::floating_point Real>
+bool intersectRay(const Ray<Real>& R,
+                  const OBB<Real>& A,
+                  Real tMin,
+                  Real tMax,
+                  Real* t) {
+    vec3<Real> p = R.o() - A.c(), w = A.w();
+    vec3<Real> o{p.dot(A.u()), p.dot(A.v()), p.dot(w)};
+    vec3<Real> d{R.d().dot(A.u()), R.d().dot(A.v()), R.d().dot(w)};
+    AABB<Real> local{A.h(), -A.h()};
+    return intersectRay(o, vec3<Real>(d.cwiseInverse()), local, tMin, tMax,
+                        t);
+}
+template <std::floating_point Real>
+bool intersectRay(const Ray<Real>& R,
+                  const Sphere<Real>& S,
+                  Real tMin,
+                  Real tMax,
+                  Real* t) {
+    // |o + td - c|^2 = r^2, d不要求为单位向量
+    vec3<Real> m = R.o() - S.c();
+    Real a = R.d().dot(R.d());
+    Real b = m.dot(R.d());
+    Real c = m.dot(m) - S.r() * S.r();
+    Real disc = b * b - a * c;
+    if (disc < 0 || a == 0)
+        return false;
+    Real q = std::sqrt(disc);
+    Real t0 = (-b - q) / a, t1 = (-b + q) / a;
+    if (t0 > tMax || t1 < tMin)
+        return false;
+    *t = std::max(t0, tMin);
+    return true;
+}
+// 对8个盒同时进行intersectRay, 返回命中掩码, tEnter[i]为各盒的进入距离
+template <std::floating_point Real>
+uint32_t intersectRay8(const vec3<Real>& o,
+                       const vec3<Real>& invD,
+                       const AABB8<Real>& A,
+                       Real tMin,
+                       Real tMax,
+                       Real* tEnter) {
+    Real t0[8], t1[8];
+    for (uint32_t j = 0; j < 8; j++)
+        t0[j] = tMin, t1[j] = tMax;
+    for (uint32_t k = 0; k < 3; k++) {
+        for (uint32_t j = 0; j < 8; j++) {
+            Real a = (A.min[k][j] - o[k]) * invD[k];
+            Real b = (A.max[k][j] - o[k]) * invD[k];
+            t0[j] = std::max(t0[j], std::min(a, b));
+            t1[j] = std::min(t1[j], std::max(a, b));
+        }
+    }
+    uint32_t mask = 0;
+    for (uint32_t j = 0; j < 8; j++) {
+        tEnter[j] = t0[j];
+        mask |= uint32_t(t0[j] <= t1[j]) << j;
+    }
+    return mask;
+}
 
-    d = B.v().cross(A.u());
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    d = B.v().cross(d1);
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
+// Gottschalk的15轴分离轴测试: 先求B的各轴在A坐标系中的旋转矩阵R与|R|+eps,
+// 依次测试A的3个面法线, B的3个面法线, 再测试9个棱叉积轴, 任一轴分离即返回
+// eps避免棱平行时叉积接近0的轴被误判为分离轴
+// 结果: outer相离, inner为B严格在A内(在A的3个面法线上的投影均严格在内), 否则相交
+template <std::floating_point Real>
+CollisionResult intersectTest(const OBB<Real>& A, const OBB<Real>& B) {
+    constexpr Real eps = std::numeric_limits<Real>::epsilon() * 8;
+    const vec3<Real> a[3] = {A.u(), A.v(), A.w()};
+    const vec3<Real> b[3] = {B.u(), B.v(), B.w()};
+    const Real ha[3] = {A.h_u(), A.h_v(), A.h_w()};
+    const Real hb[3] = {B.h_u(), B.h_v(), B.h_w()};
+    vec3<Real> d = B.c() - A.c();
+    Real R[3][3], absR[3][3], t[3];
+    bool inner = true;
+    for (uint32_t i = 0; i < 3; i++) {
+        t[i] = a[i].dot(d);
+        Real rb = 0;
+        for (uint32_t j = 0; j < 3; j++) {
+            R[i][j] = a[i].dot(b[j]);
+            absR[i][j] = std::abs(R[i][j]) + eps;
+            rb += hb[j] * absR[i][j];
+        }
+        if (std::abs(t[i]) > ha[i] + rb)
+            return CollisionResult::outer;
+        inner &= std::abs(t[i]) + rb < ha[i];
+    }
+    for (uint32_t j = 0; j < 3; j++) {
+        Real tb = t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j];
+        Real ra = ha[0] * absR[0][j] + ha[1] * absR[1][j] + ha[2] * absR[2][j];
+        if (std::abs(tb) > ra + hb[j])
+            return CollisionResult::outer;
+    }
+    // 轴a[i] x b[j]
+    for (uint32_t i = 0; i < 3; i++) {
+        uint32_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+        for (uint32_t j = 0; j < 3; j++) {
+            uint32_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+            Real ra = ha[i1] * absR[i2][j] + ha[i2] * absR[i1][j];
+            Real rb = hb[j1] * absR[i][j2] + hb[j2] * absR[i][j1];
+            if (std::abs(t[i2] * R[i1][j] - t[i1] * R[i2][j]) > ra + rb)
+                return CollisionResult::outer;
+        }
+    }
+    return inner ? CollisionResult::inner : CollisionResult::intersect;
+}
 
-    d = d2.cross(A.u());
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    d = d2.cross(A.v());
-    s1 = projOBB2(A, d, d1), s2 = projOBB2(B, d, d2);
-    if (!testSAT(s1, s2))
-        return CollisionResult::outer;
-    else if (testSAT_inner(s1, s2))
-        c++;
-    if (c == 12)
-        return CollisionResult::inner;
-    return CollisionResult::intersect;
+// 连续碰撞测试: 盒A沿delta平移, 与静止的盒B首次接触的时间t(在[0,1]内)
+// 两者都运动时delta取A与B的位移之差; 开始时已相交则t为0
+// AABB: A的中心扫过以A的半长扩张的B, 即射线与盒的slab测试
+template <std::floating_point Real>
+bool intersectSweep(const AABB<Real>& A,
+                    const vec3<Real>& delta,
+                    const AABB<Real>& B,
+                    Real* t) {
+    AABB<Real> grown{B.max() + A.h(), B.min() - A.h()};
+    return intersectRay(A.c(), vec3<Real>(delta.cwiseInverse()), grown,
+                        Real(0), Real(1), t);
+}
+// OBB: 与intersectTest相同的15个轴上, 两盒中心距离的投影随t线性变化
+// 求每个轴上投影重叠的t区间, 所有区间的交集非空即相交, 其起点为接触时间
+template <std::floating_point Real>
+bool intersectSweep(const OBB<Real>& A,
+                    const vec3<Real>& delta,
+                    const OBB<Real>& B,
+                    Real* t) {
+    constexpr Real eps = std::numeric_limits<Real>::epsilon() * 8;
+    const vec3<Real> a[3] = {A.u(), A.v(), A.w()};
+    const vec3<Real> b[3] = {B.u(), B.v(), B.w()};
+    const Real ha[3] = {A.h_u(), A.h_v(), A.h_w()};
+    const Real hb[3] = {B.h_u(), B.h_v(), B.h_w()};
+    vec3<Real> d = B.c() - A.c();
+    Real R[3][3], absR[3][3], p[3], v[3];
+    Real tEnter = 0, tExit = 1;
+    // 轴上中心距离为c - t * w, 半径和为r时的重叠区间
+    auto clip = [&](Real c, Real w, Real r) {
+        if (w == 0)
+            return std::abs(c) <= r;
+        Real t0 = (c - r) / w, t1 = (c + r) / w;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tEnter = std::max(tEnter, t0);
+        tExit = std::min(tExit, t1);
+        return tEnter <= tExit;
+    };
+    for (uint32_t i = 0; i < 3; i++) {
+        p[i] = a[i].dot(d);
+        v[i] = a[i].dot(delta);
+        Real rb = 0;
+        for (uint32_t j = 0; j < 3; j++) {
+            R[i][j] = a[i].dot(b[j]);
+            absR[i][j] = std::abs(R[i][j]) + eps;
+            rb += hb[j] * absR[i][j];
+        }
+        if (!clip(p[i], v[i], ha[i] + rb))
+            return false;
+    }
+    for (uint32_t j = 0; j < 3; j++) {
+        Real pb = p[0] * R[0][j] + p[1] * R[1][j] + p[2] * R[2][j];
+        Real vb = v[0] * R[0][j] + v[1] * R[1][j] + v[2] * R[2][j];
+        Real ra = ha[0] * absR[0][j] + ha[1] * absR[1][j] + ha[2] * absR[2][j];
+        if (!clip(pb, vb, ra + hb[j]))
+            return false;
+    }
+    for (uint32_t i = 0; i < 3; i++) {
+        uint32_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+        for (uint32_t j = 0; j < 3; j++) {
+            uint32_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+            Real ra = ha[i1] * absR[i2][j] + ha[i2] * absR[i1][j];
+            Real rb = hb[j1] * absR[i][j2] + hb[j2] * absR[i][j1];
+            if (!clip(p[i2] * R[i1][j] - p[i1] * R[i2][j],
+                      v[i2] * R[i1][j] - v[i1] * R[i2][j], ra + rb))
+                return false;
+        }
+    }
+    *t = tEnter;
+    return true;
 }
 
 }  // namespace BL::Math
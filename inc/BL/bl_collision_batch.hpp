@@ -0,0 +1,894 @@
+#ifndef _BOUNDLESS_COLLISION_BATCH_CXX_HPP_
+#define _BOUNDLESS_COLLISION_BATCH_CXX_HPP_
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <vector>
+#include "bl_collision.hpp"
+#include "bl_parallel.hpp"
+// x86上按运行时检测的结果选择AVX2/SSE4.1/标量实现, 不依赖编译选项
+// 定义BL_MATH_NO_SIMD以强制使用标量实现
+#if !defined(BL_MATH_NO_SIMD) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__))
+#define BL_MATH_SIMD_DISPATCH
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BL_TARGET_AVX2
+#define BL_TARGET_SSE41
+#else
+#define BL_TARGET_AVX2 __attribute__((target("avx2")))
+#define BL_TARGET_SSE41 __attribute__((target("sse4.1")))
+#endif
+#endif
+namespace BL::Math {
+enum struct SimdLevel { scalar = 0, sse41 = 1, avx2 = 2 };
+inline SimdLevel detect_simd_level() {
+#if defined(BL_MATH_SIMD_DISPATCH)
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    int maxLeaf = r[0];
+    __cpuid(r, 1);
+    bool sse41 = r[2] & (1 << 19);
+    bool avx = (r[2] & (1 << 27)) && (r[2] & (1 << 28)) &&
+               (_xgetbv(0) & 6) == 6;  // OSXSAVE, AVX, 系统保存YMM寄存器
+    bool avx2 = false;
+    if (avx && maxLeaf >= 7) {
+        __cpuidex(r, 7, 0);
+        avx2 = r[1] & (1 << 5);
+    }
+#else
+    __builtin_cpu_init();
+    bool sse41 = __builtin_cpu_supports("sse4.1");
+    bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2)
+        return SimdLevel::avx2;
+    if (sse41)
+        return SimdLevel::sse41;
+#endif
+    return SimdLevel::scalar;
+}
+inline SimdLevel g_simd_level = detect_simd_level();
+inline SimdLevel simd_level() {
+    return g_simd_level;
+}
+// 限制批量测试使用的指令集(如用于对比各实现), 不会高于检测结果
+inline void set_simd_level(SimdLevel level) {
+    g_simd_level = std::min(level, detect_simd_level());
+}
+
+// 按Align字节对齐分配内存, 用于SIMD数组
+template <typename U, size_t Align = 32>
+struct AlignedAllocator {
+    using value_type = U;
+    template <typename V>
+    struct rebind {
+        using other = AlignedAllocator<V, Align>;
+    };
+    AlignedAllocator() = default;
+    template <typename V>
+    AlignedAllocator(const AlignedAllocator<V, Align>&) {}
+    U* allocate(size_t n) {
+        return static_cast<U*>(
+            ::operator new(n * sizeof(U), std::align_val_t(Align)));
+    }
+    void deallocate(U* p, size_t) {
+        ::operator delete(p, std::align_val_t(Align));
+    }
+    bool operator==(const AlignedAllocator&) const { return true; }
+};
+
+// AABB的SoA存储: min/max的x/y/z为6个独立的32字节对齐float数组
+// 数组长度补齐到8的倍数, 补齐部分为空盒(min=+inf, max=-inf), 与任何盒都不相交
+class AABBSoA {
+   public:
+    static constexpr uint32_t LANES = 8;
+
+   private:
+    static constexpr float EMPTY_MIN = std::numeric_limits<float>::infinity();
+    // 依次为min x/y/z, max x/y/z, 各stride个
+    std::vector<float, AlignedAllocator<float>> buffer;
+    uint32_t count = 0;
+    uint32_t stride = 0;  // 每个数组的容量, LANES的倍数
+
+    void clearRange(uint32_t b, uint32_t e) {
+        for (uint32_t k = 0; k < 3; k++) {
+            std::fill(min(k) + b, min(k) + e, EMPTY_MIN);
+            std::fill(max(k) + b, max(k) + e, -EMPTY_MIN);
+        }
+    }
+
+   public:
+    uint32_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    // 包含补齐部分的长度, 批量内核按此长度处理
+    uint32_t paddedSize() const { return (count + LANES - 1) & ~(LANES - 1); }
+    float* min(uint32_t k) { return buffer.data() + k * stride; }
+    float* max(uint32_t k) { return buffer.data() + (3 + k) * stride; }
+    const float* min(uint32_t k) const { return buffer.data() + k * stride; }
+    const float* max(uint32_t k) const {
+        return buffer.data() + (3 + k) * stride;
+    }
+    void reserve(uint32_t n) {
+        if (n <= stride)
+            return;
+        uint32_t s = (std::max(n, stride * 2) + LANES - 1) & ~(LANES - 1);
+        decltype(buffer) old(6 * size_t(s));
+        std::swap(old, buffer);
+        for (uint32_t a = 0; a < 6; a++)
+            std::copy_n(old.data() + size_t(a) * stride, count,
+                        buffer.data() + size_t(a) * s);
+        stride = s;
+        clearRange(count, stride);
+    }
+    void resize(uint32_t n) {
+        reserve(n);
+        if (n < count)
+            clearRange(n, count);
+        else
+            clearRange(count, n);
+        count = n;
+    }
+    void clear() { resize(0); }
+    void set(uint32_t i, const AABB<float>& b) {
+        for (uint32_t k = 0; k < 3; k++) {
+            min(k)[i] = b.min()[k];
+            max(k)[i] = b.max()[k];
+        }
+    }
+    AABB<float> get(uint32_t i) const {
+        AABB<float> b;
+        for (uint32_t k = 0; k < 3; k++) {
+            b.min()[k] = min(k)[i];
+            b.max()[k] = max(k)[i];
+        }
+        return b;
+    }
+    void push_back(const AABB<float>& b) {
+        reserve(count + 1);
+        set(count++, b);
+    }
+};
+
+// 第i位为1的字节为1, 用于将8位掩码展开为8个字节
+inline constexpr std::array<uint64_t, 256> BYTE_MASK_TABLE = [] {
+    std::array<uint64_t, 256> t{};
+    for (uint32_t m = 0; m < 256; m++)
+        for (uint32_t j = 0; j < 8; j++)
+            if (m & (1u << j))
+                t[m] |= uint64_t(1) << (8 * j);
+    return t;
+}();
+
+// 批量内核: 每8个盒调用一次sink(起始序号, 相交掩码, 内含掩码)
+// 相交掩码包括内含, 内含指盒严格在query内; 补齐部分的位恒为0
+template <typename Sink>
+void intersect_batch_scalar(const AABB<float>& q,
+                            const AABBSoA& s,
+                            Sink&& sink) {
+    for (uint32_t i = 0; i < s.paddedSize(); i += AABBSoA::LANES) {
+        uint32_t hit = 0, in = 0;
+        for (uint32_t j = 0; j < AABBSoA::LANES; j++) {
+            bool out = false, inner = true;
+            for (uint32_t k = 0; k < 3; k++) {
+                float amin = s.min(k)[i + j], amax = s.max(k)[i + j];
+                out |= (amin > q.max()[k]) | (q.min()[k] > amax);
+                inner &= (amin > q.min()[k]) & (amax < q.max()[k]);
+            }
+            hit |= uint32_t(!out) << j;
+            in |= uint32_t(inner) << j;
+        }
+        sink(i, hit, in);
+    }
+}
+#if defined(BL_MATH_SIMD_DISPATCH)
+template <typename Sink>
+BL_TARGET_SSE41 void intersect_batch_sse41(const AABB<float>& q,
+                                           const AABBSoA& s,
+                                           Sink&& sink) {
+    __m128 qmin[3], qmax[3];
+    for (uint32_t k = 0; k < 3; k++) {
+        qmin[k] = _mm_set1_ps(q.min()[k]);
+        qmax[k] = _mm_set1_ps(q.max()[k]);
+    }
+    for (uint32_t i = 0; i < s.paddedSize(); i += AABBSoA::LANES) {
+        uint32_t hit = 0, in = 0;
+        for (uint32_t h = 0; h < AABBSoA::LANES; h += 4) {
+            __m128 outer = _mm_setzero_ps();
+            __m128 inner = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (uint32_t k = 0; k < 3; k++) {
+                __m128 amin = _mm_load_ps(s.min(k) + i + h);
+                __m128 amax = _mm_load_ps(s.max(k) + i + h);
+                outer = _mm_or_ps(outer,
+                                  _mm_or_ps(_mm_cmpgt_ps(amin, qmax[k]),
+                                            _mm_cmpgt_ps(qmin[k], amax)));
+                inner = _mm_and_ps(inner,
+                                   _mm_and_ps(_mm_cmpgt_ps(amin, qmin[k]),
+                                              _mm_cmplt_ps(amax, qmax[k])));
+            }
+            hit |= uint32_t(~_mm_movemask_ps(outer) & 0xF) << h;
+            in |= uint32_t(_mm_movemask_ps(inner)) << h;
+        }
+        sink(i, hit, in);
+    }
+}
+template <typename Sink>
+BL_TARGET_AVX2 void intersect_batch_avx2(const AABB<float>& q,
+                                         const AABBSoA& s,
+                                         Sink&& sink) {
+    __m256 qmin[3], qmax[3];
+    for (uint32_t k = 0; k < 3; k++) {
+        qmin[k] = _mm256_set1_ps(q.min()[k]);
+        qmax[k] = _mm256_set1_ps(q.max()[k]);
+    }
+    for (uint32_t i = 0; i < s.paddedSize(); i += AABBSoA::LANES) {
+        __m256 outer = _mm256_setzero_ps();
+        __m256 inner = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (uint32_t k = 0; k < 3; k++) {
+            __m256 amin = _mm256_load_ps(s.min(k) + i);
+            __m256 amax = _mm256_load_ps(s.max(k) + i);
+            outer = _mm256_or_ps(
+                outer,
+                _mm256_or_ps(_mm256_cmp_ps(amin, qmax[k], _CMP_GT_OQ),
+                             _mm256_cmp_ps(qmin[k], amax, _CMP_GT_OQ)));
+            inner = _mm256_and_ps(
+                inner,
+                _mm256_and_ps(_mm256_cmp_ps(amin, qmin[k], _CMP_GT_OQ),
+                              _mm256_cmp_ps(amax, qmax[k], _CMP_LT_OQ)));
+        }
+        sink(i, uint32_t(~_mm256_movemask_ps(outer) & 0xFF),
+             uint32_t(_mm256_movemask_ps(inner)));
+    }
+}
+#endif
+template <typename Sink>
+void intersect_batch(const AABB<float>& q, const AABBSoA& s, Sink&& sink) {
+#if defined(BL_MATH_SIMD_DISPATCH)
+    switch (simd_level()) {
+        case SimdLevel::avx2:
+            intersect_batch_avx2(q, s, sink);
+            return;
+        case SimdLevel::sse41:
+            intersect_batch_sse41(q, s, sink);
+            return;
+        default:
+            break;
+    }
+#endif
+    intersect_batch_scalar(q, s, sink);
+}
+
+// 对每个盒进行intersectTest(query, boxes[i]), 结果的值写入results[i]
+// 0为相离, 1为相交, 2为盒严格在query内; results至少有boxes.size()个元素
+inline void intersectTestBatch(const AABB<float>& query,
+                               const AABBSoA& boxes,
+                               uint8_t* results) {
+    uint32_t n = boxes.size();
+    intersect_batch(query, boxes, [&](uint32_t i, uint32_t hit, uint32_t in) {
+        uint64_t bytes = BYTE_MASK_TABLE[hit] + BYTE_MASK_TABLE[in];
+        std::memcpy(results + i, &bytes, std::min(n - i, AABBSoA::LANES));
+    });
+}
+// 将与query相交(含内含)的盒的序号按升序追加到indices, 返回追加的个数
+inline uint32_t intersectTestBatch(const AABB<float>& query,
+                                   const AABBSoA& boxes,
+                                   std::vector<uint32_t>& indices) {
+    size_t begin = indices.size();
+    intersect_batch(query, boxes, [&](uint32_t i, uint32_t hit, uint32_t) {
+        for (; hit; hit &= hit - 1)
+            indices.push_back(i + std::countr_zero(hit));
+    });
+    return uint32_t(indices.size() - begin);
+}
+// OBB的SoA存储: 中心, 3个轴(w由u x v预先算出), 半尺寸共15个32字节对齐float数组
+// 长度补齐到8的倍数, 补齐部分的结果由内核屏蔽
+class OBBSoA {
+   public:
+    static constexpr uint32_t LANES = 8;
+    static constexpr uint32_t ARRAYS = 15;
+
+   private:
+    // 依次为c x/y/z, u x/y/z, v x/y/z, w x/y/z, h u/v/w, 各stride个
+    std::vector<float, AlignedAllocator<float>> buffer;
+    uint32_t count = 0;
+    uint32_t stride = 0;
+
+    float* array(uint32_t a) { return buffer.data() + size_t(a) * stride; }
+    const float* array(uint32_t a) const {
+        return buffer.data() + size_t(a) * stride;
+    }
+
+   public:
+    uint32_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    uint32_t paddedSize() const { return (count + LANES - 1) & ~(LANES - 1); }
+    // 中心的第k个分量
+    const float* c(uint32_t k) const { return array(k); }
+    // 第j个轴(0:u, 1:v, 2:w)的第k个分量
+    const float* axis(uint32_t j, uint32_t k) const {
+        return array(3 + 3 * j + k);
+    }
+    // 沿第j个轴的半尺寸
+    const float* h(uint32_t j) const { return array(12 + j); }
+    void reserve(uint32_t n) {
+        if (n <= stride)
+            return;
+        uint32_t s = (std::max(n, stride * 2) + LANES - 1) & ~(LANES - 1);
+        decltype(buffer) old(ARRAYS * size_t(s));
+        std::swap(old, buffer);
+        for (uint32_t a = 0; a < ARRAYS; a++)
+            std::copy_n(old.data() + size_t(a) * stride, count,
+                        buffer.data() + size_t(a) * s);
+        stride = s;
+    }
+    void resize(uint32_t n) {
+        reserve(n);
+        count = n;
+    }
+    void clear() { count = 0; }
+    void set(uint32_t i, const OBB<float>& b) {
+        const vec3<float> axes[3] = {b.u(), b.v(), b.w()};
+        for (uint32_t k = 0; k < 3; k++) {
+            array(k)[i] = b.c()[k];
+            for (uint32_t j = 0; j < 3; j++)
+                array(3 + 3 * j + k)[i] = axes[j][k];
+            array(12 + k)[i] = b.h()[k];
+        }
+    }
+    OBB<float> get(uint32_t i) const {
+        OBB<float> b;
+        for (uint32_t k = 0; k < 3; k++) {
+            b._c[k] = c(k)[i];
+            b._u[k] = axis(0, k)[i];
+            b._v[k] = axis(1, k)[i];
+            b._h[k] = h(k)[i];
+        }
+        return b;
+    }
+    void push_back(const OBB<float>& b) {
+        reserve(count + 1);
+        set(count++, b);
+    }
+};
+
+// OBB批量内核: 每8个盒调用一次sink(起始序号, 相交掩码, 内含掩码)
+// 逐盒计算与intersectTest(q, boxes[i])相同的15轴测试
+template <typename Sink>
+void intersect_obb_batch_scalar(const OBB<float>& q,
+                                const OBBSoA& s,
+                                Sink&& sink) {
+    for (uint32_t i = 0; i < s.size(); i += OBBSoA::LANES) {
+        uint32_t hit = 0, in = 0;
+        uint32_t e = std::min(s.size() - i, OBBSoA::LANES);
+        for (uint32_t j = 0; j < e; j++) {
+            CollisionResult r = intersectTest(q, s.get(i + j));
+            hit |= uint32_t(r != CollisionResult::outer) << j;
+            in |= uint32_t(r == CollisionResult::inner) << j;
+        }
+        sink(i, hit, in);
+    }
+}
+#if defined(BL_MATH_SIMD_DISPATCH)
+BL_TARGET_AVX2 inline __m256 abs_avx2(__m256 x) {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+}
+// 8个OBB同时进行Gottschalk测试, 公式同intersectTest(OBB, OBB)
+// q为A, 各通道为B; 全部有效通道在面法线上已分离时跳过9个棱叉积轴
+template <typename Sink>
+BL_TARGET_AVX2 void intersect_obb_batch_avx2(const OBB<float>& q,
+                                             const OBBSoA& s,
+                                             Sink&& sink) {
+    const __m256 eps =
+        _mm256_set1_ps(std::numeric_limits<float>::epsilon() * 8);
+    const vec3<float> qa[3] = {q.u(), q.v(), q.w()};
+    __m256 ha[3];
+    for (uint32_t k = 0; k < 3; k++)
+        ha[k] = _mm256_set1_ps(q.h()[k]);
+    for (uint32_t i = 0; i < s.size(); i += OBBSoA::LANES) {
+        uint32_t valid = s.size() - i >= 8 ? 0xFF : (1u << (s.size() - i)) - 1;
+        __m256 b[3][3], hb[3], d[3];
+        for (uint32_t j = 0; j < 3; j++) {
+            for (uint32_t k = 0; k < 3; k++)
+                b[j][k] = _mm256_load_ps(s.axis(j, k) + i);
+            hb[j] = _mm256_load_ps(s.h(j) + i);
+            d[j] = _mm256_sub_ps(_mm256_load_ps(s.c(j) + i),
+                                 _mm256_set1_ps(q.c()[j]));
+        }
+        __m256 R[3][3], absR[3][3], t[3];
+        for (uint32_t r = 0; r < 3; r++) {
+            __m256 ax = _mm256_set1_ps(qa[r].x());
+            __m256 ay = _mm256_set1_ps(qa[r].y());
+            __m256 az = _mm256_set1_ps(qa[r].z());
+            t[r] = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(ax, d[0]), _mm256_mul_ps(ay, d[1])),
+                _mm256_mul_ps(az, d[2]));
+            for (uint32_t j = 0; j < 3; j++) {
+                R[r][j] = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(ax, b[j][0]),
+                                  _mm256_mul_ps(ay, b[j][1])),
+                    _mm256_mul_ps(az, b[j][2]));
+                absR[r][j] = _mm256_add_ps(abs_avx2(R[r][j]), eps);
+            }
+        }
+        __m256 sep = _mm256_setzero_ps();
+        __m256 inner = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (uint32_t r = 0; r < 3; r++) {
+            __m256 rb = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(hb[0], absR[r][0]),
+                              _mm256_mul_ps(hb[1], absR[r][1])),
+                _mm256_mul_ps(hb[2], absR[r][2]));
+            __m256 at = abs_avx2(t[r]);
+            sep = _mm256_or_ps(sep, _mm256_cmp_ps(at, _mm256_add_ps(ha[r], rb),
+                                                  _CMP_GT_OQ));
+            inner = _mm256_and_ps(
+                inner, _mm256_cmp_ps(_mm256_add_ps(at, rb), ha[r], _CMP_LT_OQ));
+        }
+        for (uint32_t j = 0; j < 3; j++) {
+            __m256 tb = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(t[0], R[0][j]),
+                              _mm256_mul_ps(t[1], R[1][j])),
+                _mm256_mul_ps(t[2], R[2][j]));
+            __m256 ra = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(ha[0], absR[0][j]),
+                              _mm256_mul_ps(ha[1], absR[1][j])),
+                _mm256_mul_ps(ha[2], absR[2][j]));
+            sep = _mm256_or_ps(
+                sep, _mm256_cmp_ps(abs_avx2(tb), _mm256_add_ps(ra, hb[j]),
+                                   _CMP_GT_OQ));
+        }
+        if ((uint32_t(_mm256_movemask_ps(sep)) & valid) == valid) {
+            sink(i, 0u, 0u);
+            continue;
+        }
+        for (uint32_t r = 0; r < 3; r++) {
+            uint32_t r1 = (r + 1) % 3, r2 = (r + 2) % 3;
+            for (uint32_t j = 0; j < 3; j++) {
+                uint32_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+                __m256 ra = _mm256_add_ps(_mm256_mul_ps(ha[r1], absR[r2][j]),
+                                          _mm256_mul_ps(ha[r2], absR[r1][j]));
+                __m256 rb = _mm256_add_ps(_mm256_mul_ps(hb[j1], absR[r][j2]),
+                                          _mm256_mul_ps(hb[j2], absR[r][j1]));
+                __m256 tl = _mm256_sub_ps(_mm256_mul_ps(t[r2], R[r1][j]),
+                                          _mm256_mul_ps(t[r1], R[r2][j]));
+                sep = _mm256_or_ps(
+                    sep, _mm256_cmp_ps(abs_avx2(tl), _mm256_add_ps(ra, rb),
+                                       _CMP_GT_OQ));
+            }
+        }
+        uint32_t hit = ~uint32_t(_mm256_movemask_ps(sep)) & valid;
+        sink(i, hit, uint32_t(_mm256_movemask_ps(inner)) & hit);
+    }
+}
+#endif
+// 对每个盒进行intersectTest(query, boxes[i]), 结果的值写入results[i]
+// 0为相离, 1为相交, 2为盒严格在query内; results至少有boxes.size()个元素
+// 仅有AVX2实现, 其余情况逐个调用intersectTest
+inline void intersectTestBatch(const OBB<float>& query,
+                               const OBBSoA& boxes,
+                               uint8_t* results) {
+    uint32_t n = boxes.size();
+    auto sink = [&](uint32_t i, uint32_t hit, uint32_t in) {
+        uint64_t bytes = BYTE_MASK_TABLE[hit] + BYTE_MASK_TABLE[in];
+        std::memcpy(results + i, &bytes, std::min(n - i, OBBSoA::LANES));
+    };
+#if defined(BL_MATH_SIMD_DISPATCH)
+    if (simd_level() == SimdLevel::avx2) {
+        intersect_obb_batch_avx2(query, boxes, sink);
+        return;
+    }
+#endif
+    intersect_obb_batch_scalar(query, boxes, sink);
+}
+
+// 视锥体6个平面的SoA形式, 第6, 7个元素重复最后一个平面, 使任意3位序号都有效
+// 盒在平面外侧(法线方向为外)当且仅当离平面最近的顶点在外侧,
+// 即各轴法线分量非负时取min, 否则取max, 代入n·p + d > 0
+struct FrustumPlanes8 {
+    alignas(32) float n[3][8];
+    alignas(32) float d[8];
+    explicit FrustumPlanes8(const std::array<Plane<float>, 6>& planes) {
+        for (uint32_t p = 0; p < 8; p++) {
+            const Plane<float>& plane = planes[std::min(p, 5u)];
+            for (uint32_t k = 0; k < 3; k++)
+                n[k][p] = plane.n()[k];
+            d[p] = plane.d();
+        }
+    }
+    bool outer(uint32_t p, const AABBSoA& s, uint32_t i) const {
+        float r = d[p];
+        for (uint32_t k = 0; k < 3; k++)
+            r += n[k][p] * (n[k][p] >= 0 ? s.min(k)[i] : s.max(k)[i]);
+        return r > 0;
+    }
+};
+// 剔除内核: 处理盒[b, e), b为LANES的倍数, 可见的序号追加到out
+// cache非空时先测试各盒上次被剔除的平面, 仍在其外侧的盒跳过其余平面
+inline void cull_frustum_scalar(const FrustumPlanes8& P,
+                                const AABBSoA& s,
+                                uint32_t b,
+                                uint32_t e,
+                                uint8_t* cache,
+                                std::vector<uint32_t>& out) {
+    for (uint32_t i = b; i < e; i++) {
+        if (cache && P.outer(cache[i] & 7, s, i))
+            continue;
+        uint32_t p = 0;
+        while (p < 6 && !P.outer(p, s, i))
+            p++;
+        if (p == 6)
+            out.push_back(i);
+        else if (cache)
+            cache[i] = p;
+    }
+}
+#if defined(BL_MATH_SIMD_DISPATCH)
+BL_TARGET_SSE41 inline void cull_frustum_sse41(const FrustumPlanes8& P,
+                                               const AABBSoA& s,
+                                               uint32_t b,
+                                               uint32_t e,
+                                               uint8_t* cache,
+                                               std::vector<uint32_t>& out) {
+    const __m128 zero = _mm_setzero_ps();
+    const float *mn[3], *mx[3];
+    for (uint32_t k = 0; k < 3; k++) {
+        mn[k] = s.min(k);
+        mx[k] = s.max(k);
+    }
+    for (uint32_t i = b; i < e; i += 4) {
+        uint32_t valid = e - i >= 4 ? 0xF : (1u << (e - i)) - 1;
+        __m128 lo[3] = {_mm_load_ps(mn[0] + i), _mm_load_ps(mn[1] + i),
+                        _mm_load_ps(mn[2] + i)};
+        __m128 hi[3] = {_mm_load_ps(mx[0] + i), _mm_load_ps(mx[1] + i),
+                        _mm_load_ps(mx[2] + i)};
+        if (cache) {
+            uint32_t q[4];
+            for (uint32_t j = 0; j < 4; j++)
+                q[j] = cache[i + j] & 7;
+            __m128 r = _mm_setr_ps(P.d[q[0]], P.d[q[1]], P.d[q[2]], P.d[q[3]]);
+            for (uint32_t k = 0; k < 3; k++) {
+                const float* pn = P.n[k];
+                __m128 n = _mm_setr_ps(pn[q[0]], pn[q[1]], pn[q[2]], pn[q[3]]);
+                // 按法线分量的符号位逐通道选取min/max
+                __m128 v = _mm_blendv_ps(lo[k], hi[k], n);
+                r = _mm_add_ps(r, _mm_mul_ps(n, v));
+            }
+            if ((_mm_movemask_ps(_mm_cmpgt_ps(r, zero)) & valid) == valid)
+                continue;
+        }
+        __m128 outer = zero, fail = zero;
+        for (uint32_t p = 0; p < 6; p++) {
+            // 按法线分量的符号位选取min/max, 三个轴展开以免逐轴分支
+            __m128 nx = _mm_set1_ps(P.n[0][p]);
+            __m128 ny = _mm_set1_ps(P.n[1][p]);
+            __m128 nz = _mm_set1_ps(P.n[2][p]);
+            __m128 r =
+                _mm_add_ps(_mm_set1_ps(P.d[p]),
+                           _mm_mul_ps(nx, _mm_blendv_ps(lo[0], hi[0], nx)));
+            r = _mm_add_ps(r, _mm_mul_ps(ny, _mm_blendv_ps(lo[1], hi[1], ny)));
+            r = _mm_add_ps(r, _mm_mul_ps(nz, _mm_blendv_ps(lo[2], hi[2], nz)));
+            __m128 o = _mm_cmpgt_ps(r, zero);
+            fail = _mm_blendv_ps(fail, _mm_set1_ps(float(p)),
+                                 _mm_andnot_ps(outer, o));
+            outer = _mm_or_ps(outer, o);
+        }
+        uint32_t culled = uint32_t(_mm_movemask_ps(outer)) & valid;
+        for (uint32_t m = ~culled & valid; m; m &= m - 1)
+            out.push_back(i + std::countr_zero(m));
+        if (cache && culled) {
+            alignas(16) float f[4];
+            _mm_store_ps(f, fail);
+            for (uint32_t m = culled; m; m &= m - 1) {
+                uint32_t j = std::countr_zero(m);
+                cache[i + j] = uint8_t(f[j]);
+            }
+        }
+    }
+}
+BL_TARGET_AVX2 inline void cull_frustum_avx2(const FrustumPlanes8& P,
+                                             const AABBSoA& s,
+                                             uint32_t b,
+                                             uint32_t e,
+                                             uint8_t* cache,
+                                             std::vector<uint32_t>& out) {
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 pn[3], pd = _mm256_load_ps(P.d);
+    for (uint32_t k = 0; k < 3; k++)
+        pn[k] = _mm256_load_ps(P.n[k]);
+    const float *mn[3], *mx[3];
+    for (uint32_t k = 0; k < 3; k++) {
+        mn[k] = s.min(k);
+        mx[k] = s.max(k);
+    }
+    for (uint32_t i = b; i < e; i += 8) {
+        uint32_t valid = e - i >= 8 ? 0xFF : (1u << (e - i)) - 1;
+        __m256 lo[3] = {_mm256_load_ps(mn[0] + i), _mm256_load_ps(mn[1] + i),
+                        _mm256_load_ps(mn[2] + i)};
+        __m256 hi[3] = {_mm256_load_ps(mx[0] + i), _mm256_load_ps(mx[1] + i),
+                        _mm256_load_ps(mx[2] + i)};
+        if (cache) {
+            // 以各盒缓存的平面序号从8个平面中逐通道选取
+            __m256i q = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cache + i)));
+            __m256 r = _mm256_permutevar8x32_ps(pd, q);
+            for (uint32_t k = 0; k < 3; k++) {
+                __m256 n = _mm256_permutevar8x32_ps(pn[k], q);
+                __m256 v = _mm256_blendv_ps(lo[k], hi[k], n);
+                r = _mm256_add_ps(r, _mm256_mul_ps(n, v));
+            }
+            uint32_t m = _mm256_movemask_ps(_mm256_cmp_ps(r, zero, _CMP_GT_OQ));
+            if ((m & valid) == valid)
+                continue;
+        }
+        __m256 outer = zero, fail = zero;
+        for (uint32_t p = 0; p < 6; p++) {
+            // 按法线分量的符号位选取min/max, 三个轴展开以免逐轴分支
+            __m256 nx = _mm256_broadcast_ss(&P.n[0][p]);
+            __m256 ny = _mm256_broadcast_ss(&P.n[1][p]);
+            __m256 nz = _mm256_broadcast_ss(&P.n[2][p]);
+            __m256 r = _mm256_add_ps(
+                _mm256_broadcast_ss(&P.d[p]),
+                _mm256_mul_ps(nx, _mm256_blendv_ps(lo[0], hi[0], nx)));
+            r = _mm256_add_ps(
+                r, _mm256_mul_ps(ny, _mm256_blendv_ps(lo[1], hi[1], ny)));
+            r = _mm256_add_ps(
+                r, _mm256_mul_ps(nz, _mm256_blendv_ps(lo[2], hi[2], nz)));
+            __m256 o = _mm256_cmp_ps(r, zero, _CMP_GT_OQ);
+            fail = _mm256_blendv_ps(fail, _mm256_set1_ps(float(p)),
+                                    _mm256_andnot_ps(outer, o));
+            outer = _mm256_or_ps(outer, o);
+        }
+        uint32_t culled = uint32_t(_mm256_movemask_ps(outer)) & valid;
+        for (uint32_t m = ~culled & valid; m; m &= m - 1)
+            out.push_back(i + std::countr_zero(m));
+        if (cache && culled) {
+            alignas(32) float f[8];
+            _mm256_store_ps(f, fail);
+            for (uint32_t m = culled; m; m &= m - 1) {
+                uint32_t j = std::countr_zero(m);
+                cache[i + j] = uint8_t(f[j]);
+            }
+        }
+    }
+}
+#endif
+inline void cull_frustum_range(const FrustumPlanes8& P,
+                               const AABBSoA& s,
+                               uint32_t b,
+                               uint32_t e,
+                               uint8_t* cache,
+                               std::vector<uint32_t>& out) {
+#if defined(BL_MATH_SIMD_DISPATCH)
+    switch (simd_level()) {
+        case SimdLevel::avx2:
+            cull_frustum_avx2(P, s, b, e, cache, out);
+            return;
+        case SimdLevel::sse41:
+            cull_frustum_sse41(P, s, b, e, cache, out);
+            return;
+        default:
+            break;
+    }
+#endif
+    cull_frustum_scalar(P, s, b, e, cache, out);
+}
+// cullFrustumBatch每段的输出缓冲区, 由调用者持有并在多次调用间复用以避免分配
+// 同一时刻只能用于一次调用
+struct CullBatchScratch {
+    std::vector<std::vector<uint32_t>> buffers;
+};
+// 视锥体剔除, 平面法线朝外; 将与视锥体相交的盒的序号按升序追加到visible, 返回追加的个数
+// 以default_thread_pool分段并行, 每段写入scratch中各自的缓冲区, 最后按段的顺序拼接
+// planeCache非空时为每个盒记录上次将其剔除的平面并优先测试, 适合逐帧连续变化的视锥体
+inline uint32_t cullFrustumBatch(const std::array<Plane<float>, 6>& planes,
+                                 const AABBSoA& boxes,
+                                 std::vector<uint32_t>& visible,
+                                 CullBatchScratch& scratch,
+                                 std::vector<uint8_t>* planeCache = nullptr) {
+    constexpr uint32_t GRAIN = 4096;  // 每段至少的8盒组数
+    FrustumPlanes8 P(planes);
+    uint32_t n = boxes.size();
+    uint8_t* cache = nullptr;
+    if (planeCache) {
+        // 内核按8个一组读取缓存, 长度补齐到paddedSize
+        if (planeCache->size() < boxes.paddedSize())
+            planeCache->resize(boxes.paddedSize(), 0);
+        cache = planeCache->data();
+    }
+    ThreadPool& pool = default_thread_pool();
+    std::vector<std::vector<uint32_t>>& buffers = scratch.buffers;
+    if (buffers.size() < pool.size())
+        buffers.resize(pool.size());
+    for (auto& buf : buffers)
+        buf.clear();
+    pool.parallel_for(boxes.paddedSize() / AABBSoA::LANES, GRAIN,
+                      [&](uint32_t b, uint32_t e, uint32_t slot) {
+                          cull_frustum_range(P, boxes, b * AABBSoA::LANES,
+                                             std::min(e * AABBSoA::LANES, n),
+                                             cache, buffers[slot]);
+                      });
+    size_t begin = visible.size(), total = 0;
+    std::vector<size_t> offsets(pool.size());
+    for (uint32_t slot = 0; slot < pool.size(); slot++) {
+        offsets[slot] = begin + total;
+        total += buffers[slot].size();
+    }
+    visible.resize(begin + total);
+    pool.parallel_for(pool.size(), 1, [&](uint32_t b, uint32_t e, uint32_t) {
+        for (uint32_t slot = b; slot < e; slot++)
+            std::copy(buffers[slot].begin(), buffers[slot].end(),
+                      visible.begin() + offsets[slot]);
+    });
+    return uint32_t(total);
+}
+// 缓冲区在本次调用内分配
+inline uint32_t cullFrustumBatch(const std::array<Plane<float>, 6>& planes,
+                                 const AABBSoA& boxes,
+                                 std::vector<uint32_t>& visible,
+                                 std::vector<uint8_t>* planeCache = nullptr) {
+    CullBatchScratch scratch;
+    return cullFrustumBatch(planes, boxes, visible, scratch, planeCache);
+}
+// N条射线(N为4或8)的SoA形式, 用于射线包测试与遍历
+// 射线i为o + t * d, t在[0, tMax[i]]内; invD为d各分量的倒数(可为无穷)
+template <uint32_t N>
+    requires(N == 4 || N == 8)
+struct RayPacket {
+    static constexpr uint32_t ALL = (1u << N) - 1;
+    alignas(32) float o[3][N];
+    alignas(32) float d[3][N];
+    alignas(32) float invD[3][N];
+    alignas(32) float tMax[N];
+    void set(uint32_t i,
+             const vec3<float>& origin,
+             const vec3<float>& dir,
+             float maxT = std::numeric_limits<float>::infinity()) {
+        for (uint32_t k = 0; k < 3; k++) {
+            o[k][i] = origin[k];
+            d[k][i] = dir[k];
+            invD[k][i] = 1.0f / dir[k];
+        }
+        tMax[i] = maxT;
+    }
+};
+using RayPacket4 = RayPacket<4>;
+using RayPacket8 = RayPacket<8>;
+
+// 射线包slab内核, 盒为[lo, hi], 射线i的区间为[0, tFar[i]]
+// 返回active中命中的射线掩码, 命中射线的进入距离写入tHit
+template <uint32_t N>
+uint32_t ray_slab_scalar(const RayPacket<N>& r,
+                         const float* lo,
+                         const float* hi,
+                         const float* tFar,
+                         float* tHit,
+                         uint32_t active) {
+    uint32_t mask = 0;
+    for (uint32_t m = active; m; m &= m - 1) {
+        uint32_t i = std::countr_zero(m);
+        float t0 = 0, t1 = tFar[i];
+        for (uint32_t k = 0; k < 3; k++) {
+            float a = (lo[k] - r.o[k][i]) * r.invD[k][i];
+            float b = (hi[k] - r.o[k][i]) * r.invD[k][i];
+            t0 = std::max(t0, std::min(a, b));
+            t1 = std::min(t1, std::max(a, b));
+        }
+        if (t0 <= t1) {
+            mask |= 1u << i;
+            tHit[i] = t0;
+        }
+    }
+    return mask;
+}
+#if defined(BL_MATH_SIMD_DISPATCH)
+template <uint32_t N>
+BL_TARGET_SSE41 uint32_t ray_slab_sse41(const RayPacket<N>& r,
+                                        const float* lo,
+                                        const float* hi,
+                                        const float* tFar,
+                                        float* tHit,
+                                        uint32_t active) {
+    uint32_t mask = 0;
+    for (uint32_t h = 0; h < N; h += 4) {
+        if (((active >> h) & 0xF) == 0)
+            continue;
+        __m128 t0 = _mm_setzero_ps(), t1 = _mm_loadu_ps(tFar + h);
+        for (uint32_t k = 0; k < 3; k++) {
+            __m128 o = _mm_load_ps(r.o[k] + h);
+            __m128 inv = _mm_load_ps(r.invD[k] + h);
+            __m128 a = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(lo[k]), o), inv);
+            __m128 b = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(hi[k]), o), inv);
+            // 操作数顺序使0 * inf产生的NaN与标量实现一样被忽略
+            t0 = _mm_max_ps(_mm_min_ps(b, a), t0);
+            t1 = _mm_min_ps(_mm_max_ps(b, a), t1);
+        }
+        mask |= uint32_t(_mm_movemask_ps(_mm_cmple_ps(t0, t1))) << h;
+        _mm_storeu_ps(tHit + h, t0);
+    }
+    return mask & active;
+}
+BL_TARGET_AVX2 inline uint32_t ray_slab_avx2(const RayPacket<8>& r,
+                                             const float* lo,
+                                             const float* hi,
+                                             const float* tFar,
+                                             float* tHit,
+                                             uint32_t active) {
+    __m256 t0 = _mm256_setzero_ps(), t1 = _mm256_loadu_ps(tFar);
+    for (uint32_t k = 0; k < 3; k++) {
+        __m256 o = _mm256_load_ps(r.o[k]);
+        __m256 inv = _mm256_load_ps(r.invD[k]);
+        __m256 a = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(lo[k]), o), inv);
+        __m256 b = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(hi[k]), o), inv);
+        t0 = _mm256_max_ps(_mm256_min_ps(b, a), t0);
+        t1 = _mm256_min_ps(_mm256_max_ps(b, a), t1);
+    }
+    _mm256_storeu_ps(tHit, t0);
+    return uint32_t(_mm256_movemask_ps(_mm256_cmp_ps(t0, t1, _CMP_LE_OQ))) &
+           active;
+}
+#endif
+// 射线包与AABB的slab测试, 同intersectRay; 只测试active中的射线,
+// 射线i的区间为[0, tFar[i]], 返回命中掩码, tHit[i]仅对命中的射线有效
+template <uint32_t N>
+uint32_t intersectRayPacket(const RayPacket<N>& rays,
+                            const AABB<float>& box,
+                            const float* tFar,
+                            float* tHit,
+                            uint32_t active = RayPacket<N>::ALL) {
+    const float* lo = box.min().data();
+    const float* hi = box.max().data();
+#if defined(BL_MATH_SIMD_DISPATCH)
+    if constexpr (N == 8)
+        if (simd_level() == SimdLevel::avx2)
+            return ray_slab_avx2(rays, lo, hi, tFar, tHit, active);
+    if (simd_level() >= SimdLevel::sse41)
+        return ray_slab_sse41(rays, lo, hi, tFar, tHit, active);
+#endif
+    return ray_slab_scalar(rays, lo, hi, tFar, tHit, active);
+}
+template <uint32_t N>
+uint32_t intersectRayPacket(const RayPacket<N>& rays,
+                            const AABB<float>& box,
+                            float* tHit,
+                            uint32_t active = RayPacket<N>::ALL) {
+    return intersectRayPacket(rays, box, rays.tMax, tHit, active);
+}
+// 射线包与OBB: 先将射线变换到OBB的局部坐标系, 再与[-h, h]进行slab测试
+// 轴为单位正交向量, 变换不改变t
+template <uint32_t N>
+uint32_t intersectRayPacket(const RayPacket<N>& rays,
+                            const OBB<float>& box,
+                            const float* tFar,
+                            float* tHit,
+                            uint32_t active = RayPacket<N>::ALL) {
+    const vec3<float> axes[3] = {box.u(), box.v(), box.w()};
+    RayPacket<N> local;
+    for (uint32_t j = 0; j < 3; j++) {
+        for (uint32_t i = 0; i < N; i++) {
+            float lo = 0, ld = 0;
+            for (uint32_t k = 0; k < 3; k++) {
+                lo += (rays.o[k][i] - box.c()[k]) * axes[j][k];
+                ld += rays.d[k][i] * axes[j][k];
+            }
+            local.o[j][i] = lo;
+            local.d[j][i] = ld;
+            local.invD[j][i] = 1.0f / ld;
+        }
+    }
+    return intersectRayPacket(local, AABB<float>{box.h(), -box.h()}, tFar,
+                              tHit, active);
+}
+template <uint32_t N>
+uint32_t intersectRayPacket(const RayPacket<N>& rays,
+                            const OBB<float>& box,
+                            float* tHit,
+                            uint32_t active = RayPacket<N>::ALL) {
+    return intersectRayPacket(rays, box, rays.tMax, tHit, active);
+}
+}  // namespace BL::Math
+#endif  //!_BOUNDLESS_COLLISION_BATCH_CXX_HPP_
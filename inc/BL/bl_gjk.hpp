@@ -0,0 +1,587 @@
+#ifndef _BOUNDLESS_GJK_CXX_HPP_
+#define _BOUNDLESS_GJK_CXX_HPP_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "bl_collision.hpp"
+#include "bl_parallel.hpp"
+namespace BL::Math {
+// 胶囊体, 线段ab向外扩张半径r
+template <std::floating_point Real>
+struct Capsule {
+    using Vec3 = vec3<Real>;
+    Vec3 _a, _b;
+    Real _r;
+    Vec3 a() const { return _a; }
+    Vec3 b() const { return _b; }
+    Real r() const { return _r; }
+};
+// 点集的凸包, 只保存点, 不需要面信息(可直接使用网格的顶点)
+template <std::floating_point Real>
+struct ConvexHull {
+    using Vec3 = vec3<Real>;
+    std::vector<Vec3> _points;
+    ConvexHull() = default;
+    explicit ConvexHull(std::span<const Vec3> points)
+        : _points(points.begin(), points.end()) {}
+    std::span<const Vec3> points() const { return _points; }
+};
+
+// 支撑函数: 返回形状核心在方向d上最远的点, margin为核心向外扩张的半径
+// 球与胶囊体的核心为点与线段, 使GJK对其距离精确且收敛快
+template <std::floating_point Real>
+vec3<Real> support(const Sphere<Real>& s, const vec3<Real>&) {
+    return s.c();
+}
+template <std::floating_point Real>
+Real margin(const Sphere<Real>& s) {
+    return s.r();
+}
+template <std::floating_point Real>
+vec3<Real> support(const Capsule<Real>& s, const vec3<Real>& d) {
+    return d.dot(s.b() - s.a()) > 0 ? s.b() : s.a();
+}
+template <std::floating_point Real>
+Real margin(const Capsule<Real>& s) {
+    return s.r();
+}
+template <std::floating_point Real>
+vec3<Real> support(const OBB<Real>& s, const vec3<Real>& d) {
+    vec3<Real> w = s.w(), h = s.h();
+    return s.c() + s.u() * std::copysign(h.x(), d.dot(s.u())) +
+           s.v() * std::copysign(h.y(), d.dot(s.v())) +
+           w * std::copysign(h.z(), d.dot(w));
+}
+template <std::floating_point Real>
+Real margin(const OBB<Real>&) {
+    return 0;
+}
+template <std::floating_point Real>
+vec3<Real> support(const AABB<Real>& s, const vec3<Real>& d) {
+    return (d.array() >= 0).select(s.max(), s.min());
+}
+template <std::floating_point Real>
+Real margin(const AABB<Real>&) {
+    return 0;
+}
+template <std::floating_point Real>
+vec3<Real> support(const ConvexHull<Real>& s, const vec3<Real>& d) {
+    std::span<const vec3<Real>> p = s.points();
+    size_t best = 0;
+    Real bestDot = -std::numeric_limits<Real>::infinity();
+    for (size_t i = 0; i < p.size(); i++) {
+        Real t = p[i].dot(d);
+        if (t > bestDot)
+            bestDot = t, best = i;
+    }
+    return p[best];
+}
+template <std::floating_point Real>
+Real margin(const ConvexHull<Real>&) {
+    return 0;
+}
+// 可用于GJK的凸体: 提供Vec3类型及support/margin
+template <typename S>
+concept ConvexShape = requires(const S& s, const typename S::Vec3& d) {
+    { support(s, d) } -> std::convertible_to<typename S::Vec3>;
+    { margin(s) } -> std::convertible_to<typename S::Vec3::Scalar>;
+};
+template <typename S>
+using ShapeScalar = typename S::Vec3::Scalar;
+
+// queryConvex的结果, normal为A指向B的单位向量
+// 分离时distance>0, pointA/pointB为两形状上的最近点
+// 相交时distance<0, -distance为穿透深度, pointA/pointB为两形状上最深的点
+// B沿normal移动-distance即可分离
+template <std::floating_point Real>
+struct GJKResult {
+    bool intersect;
+    Real distance;
+    vec3<Real> normal;
+    vec3<Real> pointA, pointB;
+};
+// 热启动信息: 上次结束时单纯形各顶点的搜索方向
+// 物体逐帧移动不大时, 用这些方向重建的单纯形通常已接近最终结果
+template <std::floating_point Real>
+struct GJKCache {
+    std::array<vec3<Real>, 4> dir;
+    uint32_t count = 0;
+};
+
+// Minkowski差A-B上的点w = a - b, d为得到该点的搜索方向
+template <std::floating_point Real>
+struct GJKVertex {
+    vec3<Real> w, a, b, d;
+};
+template <std::floating_point Real>
+struct GJKSimplex {
+    std::array<GJKVertex<Real>, 4> v;
+    std::array<Real, 4> lambda;  // 最近点的重心坐标
+    uint32_t count = 0;
+    vec3<Real> closest() const {
+        vec3<Real> p = vec3<Real>::Zero();
+        for (uint32_t i = 0; i < count; i++)
+            p += v[i].w * lambda[i];
+        return p;
+    }
+    void witness(vec3<Real>& a, vec3<Real>& b) const {
+        a.setZero();
+        b.setZero();
+        for (uint32_t i = 0; i < count; i++) {
+            a += v[i].a * lambda[i];
+            b += v[i].b * lambda[i];
+        }
+    }
+};
+// 三角形abc上离原点最近的点, 写入3个重心坐标(Ericson, RTCD 5.1.5)
+template <std::floating_point Real>
+void gjk_closest_triangle(const vec3<Real>& a,
+                          const vec3<Real>& b,
+                          const vec3<Real>& c,
+                          Real* l) {
+    vec3<Real> ab = b - a, ac = c - a;
+    Real d1 = -ab.dot(a), d2 = -ac.dot(a);
+    if (d1 <= 0 && d2 <= 0) {
+        l[0] = 1, l[1] = 0, l[2] = 0;
+        return;
+    }
+    Real d3 = -ab.dot(b), d4 = -ac.dot(b);
+    if (d3 >= 0 && d4 <= d3) {
+        l[0] = 0, l[1] = 1, l[2] = 0;
+        return;
+    }
+    Real vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        Real t = d1 / (d1 - d3);
+        l[0] = 1 - t, l[1] = t, l[2] = 0;
+        return;
+    }
+    Real d5 = -ab.dot(c), d6 = -ac.dot(c);
+    if (d6 >= 0 && d5 <= d6) {
+        l[0] = 0, l[1] = 0, l[2] = 1;
+        return;
+    }
+    Real vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        Real t = d2 / (d2 - d6);
+        l[0] = 1 - t, l[1] = 0, l[2] = t;
+        return;
+    }
+    Real va = d3 * d6 - d5 * d4;
+    if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+        Real t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        l[0] = 0, l[1] = 1 - t, l[2] = t;
+        return;
+    }
+    Real denom = 1 / (va + vb + vc);
+    l[1] = vb * denom, l[2] = vc * denom;
+    l[0] = 1 - l[1] - l[2];
+}
+// 求单纯形上离原点最近的点并去掉重心坐标为0的顶点
+// 返回原点是否在四面体内
+template <std::floating_point Real>
+bool gjk_reduce(GJKSimplex<Real>& s) {
+    using Vec3 = vec3<Real>;
+    auto& v = s.v;
+    auto& l = s.lambda;
+    if (s.count == 1) {
+        l[0] = 1;
+    } else if (s.count == 2) {
+        Vec3 e = v[1].w - v[0].w;
+        Real len2 = e.dot(e);
+        Real t = len2 > 0 ? std::clamp(-v[0].w.dot(e) / len2, Real(0),
+                                       Real(1))
+                          : Real(0);
+        l[0] = 1 - t, l[1] = t;
+    } else if (s.count == 3) {
+        gjk_closest_triangle(v[0].w, v[1].w, v[2].w, l.data());
+    } else if (s.count == 4) {
+        // 原点在某个面外时, 最近点在该面上; 均不在面外时原点在四面体内
+        static constexpr uint32_t FACE[4][4] = {
+            {0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0}};
+        Real vol = (v[1].w - v[0].w)
+                       .cross(v[2].w - v[0].w)
+                       .dot(v[3].w - v[0].w);
+        bool flat = std::abs(vol) <=
+                    std::numeric_limits<Real>::epsilon() *
+                        (v[1].w - v[0].w).squaredNorm() *
+                        (v[3].w - v[0].w).norm();
+        Real best = std::numeric_limits<Real>::infinity();
+        std::array<Real, 4> bestL = {0, 0, 0, 0};
+        bool outside = false;
+        for (const auto& f : FACE) {
+            const Vec3 &a = v[f[0]].w, &b = v[f[1]].w, &c = v[f[2]].w;
+            Vec3 n = (b - a).cross(c - a);
+            Real so = -n.dot(a), sd = n.dot(v[f[3]].w - a);
+            // 退化的四面体无法判断内外, 检查所有面
+            if (!flat && so * sd >= 0)
+                continue;
+            outside = true;
+            Real fl[3];
+            gjk_closest_triangle(a, b, c, fl);
+            Vec3 p = a * fl[0] + b * fl[1] + c * fl[2];
+            if (p.squaredNorm() < best) {
+                best = p.squaredNorm();
+                bestL = {0, 0, 0, 0};
+                for (uint32_t k = 0; k < 3; k++)
+                    bestL[f[k]] = fl[k];
+            }
+        }
+        if (!outside) {
+            Eigen::Matrix<Real, 3, 3> m;
+            m << v[1].w - v[0].w, v[2].w - v[0].w, v[3].w - v[0].w;
+            Vec3 x = m.inverse() * -v[0].w;
+            l = {1 - x.sum(), x[0], x[1], x[2]};
+            return true;
+        }
+        l = bestL;
+    }
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < s.count; i++) {
+        if (l[i] > 0) {
+            v[n] = v[i];
+            l[n] = l[i];
+            n++;
+        }
+    }
+    s.count = n;
+    return false;
+}
+// GJK主循环, sup(d)返回方向d上的GJKVertex
+// 返回true表示相交(原点在单纯形内或与其距离可忽略)
+// bound>=0时为布尔测试: 距离下界超过bound即提前判定分离
+template <std::floating_point Real, typename SupportFn>
+bool gjk_run(SupportFn&& sup,
+             GJKSimplex<Real>& s,
+             const GJKCache<Real>* cache,
+             Real bound = -1) {
+    using Vec3 = vec3<Real>;
+    constexpr uint32_t MAX_ITERATION = 64;
+    constexpr Real REL_TOL = std::numeric_limits<Real>::epsilon() * 128;
+    s.count = 0;
+    if (cache) {
+        for (uint32_t i = 0; i < cache->count; i++) {
+            GJKVertex<Real> p = sup(cache->dir[i]);
+            bool dup = false;
+            for (uint32_t j = 0; j < s.count; j++)
+                dup |= (s.v[j].w - p.w).squaredNorm() <=
+                       REL_TOL * p.w.squaredNorm();
+            if (!dup)
+                s.v[s.count++] = p;
+        }
+    }
+    if (s.count == 0)
+        s.v[s.count++] = sup(Vec3::UnitX());
+    if (gjk_reduce(s))
+        return true;
+    Vec3 v = s.closest();
+    Real vv = v.dot(v);
+    for (uint32_t it = 0; it < MAX_ITERATION; it++) {
+        Real maxW2 = 0;
+        for (uint32_t i = 0; i < s.count; i++)
+            maxW2 = std::max(maxW2, s.v[i].w.squaredNorm());
+        // 距离相对单纯形尺度可忽略, 比较平方量故容差也取平方
+        if (vv <= REL_TOL * REL_TOL * maxW2)
+            return true;
+        GJKVertex<Real> p = sup(-v);
+        Real vw = v.dot(p.w);
+        if (bound >= 0 && vw > 0 && vw * vw > vv * bound * bound)
+            return false;
+        // 新点没有使距离明显减小, 已收敛
+        if (vv - vw <= REL_TOL * vv)
+            return false;
+        for (uint32_t i = 0; i < s.count; i++)
+            if (s.v[i].w == p.w)
+                return false;
+        GJKSimplex<Real> prev = s;
+        s.v[s.count++] = p;
+        if (gjk_reduce(s))
+            return true;
+        Vec3 nv = s.closest();
+        Real nvv = nv.dot(nv);
+        // 数值误差使距离不再减小时保留上一个单纯形
+        if (nvv >= vv) {
+            s = prev;
+            return false;
+        }
+        v = nv;
+        vv = nvv;
+    }
+    return false;
+}
+template <std::floating_point Real>
+void gjk_save(const GJKSimplex<Real>& s, GJKCache<Real>* cache) {
+    if (!cache)
+        return;
+    cache->count = s.count;
+    for (uint32_t i = 0; i < s.count; i++)
+        cache->dir[i] = s.v[i].d;
+}
+// 将包含原点的单纯形补为四面体, 原点在单纯形上(接触)时也适用
+template <std::floating_point Real, typename SupportFn>
+bool epa_blow_up(SupportFn&& sup, GJKSimplex<Real>& s) {
+    using Vec3 = vec3<Real>;
+    constexpr Real TOL = std::numeric_limits<Real>::epsilon() * 128;
+    auto tryAdd = [&](const Vec3& d) {
+        GJKVertex<Real> p = sup(d);
+        Real scale = p.w.squaredNorm() + s.v[0].w.squaredNorm();
+        Real dist2;
+        if (s.count == 1) {
+            dist2 = (p.w - s.v[0].w).squaredNorm();
+        } else if (s.count == 2) {
+            Vec3 e = s.v[1].w - s.v[0].w;
+            dist2 = e.cross(p.w - s.v[0].w).squaredNorm() /
+                    std::max(e.squaredNorm(), std::numeric_limits<Real>::min());
+        } else {
+            Vec3 n = (s.v[1].w - s.v[0].w).cross(s.v[2].w - s.v[0].w);
+            Real h = n.dot(p.w - s.v[0].w);
+            dist2 = h * h /
+                    std::max(n.squaredNorm(), std::numeric_limits<Real>::min());
+        }
+        if (dist2 <= TOL * scale)
+            return false;
+        s.v[s.count++] = p;
+        return true;
+    };
+    if (s.count == 1) {
+        bool ok = false;
+        for (uint32_t k = 0; k < 6 && !ok; k++) {
+            Vec3 d = Vec3::Zero();
+            d[k >> 1] = (k & 1) ? Real(-1) : Real(1);
+            ok = tryAdd(d);
+        }
+        if (!ok)
+            return false;
+    }
+    if (s.count == 2) {
+        // 绕线段方向每60度尝试一个垂直方向
+        Vec3 e = (s.v[1].w - s.v[0].w).normalized();
+        Eigen::Index k;
+        e.cwiseAbs().minCoeff(&k);
+        Vec3 axis = Vec3::Zero();
+        axis[k] = 1;
+        Vec3 p = e.cross(axis).normalized(), q = e.cross(p);
+        bool ok = false;
+        for (uint32_t i = 0; i < 6 && !ok; i++) {
+            Real a = Real(i) * Real(1.0471975511965976);
+            ok = tryAdd(p * std::cos(a) + q * std::sin(a));
+        }
+        if (!ok)
+            return false;
+    }
+    if (s.count == 3) {
+        Vec3 n = (s.v[1].w - s.v[0].w).cross(s.v[2].w - s.v[0].w);
+        if (!tryAdd(n) && !tryAdd(-n))
+            return false;
+    }
+    return true;
+}
+// 扩展多面体(EPA)求穿透深度, s为包含原点的四面体
+template <std::floating_point Real, typename SupportFn>
+void epa_run(SupportFn&& sup, const GJKSimplex<Real>& s, GJKResult<Real>& r) {
+    using Vec3 = vec3<Real>;
+    constexpr uint32_t MAX_ITERATION = 64;
+    constexpr Real REL_TOL = std::numeric_limits<Real>::epsilon() * 1024;
+    struct Face {
+        uint32_t i[3];
+        Vec3 n;
+        Real dist;
+    };
+    // 缓冲区在同一线程的调用间复用, 避免每次查询分配
+    thread_local std::vector<GJKVertex<Real>> verts;
+    thread_local std::vector<Face> faces;
+    thread_local std::vector<std::pair<uint32_t, uint32_t>> horizon;
+    verts.assign(s.v.begin(), s.v.begin() + 4);
+    faces.clear();
+    Vec3 center = Vec3::Zero();
+    for (const auto& p : verts)
+        center += p.w / Real(4);
+    auto addFace = [&](uint32_t a, uint32_t b, uint32_t c) {
+        Face f = {{a, b, c}, Vec3::Zero(), std::numeric_limits<Real>::max()};
+        Vec3 n = (verts[b].w - verts[a].w).cross(verts[c].w - verts[a].w);
+        // 以多面体内部一点定向, 原点在面上时也可靠
+        if (n.dot(verts[a].w - center) < 0) {
+            std::swap(f.i[1], f.i[2]);
+            n = -n;
+        }
+        Real len = n.norm();
+        if (len > std::numeric_limits<Real>::min()) {
+            f.n = n / len;
+            f.dist = std::max(Real(0), f.n.dot(verts[a].w));
+        }
+        faces.push_back(f);
+    };
+    addFace(0, 1, 2);
+    addFace(0, 3, 1);
+    addFace(0, 2, 3);
+    addFace(1, 3, 2);
+    auto closestFace = [&] {
+        uint32_t best = 0;
+        for (uint32_t i = 1; i < faces.size(); i++)
+            if (faces[i].dist < faces[best].dist)
+                best = i;
+        return best;
+    };
+    for (uint32_t it = 0; it < MAX_ITERATION; it++) {
+        Face f = faces[closestFace()];
+        GJKVertex<Real> p = sup(f.n);
+        Real gap = p.w.dot(f.n) - f.dist;
+        if (gap <= REL_TOL * std::max(f.dist, p.w.norm()))
+            break;
+        uint32_t idx = verts.size();
+        verts.push_back(p);
+        horizon.clear();
+        // 删除新点可见的面(至少包括最近面), 只出现一次的边构成地平线
+        for (uint32_t i = 0; i < faces.size();) {
+            const Face& g = faces[i];
+            if (g.n.dot(p.w - verts[g.i[0]].w) <= 0) {
+                i++;
+                continue;
+            }
+            for (uint32_t k = 0; k < 3; k++) {
+                std::pair<uint32_t, uint32_t> e = {g.i[k], g.i[(k + 1) % 3]};
+                auto rev = std::find(horizon.begin(), horizon.end(),
+                                     std::make_pair(e.second, e.first));
+                if (rev != horizon.end()) {
+                    *rev = horizon.back();
+                    horizon.pop_back();
+                } else {
+                    horizon.push_back(e);
+                }
+            }
+            faces[i] = faces.back();
+            faces.pop_back();
+        }
+        for (auto& e : horizon)
+            addFace(e.first, e.second, idx);
+    }
+    const Face& f = faces[closestFace()];
+    r.intersect = true;
+    r.distance = -f.dist;
+    r.normal = f.n;
+    // 原点在最近面上的投影的重心坐标
+    const Vec3 &a = verts[f.i[0]].w, &b = verts[f.i[1]].w,
+               &c = verts[f.i[2]].w;
+    Real l[3];
+    gjk_closest_triangle<Real>(a - f.n * f.dist, b - f.n * f.dist,
+                               c - f.n * f.dist, l);
+    r.pointA = r.pointB = Vec3::Zero();
+    for (uint32_t k = 0; k < 3; k++) {
+        r.pointA += verts[f.i[k]].a * l[k];
+        r.pointB += verts[f.i[k]].b * l[k];
+    }
+}
+template <ConvexShape A, ConvexShape B>
+    requires std::same_as<ShapeScalar<A>, ShapeScalar<B>>
+auto gjk_core_support(const A& a, const B& b) {
+    return [&a, &b](const typename A::Vec3& d) {
+        using V = GJKVertex<ShapeScalar<A>>;
+        V p;
+        p.a = support(a, d);
+        p.b = support(b, typename A::Vec3(-d));
+        p.w = p.a - p.b;
+        p.d = d;
+        return p;
+    };
+}
+// GJK距离与EPA穿透深度查询, 见GJKResult
+// cache非空时从中热启动, 并写回本次的单纯形供下一帧使用
+template <ConvexShape A, ConvexShape B>
+    requires std::same_as<ShapeScalar<A>, ShapeScalar<B>>
+GJKResult<ShapeScalar<A>> queryConvex(const A& a,
+                                      const B& b,
+                                      GJKCache<ShapeScalar<A>>* cache =
+                                          nullptr) {
+    using Real = ShapeScalar<A>;
+    using Vec3 = vec3<Real>;
+    Real ma = margin(a), mb = margin(b);
+    GJKResult<Real> r;
+    GJKSimplex<Real> s;
+    bool hit = gjk_run<Real>(gjk_core_support(a, b), s, cache);
+    gjk_save(s, cache);
+    if (!hit) {
+        // 核心分离: 距离减去两侧的margin, 结果为负时是浅穿透
+        Vec3 pa, pb;
+        s.witness(pa, pb);
+        Vec3 v = pb - pa;
+        Real len = v.norm();
+        if (len > 0) {
+            r.normal = v / len;
+            r.distance = len - ma - mb;
+            r.intersect = r.distance < 0;
+            r.pointA = pa + r.normal * ma;
+            r.pointB = pb - r.normal * mb;
+            return r;
+        }
+    }
+    // 核心相交: 由EPA求核心的穿透深度, 加上两侧margin即为完整形状的深度
+    // 核心为多面体(点, 线段, 盒, 凸包), 结果对球与胶囊体也是精确的
+    auto core = gjk_core_support(a, b);
+    GJKSimplex<Real> touch = s;
+    if (s.count == 4 || epa_blow_up<Real>(core, s)) {
+        epa_run<Real>(core, s, r);
+    } else {
+        // 核心的Minkowski差退化为点, 线段或平面片, 核心深度为0
+        // 法线取其垂直方向, 符号无法确定
+        r.normal = Vec3::UnitX();
+        if (s.count >= 2) {
+            Vec3 e = s.v[1].w - s.v[0].w, f = Vec3::Zero();
+            Eigen::Index k;
+            e.cwiseAbs().minCoeff(&k);
+            f[k] = 1;
+            if (s.count == 3)
+                f = s.v[2].w - s.v[0].w;
+            r.normal = e.cross(f).normalized();
+        }
+        r.distance = 0;
+        touch.witness(r.pointA, r.pointB);
+    }
+    r.intersect = true;
+    r.distance -= ma + mb;
+    r.pointA += r.normal * ma;
+    r.pointB -= r.normal * mb;
+    return r;
+}
+// 只判断是否相交, 找到分离轴即提前结束, 比queryConvex快
+template <ConvexShape A, ConvexShape B>
+    requires std::same_as<ShapeScalar<A>, ShapeScalar<B>>
+bool intersectConvex(const A& a,
+                     const B& b,
+                     GJKCache<ShapeScalar<A>>* cache = nullptr) {
+    using Real = ShapeScalar<A>;
+    Real bound = margin(a) + margin(b);
+    GJKSimplex<Real> s;
+    bool hit = gjk_run<Real>(gjk_core_support(a, b), s, cache, bound);
+    gjk_save(s, cache);
+    return hit || s.closest().squaredNorm() <= bound * bound;
+}
+// 对粗测得到的对(如OctTree::collectPairs的结果)并行执行queryConvex
+// shapeOf(T&)返回对象的凸体, 结果按pairs的顺序写入out
+// caches非空时须与pairs等长且逐帧对应同一对, 用于热启动
+template <typename T,
+          typename ShapeFn,
+          typename S = std::remove_cvref_t<std::invoke_result_t<ShapeFn&, T&>>>
+    requires ConvexShape<S>
+void queryConvexBatch(const std::vector<std::pair<T*, T*>>& pairs,
+                      ShapeFn&& shapeOf,
+                      std::vector<GJKResult<ShapeScalar<S>>>& out,
+                      std::span<GJKCache<ShapeScalar<S>>> caches = {}) {
+    constexpr uint32_t GRAIN = 64;
+    out.resize(pairs.size());
+    default_thread_pool().parallel_for(
+        pairs.size(), GRAIN, [&](uint32_t b, uint32_t e, uint32_t) {
+            for (uint32_t i = b; i < e; i++)
+                out[i] = queryConvex(shapeOf(*pairs[i].first),
+                                     shapeOf(*pairs[i].second),
+                                     caches.empty() ? nullptr : &caches[i]);
+        });
+}
+}  // namespace BL::Math
+#endif  //!_BOUNDLESS_GJK_CXX_HPP_
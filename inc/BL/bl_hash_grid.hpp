@@ -0,0 +1,316 @@
+#ifndef _BOUNDLESS_HASH_GRID_CXX_HPP_
+#define _BOUNDLESS_HASH_GRID_CXX_HPP_
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+#include "bl_collision.hpp"
+#include "bl_parallel.hpp"
+namespace BL::Math {
+// 均匀网格空间哈希, 适合大量尺寸相近且每帧移动的对象
+// 对象按中心点放入一个格子, 查询时将范围扩大最大半尺寸以包含跨格的对象
+// 每帧以build整体重建: 并行计算格子键, 插入开放寻址哈希表并计数, 再按计数排序
+// 不持有对象, boxes与data须在查询期间保持有效
+template <typename T, std::floating_point Scalar = float>
+class SpatialHashGrid {
+   public:
+    using Box = AABB<Scalar>;
+    using Vec3 = vec3<Scalar>;
+    using IterateFunction = std::function<void(const Box&, T&)>;
+    using PairList = std::vector<std::pair<T*, T*>>;
+    static constexpr uint32_t NULL_NEXT = (~0u);
+    static constexpr uint64_t EMPTY_KEY = (~0ull);
+    // 每轴21位, 格子坐标超出[-2^20, 2^20)时会与其他格子重合(仍然正确, 只是变慢)
+    static constexpr uint32_t COORD_BITS = 21;
+    static constexpr uint32_t PARALLEL_GRAIN = 16384;
+    // 按哈希高位分区, 每个分区拥有独立的小哈希表, 重建时无需原子操作
+    static constexpr uint32_t PARTITION_BITS = 8;
+    static constexpr uint32_t PARTITION_COUNT = 1u << PARTITION_BITS;
+
+   private:
+    Scalar cellSize = 1, invCellSize = 1;
+    Scalar maxHalfSize = 0;  // 所有对象各轴半尺寸的最大值
+    std::span<const Box> boxes;
+    std::span<T> objects;
+    std::vector<uint64_t> objectKey;
+    // 按分区排列的对象
+    std::vector<uint64_t> partKey;
+    std::vector<uint32_t> partObject;
+    std::vector<uint32_t> partSlot;
+    std::vector<uint32_t> histogram;  // 每段每分区的对象数
+    std::array<uint32_t, PARTITION_COUNT + 1> partStart{};  // 分区在sorted中的起点
+    std::array<uint32_t, PARTITION_COUNT + 1> partBase{};  // 分区子表的起点
+    std::vector<uint32_t> sorted;  // 按格子排列的对象序号
+    // 各分区的开放寻址(线性探测)子表依次排列, 子表大小为2的幂
+    // 且不小于分区对象数的2倍, 因此负载因子不超过0.5
+    std::vector<uint64_t> tableKey;
+    std::vector<uint32_t> tableCount;
+    std::vector<uint32_t> tableEnd;  // 格子在sorted中的区间为[end-count, end)
+
+    // 截断后对负数修正, 即floor; 未启用SSE4.1时std::floor是库函数调用
+    int32_t coordOf(Scalar v) const {
+        Scalar f = v * invCellSize;
+        int32_t i = int32_t(f);
+        return i - (f < Scalar(i));
+    }
+    static uint64_t keyOf(int32_t x, int32_t y, int32_t z) {
+        constexpr uint64_t mask = (1ull << COORD_BITS) - 1;
+        return (uint64_t(x) & mask) | ((uint64_t(y) & mask) << COORD_BITS) |
+               ((uint64_t(z) & mask) << (2 * COORD_BITS));
+    }
+    static uint32_t hashOf(uint64_t key) {
+        return uint32_t((key * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+    static uint32_t partitionOf(uint32_t hash) {
+        return hash >> (32 - PARTITION_BITS);
+    }
+    // 查找键所在的槽, 不存在时返回NULL_NEXT
+    uint32_t findSlot(uint64_t key) const {
+        uint32_t hash = hashOf(key), p = partitionOf(hash);
+        uint32_t base = partBase[p], mask = partBase[p + 1] - base - 1;
+        if (partBase[p + 1] == base)
+            return NULL_NEXT;
+        for (uint32_t s = hash & mask;; s = (s + 1) & mask) {
+            if (tableKey[base + s] == key)
+                return base + s;
+            if (tableKey[base + s] == EMPTY_KEY)
+                return NULL_NEXT;
+        }
+    }
+    // 查找或占用键所在的槽
+    uint32_t claimSlot(uint64_t key) {
+        uint32_t hash = hashOf(key), p = partitionOf(hash);
+        uint32_t base = partBase[p], mask = partBase[p + 1] - base - 1;
+        for (uint32_t s = hash & mask;; s = (s + 1) & mask) {
+            if (tableKey[base + s] == EMPTY_KEY)
+                tableKey[base + s] = key;
+            if (tableKey[base + s] == key)
+                return base + s;
+        }
+    }
+    // 重建分区p的子表, 并将其对象按格子排入sorted
+    void buildPartition(uint32_t p) {
+        uint32_t base = partBase[p], tableLast = partBase[p + 1];
+        std::fill(tableKey.begin() + base, tableKey.begin() + tableLast,
+                  EMPTY_KEY);
+        std::fill(tableCount.begin() + base, tableCount.begin() + tableLast,
+                  0);
+        uint32_t b = partStart[p], e = partStart[p + 1];
+        for (uint32_t j = b; j < e; j++) {
+            uint32_t s = claimSlot(partKey[j]);
+            partSlot[j] = s;
+            tableCount[s]++;
+        }
+        uint32_t sum = b;
+        for (uint32_t s = base; s < tableLast; s++) {
+            tableEnd[s] = sum;
+            sum += tableCount[s];
+        }
+        // tableEnd从各格子的起点递增到终点, 格子内保持对象原顺序
+        for (uint32_t j = b; j < e; j++)
+            sorted[tableEnd[partSlot[j]]++] = partObject[j];
+    }
+    // 对与扩大后的box重叠的每个非空格子调用fn(begin, end), 区间为sorted下标
+    // 格子数多于对象数时改为遍历全部对象
+    template <typename Fn>
+    void forCells(const Box& box, Fn&& fn) const {
+        if (sorted.empty())
+            return;
+        Vec3 lo = box.min() - Vec3::Constant(maxHalfSize);
+        Vec3 hi = box.max() + Vec3::Constant(maxHalfSize);
+        int32_t l[3], h[3];
+        uint64_t cells = 1;
+        for (int k = 0; k < 3; k++) {
+            l[k] = coordOf(lo[k]);
+            h[k] = coordOf(hi[k]);
+            cells *= uint64_t(h[k] - l[k] + 1);
+        }
+        if (cells > sorted.size()) {
+            fn(0u, uint32_t(sorted.size()));
+            return;
+        }
+        for (int32_t z = l[2]; z <= h[2]; z++)
+            for (int32_t y = l[1]; y <= h[1]; y++)
+                for (int32_t x = l[0]; x <= h[0]; x++) {
+                    uint32_t s = findSlot(keyOf(x, y, z));
+                    if (s != NULL_NEXT)
+                        fn(tableEnd[s] - tableCount[s], tableEnd[s]);
+                }
+    }
+
+   public:
+    // 格子边长, 宜取对象尺寸的1到2倍, 在下次build时生效
+    void setCellSize(Scalar size) {
+        cellSize = size;
+        invCellSize = Scalar(1) / size;
+    }
+    Scalar getCellSize() const { return cellSize; }
+    uint32_t size() const { return sorted.size(); }
+    T& data(uint32_t i) { return objects[i]; }
+    const Box& box(uint32_t i) const { return boxes[i]; }
+    // 以objectBoxes[i], data[i]为对象重建网格, 对象序号即i
+    void build(std::span<const Box> objectBoxes, std::span<T> data) {
+        boxes = objectBoxes;
+        objects = data;
+        uint32_t n = objectBoxes.size();
+        ThreadPool& pool = default_thread_pool();
+        objectKey.resize(n);
+        partKey.resize(n);
+        partObject.resize(n);
+        partSlot.resize(n);
+        sorted.resize(n);
+        histogram.assign(pool.size() * PARTITION_COUNT, 0);
+        std::vector<Scalar> halfSizes(pool.size(), Scalar(0));
+        // 计算格子键, 统计每段落入各分区的对象数
+        pool.parallel_for(
+            n, PARALLEL_GRAIN, [&](uint32_t b, uint32_t e, uint32_t slot) {
+                uint32_t* count = &histogram[slot * PARTITION_COUNT];
+                Scalar half = 0;
+                for (uint32_t i = b; i < e; i++) {
+                    const Box& bx = boxes[i];
+                    Vec3 c = bx.c();
+                    half = std::max(half, bx.h().maxCoeff());
+                    uint64_t key = keyOf(coordOf(c.x()), coordOf(c.y()),
+                                         coordOf(c.z()));
+                    objectKey[i] = key;
+                    count[partitionOf(hashOf(key))]++;
+                }
+                halfSizes[slot] = half;
+            });
+        maxHalfSize = *std::max_element(halfSizes.begin(), halfSizes.end());
+        // 前缀和, 之后histogram为每段在各分区中的写入位置
+        uint32_t sum = 0, tableSize = 0;
+        for (uint32_t p = 0; p < PARTITION_COUNT; p++) {
+            partStart[p] = sum;
+            for (uint32_t slot = 0; slot < pool.size(); slot++) {
+                uint32_t& c = histogram[slot * PARTITION_COUNT + p];
+                uint32_t count = c;
+                c = sum;
+                sum += count;
+            }
+            partBase[p] = tableSize;
+            uint32_t count = sum - partStart[p];
+            tableSize += count ? std::bit_ceil(2 * count) : 0;
+        }
+        partStart[PARTITION_COUNT] = sum;
+        partBase[PARTITION_COUNT] = tableSize;
+        tableKey.resize(tableSize);
+        tableCount.resize(tableSize);
+        tableEnd.resize(tableSize);
+        // 按分区分散, 分段方式与上一次parallel_for相同
+        pool.parallel_for(
+            n, PARALLEL_GRAIN, [&](uint32_t b, uint32_t e, uint32_t slot) {
+                uint32_t* pos = &histogram[slot * PARTITION_COUNT];
+                for (uint32_t i = b; i < e; i++) {
+                    uint64_t key = objectKey[i];
+                    uint32_t j = pos[partitionOf(hashOf(key))]++;
+                    partKey[j] = key;
+                    partObject[j] = i;
+                }
+            });
+        pool.parallel_for(PARTITION_COUNT, 1,
+                          [&](uint32_t b, uint32_t e, uint32_t) {
+                              for (uint32_t p = b; p < e; p++)
+                                  buildPartition(p);
+                          });
+    }
+    // 对与size相交的每个对象调用fn(box, data)
+    template <typename Visitor>
+        requires std::invocable<Visitor&, const Box&, T&>
+    void find(const Box& size, Visitor&& fn) {
+        forCells(size, [&](uint32_t b, uint32_t e) {
+            for (uint32_t i = b; i < e; i++) {
+                uint32_t p = sorted[i];
+                if (intersectTest(size, boxes[p]) >= CollisionResult::intersect)
+                    fn(boxes[p], objects[p]);
+            }
+        });
+    }
+    void find(const Box& size, const IterateFunction& fn) {
+        find<const IterateFunction&>(size, fn);
+    }
+    // 将与以p为心r为半径的球相交的对象序号追加到out
+    void radius(const Vec3& p, Scalar r, std::vector<uint32_t>& out) const {
+        Scalar r2 = r * r;
+        Box range = {p + Vec3::Constant(r), p - Vec3::Constant(r)};
+        forCells(range, [&](uint32_t b, uint32_t e) {
+            for (uint32_t i = b; i < e; i++)
+                if (distanceSquared(p, boxes[sorted[i]]) <= r2)
+                    out.push_back(sorted[i]);
+        });
+    }
+    std::vector<uint32_t> radius(const Vec3& p, Scalar r) const {
+        std::vector<uint32_t> out;
+        radius(p, r, out);
+        return out;
+    }
+    // 收集全部相交(含接触)的对象对, 每对只出现一次
+    // 每个格子与自身及"之后"的相邻格子配对, 相邻范围由最大对象尺寸决定
+    void collectPairs(PairList& out) {
+        out.clear();
+        if (sorted.empty())
+            return;
+        int32_t ring = int32_t(std::ceil(2 * maxHalfSize * invCellSize));
+        std::vector<std::array<int32_t, 3>> offsets;
+        for (int32_t z = -ring; z <= ring; z++)
+            for (int32_t y = -ring; y <= ring; y++)
+                for (int32_t x = -ring; x <= ring; x++)
+                    if (z > 0 || (z == 0 && (y > 0 || (y == 0 && x > 0))))
+                        offsets.push_back({x, y, z});
+        ThreadPool& pool = default_thread_pool();
+        std::vector<PairList> buffers(pool.size());
+        uint32_t mask = uint32_t(1u << COORD_BITS) - 1;
+        pool.parallel_for(
+            tableKey.size(), 1024, [&](uint32_t b, uint32_t e, uint32_t slot) {
+                PairList& buf = buffers[slot];
+                for (uint32_t s = b; s < e; s++) {
+                    if (tableKey[s] == EMPTY_KEY)
+                        continue;
+                    uint32_t end = tableEnd[s], begin = end - tableCount[s];
+                    for (uint32_t i = begin; i < end; i++)
+                        for (uint32_t j = i + 1; j < end; j++)
+                            if (intersectTest(boxes[sorted[i]],
+                                              boxes[sorted[j]]) >=
+                                CollisionResult::intersect)
+                                buf.push_back({&objects[sorted[i]],
+                                               &objects[sorted[j]]});
+                    uint64_t key = tableKey[s];
+                    int32_t c[3];
+                    for (int k = 0; k < 3; k++) {
+                        // 符号扩展还原21位坐标
+                        uint32_t v = uint32_t(key >> (k * COORD_BITS)) & mask;
+                        c[k] = int32_t(v << (32 - COORD_BITS)) >>
+                               (32 - COORD_BITS);
+                    }
+                    for (const auto& o : offsets) {
+                        uint32_t t = findSlot(
+                            keyOf(c[0] + o[0], c[1] + o[1], c[2] + o[2]));
+                        if (t == NULL_NEXT)
+                            continue;
+                        uint32_t tEnd = tableEnd[t];
+                        for (uint32_t i = begin; i < end; i++)
+                            for (uint32_t j = tEnd - tableCount[t]; j < tEnd;
+                                 j++)
+                                if (intersectTest(boxes[sorted[i]],
+                                                  boxes[sorted[j]]) >=
+                                    CollisionResult::intersect)
+                                    buf.push_back({&objects[sorted[i]],
+                                                   &objects[sorted[j]]});
+                    }
+                }
+            });
+        size_t total = 0;
+        for (const PairList& buf : buffers)
+            total += buf.size();
+        out.reserve(total);
+        for (const PairList& buf : buffers)
+            out.insert(out.end(), buf.begin(), buf.end());
+    }
+};
+}  // namespace BL::Math
+#endif  //!_BOUNDLESS_HASH_GRID_CXX_HPP_
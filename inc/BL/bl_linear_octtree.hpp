@@ -0,0 +1,645 @@
+#ifndef _BOUNDLESS_LINEAR_OCTTREE_CXX_HPP_
+#define _BOUNDLESS_LINEAR_OCTTREE_CXX_HPP_
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "bl_collision.hpp"
+#include "bl_parallel.hpp"
+namespace BL::Math {
+// 将v的低21位展开到每3位中的最低位
+constexpr uint64_t morton_spread3(uint64_t v) {
+    v &= 0x1FFFFF;
+    v = (v | (v << 32)) & 0x1F00000000FFFFull;
+    v = (v | (v << 16)) & 0x1F0000FF0000FFull;
+    v = (v | (v << 8)) & 0x100F00F00F00F00Full;
+    v = (v | (v << 4)) & 0x10C30C30C30C30C3ull;
+    v = (v | (v << 2)) & 0x1249249249249249ull;
+    return v;
+}
+// morton_spread3的逆运算
+constexpr uint32_t morton_compact3(uint64_t v) {
+    v &= 0x1249249249249249ull;
+    v = (v | (v >> 2)) & 0x10C30C30C30C30C3ull;
+    v = (v | (v >> 4)) & 0x100F00F00F00F00Full;
+    v = (v | (v >> 8)) & 0x1F0000FF0000FFull;
+    v = (v | (v >> 16)) & 0x1F00000000FFFFull;
+    v = (v | (v >> 32)) & 0x1FFFFF;
+    return uint32_t(v);
+}
+constexpr uint64_t morton_encode3(uint32_t x, uint32_t y, uint32_t z) {
+    return morton_spread3(x) | (morton_spread3(y) << 1) |
+           (morton_spread3(z) << 2);
+}
+// 无指针的松散八叉树: 对象按所在格子的Morton键排序存放, 节点为键的紧凑数组
+// 层l的格子为根的1/2^l, 松散范围向外扩展半个格子, 对象放在尺寸不超过格子的最深层
+// 键 = (格子Morton码补齐到LAYER_LIMIT层 << 5) | 层号, 子树中的键恰为一段连续区间
+// 修改先记录下来, 在commit时把新键排序后与原数组归并, 查询看到的是上次commit的状态
+template <typename T, std::floating_point Scalar>
+class LinearOctTree {
+   public:
+    using Box = AABB<Scalar>;
+    using Vec3 = vec3<Scalar>;
+    using IterateFunction = std::function<void(const Box&, T&)>;
+    static constexpr uint32_t NULL_NEXT = (~0u);
+    static constexpr uint32_t LAYER_LIMIT = 16;
+    struct Entry {
+        uint64_t key;
+        uint32_t handle;  // 已删除或换键的条目为NULL_NEXT, 下次commit时移除
+        Box objectBox;
+    };
+    struct LinearNode {
+        uint64_t key;
+        uint32_t begin, end;  // 在entries中的区间
+    };
+    // 与OctTree的同名类型对应, block字段为对象句柄
+    struct RayHit {
+        uint32_t block = NULL_NEXT;
+        Scalar t;
+    };
+    struct NearHit {
+        uint32_t block;
+        Scalar dist2;  // 到对象盒的距离的平方
+    };
+    using PairList = std::vector<std::pair<T*, T*>>;
+
+   private:
+    struct Object {
+        Box objectBox;
+        uint64_t key;
+        uint32_t slot;  // 在entries中的位置, 未提交时为NULL_NEXT
+        bool alive;
+        bool queued;  // 已在changed中
+        T data;
+    };
+    Box root;
+    std::array<Vec3, LAYER_LIMIT + 1> cellSize;
+    uint32_t nodeMaxData = 12, nodeMaxLayer = 8;
+    std::vector<Object> objects;  // 以句柄为下标
+    std::vector<uint32_t> freeHandles;
+    std::vector<Entry> entries, mergeTemp, pending;
+    std::vector<LinearNode> nodes;
+    std::vector<uint32_t> changed;
+
+    static constexpr uint64_t keyOf(uint64_t code, uint32_t layer) {
+        return (code << (3 * (LAYER_LIMIT - layer) + 5)) | layer;
+    }
+    uint64_t calculateKey(const Box& b) const {
+        Vec3 size = b.max() - b.min();
+        uint32_t layer = 0;
+        while (layer < nodeMaxLayer &&
+               (size.array() <= cellSize[layer + 1].array()).all())
+            layer++;
+        Vec3 cell = ((b.min() + b.max()) / Scalar(2) - root.min())
+                        .cwiseQuotient(cellSize[layer]);
+        uint32_t limit = (1u << layer) - 1;
+        uint32_t c[3];
+        for (int i = 0; i < 3; i++)
+            c[i] = std::min(uint32_t(std::max(cell[i], Scalar(0))), limit);
+        return keyOf(morton_encode3(c[0], c[1], c[2]), layer);
+    }
+    Vec3 cellMin(uint32_t layer, uint64_t code) const {
+        Vec3 c(Scalar(morton_compact3(code)),
+               Scalar(morton_compact3(code >> 1)),
+               Scalar(morton_compact3(code >> 2)));
+        return root.min() + c.cwiseProduct(cellSize[layer]);
+    }
+    // 最小角为lo的layer层格子的松散范围
+    Box looseBox(uint32_t layer, const Vec3& lo) const {
+        Vec3 half = cellSize[layer] / Scalar(2);
+        return {lo + cellSize[layer] + half, lo - half};
+    }
+    struct Cell {
+        uint32_t layer;
+        uint64_t code;                // 该层的格子Morton码
+        uint32_t nodeBegin, nodeEnd;  // 子树在nodes中的区间, 非空
+        uint32_t mask;                // cull中仍需测试的平面
+        uint32_t result;              // visit的返回值
+    };
+    struct KnnCell {
+        Cell cell;
+        Scalar dist2;  // 到格子松散范围的距离的平方
+    };
+
+   public:
+    // knn的格子队列, 由调用者持有并在多次查询间复用以避免分配
+    struct KnnScratch {
+        std::vector<KnnCell> cellQueue;
+    };
+
+   private:
+    // 同时包含键a, b(a <= b, 同属一段子树区间)的最深格子的层号
+    // 即两者补齐后Morton码的公共前缀, 且不深于a(区间中a的层数最小)
+    static uint32_t commonLayer(uint64_t a, uint64_t b) {
+        uint32_t common =
+            (std::countl_zero((a ^ b) >> 5) - (64 - 3 * LAYER_LIMIT)) / 3;
+        return std::min(uint32_t(a & 31), common);
+    }
+    static constexpr uint64_t codeOf(uint64_t key, uint32_t layer) {
+        return key >> (3 * (LAYER_LIMIT - layer) + 5);
+    }
+    // 包含nodes[nb, ne)的最深格子, 遍历直接跳到该格子
+    // 不逐层经过只有一个非空子格子的格子
+    Cell enclose(uint32_t nb, uint32_t ne, uint32_t mask) const {
+        uint32_t layer = commonLayer(nodes[nb].key, nodes[ne - 1].key);
+        return {layer, codeOf(nodes[nb].key, layer), nb, ne, mask, 0};
+    }
+    // 由entries建立节点数组: 对象数不超过nodeMaxData的子树合为一个节点,
+    // 其键为包含这些对象的最深格子; 否则格子自身的对象成为一个节点, 再处理各子格子
+    void buildNodes() {
+        nodes.clear();
+        if (entries.empty())
+            return;
+        std::array<std::pair<uint32_t, uint32_t>, 8 * LAYER_LIMIT + 1> stack;
+        uint32_t top = 0;
+        stack[top++] = {0, uint32_t(entries.size())};
+        auto it = entries.begin();
+        auto less = [](const Entry& e, uint64_t k) { return e.key < k; };
+        while (top > 0) {
+            auto [eb, ee] = stack[--top];
+            uint32_t layer = commonLayer(entries[eb].key, entries[ee - 1].key);
+            uint64_t code = codeOf(entries[eb].key, layer);
+            uint64_t own = keyOf(code, layer);
+            if (ee - eb <= nodeMaxData || layer == LAYER_LIMIT) {
+                nodes.push_back({own, eb, ee});
+                continue;
+            }
+            uint32_t b = eb;
+            while (b < ee && entries[b].key == own)
+                b++;
+            if (b > eb)
+                nodes.push_back({own, eb, b});
+            // 子格子逆序入栈, 使节点按键的顺序生成
+            for (uint32_t i = 8; i-- > 0 && b < ee;) {
+                uint32_t s = b;
+                if (i > 0)
+                    s = std::lower_bound(it + b, it + ee,
+                                         keyOf(code * 8 + i, layer + 1), less) -
+                        it;
+                if (s < ee)
+                    stack[top++] = {s, ee};
+                ee = s;
+            }
+        }
+    }
+    // 依次处理cur的非空子格子: accept(probe, loose)为真时以包含该子格子中节点的最深格子
+    // 调用emit(cell). nb为cur中排除其自身对象节点后的起始节点
+    // 先测试子格子的松散范围, 只为通过的子格子查找键区间
+    // 子格子i的键区间为[keyOf(8*code+i), keyOf(8*code+i+1)), 区间较短时顺序扫描,
+    // 否则二分查找
+    template <typename Accept, typename Emit>
+    void forChildren(const Cell& cur,
+                     uint32_t nb,
+                     Accept&& accept,
+                     Emit&& emit) const {
+        uint32_t ne = cur.nodeEnd;
+        if (nb == ne || cur.layer == LAYER_LIMIT)
+            return;
+        auto bound = [&](uint64_t k, uint32_t from) -> uint32_t {
+            if (ne - from <= 16) {
+                while (from < ne && nodes[from].key < k)
+                    from++;
+                return from;
+            }
+            return std::lower_bound(nodes.begin() + from, nodes.begin() + ne,
+                                    k,
+                                    [](const LinearNode& n, uint64_t k) {
+                                        return n.key < k;
+                                    }) -
+                   nodes.begin();
+        };
+        uint64_t code = cur.code;
+        uint32_t layer = cur.layer + 1;
+        Vec3 lo = cellMin(cur.layer, code);
+        for (uint32_t i = 0; i < 8 && nb < ne; i++) {
+            Vec3 offset(Scalar(i & 1), Scalar((i >> 1) & 1), Scalar(i >> 2));
+            Cell probe = {layer, code * 8 + i, nb, ne, cur.mask, 0};
+            Box loose =
+                looseBox(layer, lo + offset.cwiseProduct(cellSize[layer]));
+            if (!accept(probe, loose))
+                continue;
+            uint32_t b = bound(keyOf(code * 8 + i, layer), nb);
+            uint32_t e =
+                i < 7 ? bound(keyOf(code * 8 + i + 1, layer), b) : ne;
+            if (e > b)
+                emit(enclose(b, e, cur.mask));
+            nb = e;
+        }
+    }
+    // 前序遍历非空格子, visit(cell, loose)返回0跳过子树, 1展开, 2整棵子树命中
+    // 格子在入栈前测试, 对展开的格子调用local(cell, begin, end)处理其自身的对象
+    // 对整棵子树命中的格子调用whole(begin, end), 区间均为entries下标
+    template <typename Visit, typename Local, typename Whole>
+    void traverse(Visit&& visit, Local&& local, Whole&& whole) const {
+        if (nodes.empty())
+            return;
+        std::array<Cell, 8 * LAYER_LIMIT + 1> stack;
+        uint32_t top = 0;
+        auto push = [&](Cell c) {
+            c.result = visit(c, looseBox(c.layer, cellMin(c.layer, c.code)));
+            if (c.result != 0)
+                stack[top++] = c;
+        };
+        push(enclose(0, nodes.size(), 0x3F));
+        while (top > 0) {
+            Cell cur = stack[--top];
+            uint32_t nb = cur.nodeBegin;
+            if (cur.result == 2) {
+                whole(nodes[nb].begin, nodes[cur.nodeEnd - 1].end);
+                continue;
+            }
+            if (nodes[nb].key == keyOf(cur.code, cur.layer)) {
+                local(cur, nodes[nb].begin, nodes[nb].end);
+                nb++;
+            }
+            forChildren(
+                cur, nb,
+                [&](Cell& probe, const Box& loose) {
+                    return visit(probe, loose) != 0;
+                },
+                push);
+        }
+    }
+    static bool hitCloser(const RayHit& a, const RayHit& b) {
+        return a.t < b.t;
+    }
+    // hits为按t排列的大顶堆, 满k个后以堆顶收缩tMax, 之后的格子以新的tMax测试
+    void raycastInternal(const Vec3& o,
+                         const Vec3& d,
+                         Scalar tMax,
+                         uint32_t k,
+                         std::vector<RayHit>& hits) const {
+        if (k == 0)
+            return;
+        Vec3 invD = d.cwiseInverse();
+        Scalar t;
+        traverse(
+            [&](Cell&, const Box& loose) -> uint32_t {
+                return intersectRay(o, invD, loose, Scalar(0), tMax, &t) ? 1
+                                                                         : 0;
+            },
+            [&](const Cell&, uint32_t b, uint32_t e) {
+                for (uint32_t i = b; i < e; i++) {
+                    if (!intersectRay(o, invD, entries[i].objectBox,
+                                      Scalar(0), tMax, &t))
+                        continue;
+                    if (hits.size() == k) {
+                        std::pop_heap(hits.begin(), hits.end(), hitCloser);
+                        hits.pop_back();
+                    }
+                    hits.push_back({entries[i].handle, t});
+                    std::push_heap(hits.begin(), hits.end(), hitCloser);
+                    if (hits.size() == k)
+                        tMax = hits.front().t;
+                }
+            },
+            [](uint32_t, uint32_t) {});
+    }
+    // entries[i]与键不小于它的对象之间的相交对, 键更小的对象已在之前的条目中处理
+    // 只访问区间末尾在i之后的格子
+    void pairsOf(uint32_t i, PairList& out) {
+        const Box& box = entries[i].objectBox;
+        T* self = &objects[entries[i].handle].data;
+        traverse(
+            [&](Cell& cell, const Box& loose) -> uint32_t {
+                if (nodes[cell.nodeEnd - 1].end <= i + 1)
+                    return 0;
+                return intersectTest(box, loose) == CollisionResult::outer ? 0
+                                                                          : 1;
+            },
+            [&](const Cell&, uint32_t b, uint32_t e) {
+                for (uint32_t j = std::max(b, i + 1); j < e; j++)
+                    if (intersectTest(box, entries[j].objectBox) !=
+                        CollisionResult::outer)
+                        out.push_back(
+                            {self, &objects[entries[j].handle].data});
+            },
+            [](uint32_t, uint32_t) {});
+    }
+    void queue(uint32_t h) {
+        if (!objects[h].queued) {
+            objects[h].queued = true;
+            changed.push_back(h);
+        }
+    }
+
+   public:
+    void create(const Box& maxSize) {
+        root = maxSize;
+        cellSize[0] = maxSize.max() - maxSize.min();
+        for (uint32_t l = 1; l <= LAYER_LIMIT; l++)
+            cellSize[l] = cellSize[l - 1] / Scalar(2);
+        objects.clear();
+        freeHandles.clear();
+        entries.clear();
+        pending.clear();
+        nodes.clear();
+        changed.clear();
+    }
+    // 调整参数, nodeMaxLayer只影响此后commit时重新计算键的对象
+    // nodeMaxData在下次有修改的commit重建节点数组时生效
+    void setNodeMaxData(uint32_t n) { nodeMaxData = std::max(n, 1u); }
+    void setNodeMaxLayer(uint32_t n) {
+        nodeMaxLayer = std::min(n, LAYER_LIMIT);
+    }
+    uint32_t getNodeMaxData() const { return nodeMaxData; }
+    uint32_t getNodeMaxLayer() const { return nodeMaxLayer; }
+    T& data(uint32_t h) { return objects[h].data; }
+    const Box& box(uint32_t h) const { return objects[h].objectBox; }
+    const std::vector<Entry>& sortedEntries() const { return entries; }
+    const std::vector<LinearNode>& nodeList() const { return nodes; }
+    // 返回对象句柄, 对象不在根范围内时返回NULL_NEXT, 在commit后对查询可见
+    uint32_t insert(const Box& size) {
+        if (intersectTest(root, size) != CollisionResult::inner)
+            return NULL_NEXT;
+        uint32_t h;
+        if (freeHandles.empty()) {
+            h = objects.size();
+            objects.emplace_back();
+        } else {
+            h = freeHandles.back();
+            freeHandles.pop_back();
+        }
+        objects[h].objectBox = size;
+        objects[h].slot = NULL_NEXT;
+        objects[h].alive = true;
+        objects[h].queued = false;
+        queue(h);
+        return h;
+    }
+    // 在commit时移除, 句柄随后可被复用
+    void drop(uint32_t h) {
+        objects[h].alive = false;
+        queue(h);
+    }
+    void update(uint32_t h, const Box& size) {
+        if (intersectTest(root, size) != CollisionResult::inner)
+            throw std::out_of_range("Object moved out of the root range");
+        objects[h].objectBox = size;
+        queue(h);
+    }
+    void move(uint32_t h, const Vec3& dir) {
+        const Box& b = objects[h].objectBox;
+        update(h, {b.max() + dir, b.min() + dir});
+    }
+    // 应用insert/update/drop: 键不变的对象原地更新, 其余的新键排序后与原数组归并
+    void commit() {
+        std::vector<uint32_t> freed;
+        uint32_t removed = 0;
+        for (uint32_t h : changed) {
+            Object& obj = objects[h];
+            obj.queued = false;
+            if (!obj.alive) {
+                if (obj.slot != NULL_NEXT) {
+                    entries[obj.slot].handle = NULL_NEXT;
+                    removed++;
+                }
+                freed.push_back(h);
+                continue;
+            }
+            uint64_t key = calculateKey(obj.objectBox);
+            if (obj.slot != NULL_NEXT && key == obj.key) {
+                entries[obj.slot].objectBox = obj.objectBox;
+                continue;
+            }
+            if (obj.slot != NULL_NEXT) {
+                entries[obj.slot].handle = NULL_NEXT;
+                removed++;
+            }
+            obj.key = key;
+            pending.push_back({key, h, obj.objectBox});
+        }
+        changed.clear();
+        freeHandles.insert(freeHandles.end(), freed.begin(), freed.end());
+        if (pending.empty() && removed == 0)
+            return;
+        std::sort(pending.begin(), pending.end(),
+                  [](const Entry& a, const Entry& b) { return a.key < b.key; });
+        mergeTemp.clear();
+        mergeTemp.reserve(entries.size() - removed + pending.size());
+        auto a = entries.begin(), b = pending.begin();
+        while (a != entries.end() || b != pending.end()) {
+            if (a != entries.end() && a->handle == NULL_NEXT) {
+                ++a;
+            } else if (b == pending.end() ||
+                       (a != entries.end() && a->key <= b->key)) {
+                mergeTemp.push_back(*a++);
+            } else {
+                mergeTemp.push_back(*b++);
+            }
+        }
+        entries.swap(mergeTemp);
+        pending.clear();
+        for (uint32_t i = 0; i < entries.size(); i++)
+            objects[entries[i].handle].slot = i;
+        buildNodes();
+    }
+    // 以boxes[i], data[i]为对象重建, 返回插入的对象数
+    // handles非空时写入每个对象的句柄, 超出根范围的对象为NULL_NEXT
+    uint32_t build(std::span<const Box> boxes,
+                   std::span<T> data,
+                   std::span<uint32_t> handles = {}) {
+        create(root);
+        uint32_t n = 0;
+        for (size_t i = 0; i < boxes.size(); i++) {
+            uint32_t h = insert(boxes[i]);
+            if (!handles.empty())
+                handles[i] = h;
+            if (h == NULL_NEXT)
+                continue;
+            objects[h].data = std::move(data[i]);
+            n++;
+        }
+        commit();
+        return n;
+    }
+    template <typename Visitor>
+        requires std::invocable<Visitor&, const Box&, T&>
+    void find(const Box& size, Visitor&& fn) {
+        auto test = [&](const Cell&, uint32_t b, uint32_t e) {
+            for (uint32_t i = b; i < e; i++)
+                if (intersectTest(size, entries[i].objectBox) >=
+                    CollisionResult::intersect)
+                    fn(entries[i].objectBox, objects[entries[i].handle].data);
+        };
+        traverse(
+            [&](Cell&, const Box& loose) -> uint32_t {
+                CollisionResult r = intersectTest(size, loose);
+                return r == CollisionResult::outer   ? 0
+                       : r == CollisionResult::inner ? 2
+                                                     : 1;
+            },
+            test, [&](uint32_t b, uint32_t e) {
+                for (uint32_t i = b; i < e; i++)
+                    fn(entries[i].objectBox, objects[entries[i].handle].data);
+            });
+    }
+    void find(const Box& size, const IterateFunction& fn) {
+        find<const IterateFunction&>(size, fn);
+    }
+    // 视锥体剔除, 将与视锥体相交的对象的句柄追加到out
+    void cull(const std::array<Plane<Scalar>, 6>& planes,
+              std::vector<uint32_t>& out) const {
+        auto all = [&](uint32_t b, uint32_t e) {
+            for (uint32_t i = b; i < e; i++)
+                out.push_back(entries[i].handle);
+        };
+        traverse(
+            [&](Cell& cell, const Box& loose) -> uint32_t {
+                for (uint32_t m = cell.mask; m != 0; m &= m - 1) {
+                    uint32_t i = std::countr_zero(m);
+                    CollisionResult r = intersectTest(planes[i], loose);
+                    if (r == CollisionResult::outer)
+                        return 0;
+                    if (r == CollisionResult::inner)
+                        cell.mask &= ~(1u << i);
+                }
+                return cell.mask == 0 ? 2 : 1;
+            },
+            [&](const Cell& cell, uint32_t b, uint32_t e) {
+                for (uint32_t i = b; i < e; i++) {
+                    bool visible = true;
+                    for (uint32_t m = cell.mask; m != 0; m &= m - 1) {
+                        if (intersectTest(planes[std::countr_zero(m)],
+                                          entries[i].objectBox) ==
+                            CollisionResult::outer) {
+                            visible = false;
+                            break;
+                        }
+                    }
+                    if (visible)
+                        out.push_back(entries[i].handle);
+                }
+            },
+            all);
+    }
+    // 射线o+t*d(t在[0,tMax]内)与对象盒的最近交点, 未命中时hit.block为NULL_NEXT
+    RayHit raycast(const Vec3& o, const Vec3& d, Scalar tMax) const {
+        std::vector<RayHit> hits;
+        hits.reserve(1);
+        raycastInternal(o, d, tMax, 1, hits);
+        return hits.empty() ? RayHit{NULL_NEXT, tMax} : hits.front();
+    }
+    // 最近的k个交点, 按t由近及远写入hits, 返回命中数
+    uint32_t raycast(const Vec3& o,
+                     const Vec3& d,
+                     Scalar tMax,
+                     uint32_t k,
+                     std::vector<RayHit>& hits) const {
+        hits.clear();
+        raycastInternal(o, d, tMax, k, hits);
+        std::sort_heap(hits.begin(), hits.end(), hitCloser);
+        return hits.size();
+    }
+    // 距点p最近的k个对象, 按距离由近及远写入out, 返回个数
+    // 格子按到松散范围的距离最优先遍历, 与OctTree::knn相同
+    uint32_t knn(const Vec3& p,
+                 uint32_t k,
+                 std::vector<NearHit>& out,
+                 KnnScratch& scratch) const {
+        auto closer = [](const NearHit& a, const NearHit& b) {
+            return a.dist2 < b.dist2;
+        };
+        auto farther = [](const KnnCell& a, const KnnCell& b) {
+            return a.dist2 > b.dist2;
+        };
+        std::vector<KnnCell>& Q = scratch.cellQueue;
+        Q.clear();
+        out.clear();
+        if (k == 0 || nodes.empty())
+            return 0;
+        auto push = [&](const Cell& c) {
+            Scalar d2 =
+                distanceSquared(p, looseBox(c.layer, cellMin(c.layer, c.code)));
+            if (out.size() == k && d2 > out.front().dist2)
+                return;
+            Q.push_back({c, d2});
+            std::push_heap(Q.begin(), Q.end(), farther);
+        };
+        push(enclose(0, nodes.size(), 0));
+        while (!Q.empty()) {
+            std::pop_heap(Q.begin(), Q.end(), farther);
+            KnnCell e = Q.back();
+            Q.pop_back();
+            if (out.size() == k && e.dist2 > out.front().dist2)
+                break;
+            const Cell& cur = e.cell;
+            uint32_t nb = cur.nodeBegin;
+            if (nodes[nb].key == keyOf(cur.code, cur.layer)) {
+                for (uint32_t i = nodes[nb].begin; i < nodes[nb].end; i++) {
+                    Scalar d2 = distanceSquared(p, entries[i].objectBox);
+                    if (out.size() == k) {
+                        if (d2 >= out.front().dist2)
+                            continue;
+                        std::pop_heap(out.begin(), out.end(), closer);
+                        out.pop_back();
+                    }
+                    out.push_back({entries[i].handle, d2});
+                    std::push_heap(out.begin(), out.end(), closer);
+                }
+                nb++;
+            }
+            forChildren(
+                cur, nb,
+                [&](Cell&, const Box& loose) {
+                    return out.size() < k ||
+                           distanceSquared(p, loose) <= out.front().dist2;
+                },
+                push);
+        }
+        std::sort_heap(out.begin(), out.end(), closer);
+        return out.size();
+    }
+    std::vector<NearHit> knn(const Vec3& p, uint32_t k) const {
+        std::vector<NearHit> out;
+        KnnScratch scratch;
+        out.reserve(k);
+        knn(p, k, out, scratch);
+        return out;
+    }
+    // 收集全部相交(含接触)的对象对, 每对只出现一次
+    // 每个对象只与entries中排在其后的对象配对, 各对象分配到线程池中并行处理,
+    // 各线程写入自己的缓冲区后合并到out
+    void collectPairs(PairList& out) {
+        ThreadPool& pool = default_thread_pool();
+        std::vector<PairList> buffers(pool.size());
+        pool.parallel_for(entries.size(), 256,
+                          [&](uint32_t b, uint32_t e, uint32_t s) {
+                              for (uint32_t i = b; i < e; i++)
+                                  pairsOf(i, buffers[s]);
+                          });
+        out.clear();
+        size_t total = 0;
+        for (const PairList& buf : buffers)
+            total += buf.size();
+        out.reserve(total);
+        for (const PairList& buf : buffers)
+            out.insert(out.end(), buf.begin(), buf.end());
+    }
+    // 将与以p为心r为半径的球相交的对象的句柄追加到out
+    void radius(const Vec3& p, Scalar r, std::vector<uint32_t>& out) const {
+        Scalar r2 = r * r;
+        traverse(
+            [&](Cell&, const Box& loose) -> uint32_t {
+                return distanceSquared(p, loose) <= r2 ? 1 : 0;
+            },
+            [&](const Cell&, uint32_t b, uint32_t e) {
+                for (uint32_t i = b; i < e; i++)
+                    if (distanceSquared(p, entries[i].objectBox) <= r2)
+                        out.push_back(entries[i].handle);
+            },
+            [](uint32_t, uint32_t) {});
+    }
+    std::vector<uint32_t> radius(const Vec3& p, Scalar r) const {
+        std::vector<uint32_t> out;
+        radius(p, r, out);
+        return out;
+    }
+};
+}  // namespace BL::Math
+#endif  //!_BOUNDLESS_LINEAR_OCTTREE_CXX_HPP_
@@ -0,0 +1,293 @@
+#ifndef _BOUNDLESS_MESH_BOUNDS_CXX_HPP_
+#define _BOUNDLESS_MESH_BOUNDS_CXX_HPP_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "bl_collision.hpp"
+#include "bl_collision_batch.hpp"
+#include "bl_parallel.hpp"
+namespace BL::Math {
+// 顶点流中的位置: 每个顶点的前3个float为位置, 相邻顶点相距stride字节
+// data指向第一个顶点的位置, 即顶点数据加上位置属性的offset
+struct PointStream {
+    const uint8_t* data = nullptr;
+    uint32_t count = 0;
+    uint32_t stride = sizeof(float) * 3;
+    vec3<float> operator[](uint32_t i) const {
+        vec3<float> p;
+        std::memcpy(p.data(), data + size_t(i) * stride, sizeof(float) * 3);
+        return p;
+    }
+};
+// 每段顶点数, 顶点数超过该值时分配到线程池中并行计算
+constexpr uint32_t BOUNDS_GRAIN = 16384;
+
+// 将[b, e)内的顶点合并到lo/hi中
+inline void bounds_minmax_scalar(const PointStream& s,
+                                 uint32_t b,
+                                 uint32_t e,
+                                 vec3<float>& lo,
+                                 vec3<float>& hi) {
+    for (uint32_t i = b; i < e; i++) {
+        vec3<float> p = s[i];
+        lo = lo.cwiseMin(p);
+        hi = hi.cwiseMax(p);
+    }
+}
+#if defined(BL_MATH_SIMD_DISPATCH)
+BL_TARGET_SSE41 inline void bounds_minmax_sse41(const PointStream& s,
+                                                uint32_t b,
+                                                uint32_t e,
+                                                vec3<float>& lo,
+                                                vec3<float>& hi) {
+    // 每次读取16字节, 第4个分量为下一个属性(结果中忽略)
+    // 最后一个顶点之后可能没有数据, 由标量处理
+    uint32_t safe = std::min(e, s.count - 1);
+    __m128 mn = _mm_setr_ps(lo.x(), lo.y(), lo.z(), 0);
+    __m128 mx = _mm_setr_ps(hi.x(), hi.y(), hi.z(), 0);
+    const uint8_t* p = s.data + size_t(b) * s.stride;
+    for (uint32_t i = b; i < safe; i++, p += s.stride) {
+        __m128 v = _mm_loadu_ps(reinterpret_cast<const float*>(p));
+        mn = _mm_min_ps(mn, v);
+        mx = _mm_max_ps(mx, v);
+    }
+    alignas(16) float t[4];
+    _mm_store_ps(t, mn);
+    lo = {t[0], t[1], t[2]};
+    _mm_store_ps(t, mx);
+    hi = {t[0], t[1], t[2]};
+    bounds_minmax_scalar(s, std::max(b, safe), e, lo, hi);
+}
+BL_TARGET_AVX2 inline void bounds_minmax_avx2(const PointStream& s,
+                                              uint32_t b,
+                                              uint32_t e,
+                                              vec3<float>& lo,
+                                              vec3<float>& hi) {
+    // 每次处理两个顶点, 分别位于高低128位
+    uint32_t safe = std::min(e, s.count - 1);
+    __m256 mn = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256 mx = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    const uint8_t* p = s.data + size_t(b) * s.stride;
+    uint32_t i = b;
+    for (; i + 2 <= safe; i += 2, p += 2 * s.stride) {
+        __m256 v = _mm256_loadu2_m128(
+            reinterpret_cast<const float*>(p + s.stride),
+            reinterpret_cast<const float*>(p));
+        mn = _mm256_min_ps(mn, v);
+        mx = _mm256_max_ps(mx, v);
+    }
+    __m128 mn4 = _mm_min_ps(_mm256_castps256_ps128(mn),
+                            _mm256_extractf128_ps(mn, 1));
+    __m128 mx4 = _mm_max_ps(_mm256_castps256_ps128(mx),
+                            _mm256_extractf128_ps(mx, 1));
+    alignas(16) float t[4];
+    _mm_store_ps(t, mn4);
+    lo = lo.cwiseMin(vec3<float>(t[0], t[1], t[2]));
+    _mm_store_ps(t, mx4);
+    hi = hi.cwiseMax(vec3<float>(t[0], t[1], t[2]));
+    bounds_minmax_scalar(s, i, e, lo, hi);
+}
+#endif
+inline void bounds_minmax(const PointStream& s,
+                          uint32_t b,
+                          uint32_t e,
+                          vec3<float>& lo,
+                          vec3<float>& hi) {
+#if defined(BL_MATH_SIMD_DISPATCH)
+    if (simd_level() == SimdLevel::avx2)
+        return bounds_minmax_avx2(s, b, e, lo, hi);
+    if (simd_level() >= SimdLevel::sse41)
+        return bounds_minmax_sse41(s, b, e, lo, hi);
+#endif
+    bounds_minmax_scalar(s, b, e, lo, hi);
+}
+
+// 顶点的AABB, 无顶点时为空盒(min > max)
+inline AABB<float> computeAABB(const PointStream& s) {
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    ThreadPool& pool = default_thread_pool();
+    std::vector<AABB<float>> part(
+        pool.size(), {vec3<float>::Constant(-inf), vec3<float>::Constant(inf)});
+    pool.parallel_for(s.count, BOUNDS_GRAIN,
+                      [&](uint32_t b, uint32_t e, uint32_t slot) {
+                          bounds_minmax(s, b, e, part[slot].min(),
+                                        part[slot].max());
+                      });
+    AABB<float> r = part[0];
+    for (const AABB<float>& p : part) {
+        r.min() = r.min().cwiseMin(p.min());
+        r.max() = r.max().cwiseMax(p.max());
+    }
+    return r;
+}
+
+// 包含a与b的最小球
+inline Sphere<float> sphere_merge(const Sphere<float>& a,
+                                  const Sphere<float>& b) {
+    vec3<float> d = b.c() - a.c();
+    float dist = d.norm();
+    if (dist + b.r() <= a.r())
+        return a;
+    if (dist + a.r() <= b.r())
+        return b;
+    float r = (dist + a.r() + b.r()) / 2;
+    return {a.c() + d * ((r - a.r()) / dist), r};
+}
+// Ritter的扩张: 逐个将球外的点包含进来
+inline void sphere_grow(const PointStream& s,
+                        uint32_t b,
+                        uint32_t e,
+                        Sphere<float>& sp) {
+    float r2 = sp._r * sp._r;
+    for (uint32_t i = b; i < e; i++) {
+        vec3<float> p = s[i];
+        vec3<float> d = p - sp._c;
+        float d2 = d.squaredNorm();
+        if (d2 <= r2)
+            continue;
+        float dist = std::sqrt(d2);
+        float r = (sp._r + dist) / 2;
+        sp._c += d * ((r - sp._r) / dist);
+        sp._r = r;
+        r2 = r * r;
+    }
+}
+// EPOS-14(Larsson)求初始球: 取7个固定方向上的14个极值点中相距最远的一对,
+// 再以Ritter的方法扩张到包含所有顶点, 结果通常比最小包围球大几个百分点
+// 扩张按段并行, 各段结果再合并, 因此与顶点顺序和线程数略有关
+inline Sphere<float> computeBoundingSphere(const PointStream& s) {
+    if (s.count == 0)
+        return {vec3<float>::Zero(), 0};
+    static const vec3<float> DIR[7] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1},
+                                       {1, 1, 1}, {1, 1, -1}, {1, -1, 1},
+                                       {1, -1, -1}};
+    struct Extreme {
+        std::array<float, 7> lo, hi;
+        std::array<uint32_t, 7> loIdx, hiIdx;
+    };
+    ThreadPool& pool = default_thread_pool();
+    std::vector<Extreme> part(pool.size());
+    for (Extreme& x : part) {
+        x.lo.fill(std::numeric_limits<float>::infinity());
+        x.hi.fill(-std::numeric_limits<float>::infinity());
+        x.loIdx.fill(0);
+        x.hiIdx.fill(0);
+    }
+    pool.parallel_for(s.count, BOUNDS_GRAIN,
+                      [&](uint32_t b, uint32_t e, uint32_t slot) {
+                          Extreme& x = part[slot];
+                          for (uint32_t i = b; i < e; i++) {
+                              vec3<float> p = s[i];
+                              for (uint32_t k = 0; k < 7; k++) {
+                                  float t = p.dot(DIR[k]);
+                                  if (t < x.lo[k])
+                                      x.lo[k] = t, x.loIdx[k] = i;
+                                  if (t > x.hi[k])
+                                      x.hi[k] = t, x.hiIdx[k] = i;
+                              }
+                          }
+                      });
+    Extreme x = part[0];
+    for (const Extreme& y : part) {
+        for (uint32_t k = 0; k < 7; k++) {
+            if (y.lo[k] < x.lo[k])
+                x.lo[k] = y.lo[k], x.loIdx[k] = y.loIdx[k];
+            if (y.hi[k] > x.hi[k])
+                x.hi[k] = y.hi[k], x.hiIdx[k] = y.hiIdx[k];
+        }
+    }
+    uint32_t far = 0;
+    float best = -1;
+    for (uint32_t k = 0; k < 7; k++) {
+        float d2 = (s[x.hiIdx[k]] - s[x.loIdx[k]]).squaredNorm();
+        if (d2 > best)
+            best = d2, far = k;
+    }
+    vec3<float> a = s[x.loIdx[far]], b = s[x.hiIdx[far]];
+    Sphere<float> init = {(a + b) / 2, std::sqrt(best) / 2};
+    std::vector<Sphere<float>> grown(pool.size(), init);
+    pool.parallel_for(s.count, BOUNDS_GRAIN,
+                      [&](uint32_t b, uint32_t e, uint32_t slot) {
+                          sphere_grow(s, b, e, grown[slot]);
+                      });
+    Sphere<float> r = grown[0];
+    for (const Sphere<float>& g : grown)
+        r = sphere_merge(r, g);
+    // 补偿扩张时的舍入误差, 保证所有顶点都在球内
+    r._r *= 1 + std::numeric_limits<float>::epsilon() * 16;
+    return r;
+}
+
+// 以顶点坐标协方差矩阵的特征向量(PCA)为轴的OBB
+// u为方差最大的方向, w = u x v; 顶点共面或共线时轴仍正交, 对应半长为0
+inline OBB<float> computeOBB(const PointStream& s) {
+    OBB<float> r;
+    r._c.setZero();
+    r._u = vec3<float>::UnitX();
+    r._v = vec3<float>::UnitY();
+    r._h.setZero();
+    if (s.count == 0)
+        return r;
+    ThreadPool& pool = default_thread_pool();
+    // 以double累加一阶与二阶矩, 避免大量顶点时丢失精度
+    struct Moment {
+        vec3<double> sum = vec3<double>::Zero();
+        Eigen::Matrix3d outer = Eigen::Matrix3d::Zero();
+    };
+    std::vector<Moment> part(pool.size());
+    pool.parallel_for(s.count, BOUNDS_GRAIN,
+                      [&](uint32_t b, uint32_t e, uint32_t slot) {
+                          Moment& m = part[slot];
+                          for (uint32_t i = b; i < e; i++) {
+                              vec3<double> p = s[i].cast<double>();
+                              m.sum += p;
+                              m.outer += p * p.transpose();
+                          }
+                      });
+    Moment m;
+    for (const Moment& p : part) {
+        m.sum += p.sum;
+        m.outer += p.outer;
+    }
+    vec3<double> mean = m.sum / s.count;
+    Eigen::Matrix3d cov = m.outer / s.count - mean * mean.transpose();
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(cov);
+    // 特征值升序排列
+    vec3<float> u = solver.eigenvectors().col(2).cast<float>().normalized();
+    vec3<float> v = solver.eigenvectors().col(1).cast<float>();
+    v = (v - u * u.dot(v)).normalized();
+    vec3<float> w = u.cross(v);
+    // 顶点在三个轴上投影的范围
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    std::vector<AABB<float>> range(
+        pool.size(), {vec3<float>::Constant(-inf), vec3<float>::Constant(inf)});
+    pool.parallel_for(s.count, BOUNDS_GRAIN,
+                      [&](uint32_t b, uint32_t e, uint32_t slot) {
+                          vec3<float> lo = range[slot].min();
+                          vec3<float> hi = range[slot].max();
+                          for (uint32_t i = b; i < e; i++) {
+                              vec3<float> p = s[i];
+                              vec3<float> t(p.dot(u), p.dot(v), p.dot(w));
+                              lo = lo.cwiseMin(t);
+                              hi = hi.cwiseMax(t);
+                          }
+                          range[slot] = {hi, lo};
+                      });
+    vec3<float> lo = range[0].min(), hi = range[0].max();
+    for (const AABB<float>& p : range) {
+        lo = lo.cwiseMin(p.min());
+        hi = hi.cwiseMax(p.max());
+    }
+    vec3<float> mid = (lo + hi) / 2;
+    r._c = u * mid.x() + v * mid.y() + w * mid.z();
+    r._u = u;
+    r._v = v;
+    r._h = (hi - lo) / 2;
+    return r;
+}
+}  // namespace BL::Math
+#endif  //!_BOUNDLESS_MESH_BOUNDS_CXX_HPP_
@@ -2,12 +2,33 @@
 #define _BOUNDLESS_OCTTREE_CXX_HPP_
 #include <concepts>
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <functional>
-#include <queue>
-#include <stack>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include "bl_bin_file.hpp"
 #include "bl_collision.hpp"
 #include "bl_log.hpp"
+#include "bl_parallel.hpp"
+// 定义BL_OCTTREE_STATS以统计查询计数并启用dumpStats, 未定义时不产生任何开销
+#ifdef BL_OCTTREE_STATS
+#include "bl_JSON.hpp"
+#define BL_OCTTREE_STAT(counter, n) \
+    queryCounters.counter.fetch_add(n, std::memory_order_relaxed)
+#else
+// sizeof不求值n, 只避免未使用变量的警告
+#define BL_OCTTREE_STAT(counter, n) ((void)sizeof(n))
+#endif
 namespace BL::Math {
 enum struct OctPos {
     I = 0x1,
@@ -32,7 +53,7 @@ constexpr uint32_t to_parent_list_index(uint32_t a) {
     return (a - 1) / 8 + 1;
 }
 constexpr uint32_t to_first_index_of_group(uint32_t a) {
-    return (a - 1) & (~0b111) + 1;
+    return ((a - 1) & (~0b111u)) + 1;
 }
 template <typename T, std::floating_point Scalar>
 class OctTree {
@@ -40,10 +61,19 @@ class OctTree {
     using Box = AABB<Scalar>;
     using Vec3 = vec3<Scalar>;
     using IterateFunction = std::function<void(const Box&, T&)>;
-    const uint32_t NULL_NEXT = (~0);
-    const Scalar K = static_cast<Scalar>(1.5);
+    using PairList = std::vector<std::pair<T*, T*>>;
+    static constexpr uint32_t NULL_NEXT = (~0u);
+    static constexpr Scalar K = static_cast<Scalar>(1.5);
+    // nodeMaxLayer的上限, 决定遍历栈与建树路径键的大小
+    static constexpr uint32_t LAYER_LIMIT = 16;
+    // 数据块按块(chunk)分配, 每块 1 << BLOCK_CHUNK_SHIFT 个
+    static constexpr uint32_t BLOCK_CHUNK_SHIFT = 10;
+    static constexpr uint32_t BLOCK_CHUNK_SIZE = 1u << BLOCK_CHUNK_SHIFT;
+    static constexpr uint32_t BLOCK_CHUNK_MASK = BLOCK_CHUNK_SIZE - 1;
     struct DataBlock {
-        DataBlock* next;
+        uint32_t next;  // 链表中下一个块的索引, 空闲时指向下一个空闲块
+        uint32_t prev;  // 链表中上一个块的索引, 为HEAD时为NULL_NEXT
+        uint32_t node;  // 所在节点, 节点分裂时随之更新
         Box objectBox;
         T data;
     };
@@ -51,45 +81,59 @@ class OctTree {
         Box sizeBox;
         Box extendBox;
         uint32_t next = NULL_NEXT;
-        DataBlock* dataHead = nullptr;
+        uint32_t dataHead = NULL_NEXT;
         uint32_t count = 0;
-        void insert(DataBlock* n) {
-            n->next = dataHead;
-            dataHead = n;
-            count++;
-        }
-        // 找到数据节点n的前一个节点,为HEAD时返回空指针
-        DataBlock* find_pre(DataBlock* n) const {
-            DataBlock *p = dataHead, *q = nullptr;
-            while (p != n && p != nullptr) {
-                q = p;
-                p = p->next;
-            }
-            return q;
-        }
-        void drop(DataBlock* n) {
-            DataBlock* pre = find_pre(n);
-            if (pre == nullptr) {
-                dataHead = dataHead->next;
-            } else {
-                pre->next = n->next;
-            }
-            count--;
-        }
-        void iterateData(const IterateFunction& fn) {
-            DataBlock* p = dataHead;
-            while (p != nullptr) {
-                fn(p->objectBox, p->data);
-                p = p->next;
-            }
-        }
+    };
+    struct RayHit {
+        uint32_t block = NULL_NEXT;
+        Scalar t;
+    };
+    struct NearHit {
+        uint32_t block;
+        Scalar dist2;  // 到对象盒的距离的平方
+    };
+    // knn的节点队列, 由调用者持有并在多次查询间复用以避免分配
+    struct KnnScratch {
+        std::vector<NearHit> nodeQueue;  // block字段存节点序号
+    };
+    // 一组8个子节点的盒, 以SoA存储供intersectTest8使用
+    struct OctGroup {
+        AABB8<Scalar> size;
+        AABB8<Scalar> extend;
+    };
+    // 查询计数: 访问的节点数, 测试的盒数(对象盒与子节点盒), 命中的对象数
+    struct QueryStats {
+        uint64_t nodesVisited = 0;
+        uint64_t boxesTested = 0;
+        uint64_t hits = 0;
     };
 
    private:
-    std::stack<uint32_t> freeList;
+    std::vector<uint32_t> freeList;  // 回收的节点组, 作为栈使用
     std::vector<uint32_t> parentList;
+    std::vector<OctGroup> groupList;  // 与parentList下标相同
     std::vector<OctNode> nodeList;
     uint32_t nodeMaxData = 12, nodeMaxLayer = 8;
+    // DataBlock池: 块地址固定不变, 空闲块通过next组成侵入式链表
+    std::vector<std::unique_ptr<DataBlock[]>> blockChunks;
+    uint32_t blockFreeHead = NULL_NEXT;
+    uint32_t blockUsed = 0;  // 曾分配过的块数
+    struct PendingMove {
+        uint32_t block;
+        Vec3 delta;
+    };
+    std::vector<PendingMove> moveQueue;
+    std::vector<std::pair<uint32_t, uint32_t>> moveRelink;  // (起始节点, 块)
+    std::vector<uint32_t> moveSources;
+    std::vector<uint32_t> moveRejected;
+    std::vector<Box> moveFrom;  // 各移动应用前的盒, 用于撤销被拒绝的移动
+#ifdef BL_OCTTREE_STATS
+    struct {
+        std::atomic<uint64_t> nodesVisited = 0;
+        std::atomic<uint64_t> boxesTested = 0;
+        std::atomic<uint64_t> hits = 0;
+    } mutable queryCounters;
+#endif
 
     enum struct FitPosition {
         Self = -1,
@@ -100,23 +144,54 @@ class OctTree {
         V = 4,
         VI = 5,
         VII = 6,
-        VIII = 7,
-        None = -2
+        VIII = 7
     };
-    FitPosition calculateOctNodeFit(uint32_t node, const Box& b) {
-        CollisionResult res = intersectTest(nodeList[node].sizeBox, b);
-        if (res < CollisionResult::inner) {
-            return FitPosition::None;
+    uint32_t allocBlock() {
+        uint32_t r;
+        if (blockFreeHead != NULL_NEXT) {
+            r = blockFreeHead;
+            blockFreeHead = block(r).next;
         } else {
-            uint32_t base = nodeList[node].next;
-            for (uint32_t i = 0; i < 8; i++) {
-                if (intersectTest(nodeList[base + i].sizeBox, b) ==
-                    CollisionResult::inner) {
-                    return static_cast<FitPosition>(i);
-                }
-            }
-            return FitPosition::Self;
+            if ((blockUsed >> BLOCK_CHUNK_SHIFT) == blockChunks.size())
+                blockChunks.emplace_back(new DataBlock[BLOCK_CHUNK_SIZE]);
+            r = blockUsed++;
         }
+        block(r).next = NULL_NEXT;
+        return r;
+    }
+    void freeBlock(uint32_t b) {
+        block(b).data = T();
+        block(b).next = blockFreeHead;
+        blockFreeHead = b;
+    }
+    void linkBlock(uint32_t node, uint32_t b) {
+        uint32_t head = nodeList[node].dataHead;
+        block(b).next = head;
+        block(b).prev = NULL_NEXT;
+        block(b).node = node;
+        if (head != NULL_NEXT)
+            block(head).prev = b;
+        nodeList[node].dataHead = b;
+        nodeList[node].count++;
+    }
+    // 将b从所在节点的链表中取下, 不回收节点
+    void unlinkBlock(uint32_t b) {
+        DataBlock& cur = block(b);
+        if (cur.prev == NULL_NEXT)
+            nodeList[cur.node].dataHead = cur.next;
+        else
+            block(cur.prev).next = cur.next;
+        if (cur.next != NULL_NEXT)
+            block(cur.next).prev = cur.prev;
+        nodeList[cur.node].count--;
+    }
+    FitPosition calculateOctNodeFit(uint32_t node, const Box& b) {
+        uint32_t base = nodeList[node].next;
+        const OctGroup& g = groupList[to_parent_list_index(base)];
+        uint32_t inner = intersectTest8(g.size, b) >> 8;
+        if (inner == 0)
+            return FitPosition::Self;
+        return static_cast<FitPosition>(std::countr_zero(inner));
     }
     uint32_t insertOctNodeNext(uint32_t p) {
         uint32_t r;
@@ -124,11 +199,23 @@ class OctTree {
             r = nodeList.size();
             nodeList.resize(r + 8);
             parentList.push_back(p);
+            groupList.emplace_back();
         } else {
-            r = freeList.top();
-            freeList.pop();
+            r = freeList.back();
+            freeList.pop_back();
             parentList[to_parent_list_index(r)] = p;
+            // 包围盒随后重新计算, 只需重置链接与计数
+            for (uint32_t i = 0; i < 8; i++) {
+                OctNode& n = nodeList[r + i];
+                n.next = n.dataHead = NULL_NEXT;
+                n.count = 0;
+            }
         }
+        splitOctNode(p, r);
+        return r;
+    }
+    // 以节点组r作为p的下层节点, 计算8个子节点的包围盒
+    void splitOctNode(uint32_t p, uint32_t r) {
         nodeList[p].next = r;
         Vec3 max = nodeList[p].sizeBox.max();
         Vec3 min = nodeList[p].sizeBox.min();
@@ -173,196 +260,1117 @@ class OctTree {
                                    Vec3(center.x(), min.y(), min.z())};
         nodeList[r + 7].extendBox = {Vec3(p8.x(), c.y(), c.z()),
                                      Vec3(c.x(), p8.y(), p8.z())};
-        return r;
+        OctGroup& g = groupList[to_parent_list_index(r)];
+        for (uint32_t i = 0; i < 8; i++) {
+            g.size.set(i, nodeList[r + i].sizeBox);
+            g.extend.set(i, nodeList[r + i].extendBox);
+        }
     }
-    // 节点p必须保证没有下层节点, 将node插入到p或p的下层节点中
-    FitPosition expendOctNodeNext(uint32_t p, DataBlock* node) {
+    // 节点p必须保证没有下层节点, 将块b插入到p或p的下层节点中, 返回所在节点
+    uint32_t expendOctNodeNext(uint32_t p, uint32_t b) {
         if (nodeList[p].count < nodeMaxData) {
-            nodeList[p].insert(node);
-            return FitPosition::Self;
-        } else {
-            uint32_t next = insertOctNodeNext(p);
-            DataBlock *cur = nodeList[p].dataHead, *pre = nullptr;
-            while (cur != nullptr) {
-                FitPosition fpt = calculateOctNodeFit(p, cur->objectBox);
-                if (fpt == FitPosition::Self)
-                    pre = cur, cur = cur->next;
-                else {
-                    if (pre == nullptr)
-                        nodeList[p].dataHead = cur->next;
-                    else
-                        pre->next = cur->next;
-                    nodeList[nodeList[p].next + static_cast<uint32_t>(fpt)]
-                        .insert(cur);
-                    cur = pre->next;
-                }
-            }
-            FitPosition fpt = calculateOctNodeFit(p, node->objectBox);
-            if (fpt == FitPosition::Self) {
-                nodeList[p].insert(node);
-            } else {
-                nodeList[nodeList[p].next + static_cast<uint32_t>(fpt)].insert(
-                    node);
+            linkBlock(p, b);
+            return p;
+        }
+        uint32_t next = insertOctNodeNext(p);
+        uint32_t cur = nodeList[p].dataHead;
+        while (cur != NULL_NEXT) {
+            uint32_t curNext = block(cur).next;
+            FitPosition fpt = calculateOctNodeFit(p, block(cur).objectBox);
+            if (fpt != FitPosition::Self) {
+                unlinkBlock(cur);
+                linkBlock(next + static_cast<uint32_t>(fpt), cur);
             }
-            return fpt;
+            cur = curNext;
         }
+        FitPosition fpt = calculateOctNodeFit(p, block(b).objectBox);
+        uint32_t at =
+            fpt == FitPosition::Self ? p : next + static_cast<uint32_t>(fpt);
+        linkBlock(at, b);
+        return at;
+    }
+    // 节点所在的组是否仍挂在父节点上(组可能已被回收)
+    bool isLiveNode(uint32_t n) const {
+        return n == 0 || nodeList[parentList[to_parent_list_index(n)]].next ==
+                             to_first_index_of_group(n);
     }
     uint32_t deleteNode(uint32_t del) {
         if (nodeList[del].count > 0 || nodeList[del].next != NULL_NEXT)
             return del;
         uint32_t p = parentList[to_parent_list_index(del)];
+        uint32_t base = nodeList[p].next;
         for (uint32_t i = 0; i < 8; i++)
-            if (nodeList[nodeList[p].next + i].next != NULL_NEXT)
+            if (nodeList[base + i].count > 0 ||
+                nodeList[base + i].next != NULL_NEXT)
                 return del;
         nodeList[p].next = NULL_NEXT;
-        freeList.push(to_first_index_of_group(del));
+        freeList.push_back(base);
         if (p != 0)
             return deleteNode(p);
         return 0;
     }
-    void drop_internal(DataBlock* block, uint32_t belongTo) {
-        DataBlock* pre = nodeList[belongTo].find_pre(block);
-        if (pre->next != block)
-            return;
-        if (pre == nullptr)
-            nodeList[belongTo].dataHead = cur->next;
-        else
-            pre->next = cur->next;
-        nodeList[belongTo].count--;
+    uint32_t layerOf(uint32_t node) const {
+        uint32_t c = 1;
+        while (node != 0) {
+            node = parentList[to_parent_list_index(node)];
+            c++;
+        }
+        return c;
     }
-    uint32_t insertBeginAt(DataBlock* block, uint32_t beginAt) {
-        uint32_t c = 1, p = beginAt;
+    uint32_t insertBeginAt(uint32_t b, uint32_t beginAt) {
+        uint32_t c = layerOf(beginAt), p = beginAt;
         while (true) {
             if (c >= nodeMaxLayer) {
-                nodeList[p].insert(block);
-                nodeList[p].count++;
+                linkBlock(p, b);
                 return p;
             } else if (nodeList[p].next != NULL_NEXT) {
-                FitPosition fp = calculateOctNodeFit(p, block->objectBox);
+                FitPosition fp = calculateOctNodeFit(p, block(b).objectBox);
                 if (fp == FitPosition::Self) {
-                    nodeList[p].insert(block);
-                    nodeList[p].count++;
+                    linkBlock(p, b);
                     return p;
-                } else {
-                    p = nodeList[p].next + static_cast<uint32_t>(fp), c++;
                 }
+                p = nodeList[p].next + static_cast<uint32_t>(fp), c++;
             } else {
-                FitPosition fp = expendOctNodeNext(p, block);
-                uint32_t inc_pos =
-                    FitPosition::Self
-                        ? p
-                        : nodeList[p].next + static_cast<uint32_t>(fp);
-                nodeList[inc_pos].count++;
-                return inc_pos;
+                return expendOctNodeNext(p, b);
             }
         }
     }
+    struct BuildItem {
+        uint64_t key;
+        uint32_t index;
+    };
+    struct BuildRun {
+        uint32_t node, begin, end;
+    };
+    // 并行建立的子树, groupBase为其节点组的起始下标
+    struct BuildTask {
+        uint32_t node, layer, begin, end, groupBase;
+    };
+    // 路径键每层占4位(从高位开始), 值为子节点序号+1, 0表示停在该层
+    static constexpr uint32_t buildKeyShift(uint32_t layer) {
+        return 64 - 4 * layer;
+    }
+    // 计算逐个插入时b会沿之下降的子节点路径, 与insertOctNodeNext的划分一致
+    uint64_t buildPathKey(const Box& b, uint32_t maxLayer) const {
+        // 子节点序号, 按[x高][y高][z高]索引
+        static constexpr uint8_t childOf[2][2][2] = {{{6, 2}, {5, 1}},
+                                                     {{7, 3}, {4, 0}}};
+        Vec3 hi = nodeList[0].sizeBox.max(), lo = nodeList[0].sizeBox.min();
+        uint64_t key = 0;
+        for (uint32_t layer = 1; layer < maxLayer; layer++) {
+            uint32_t side[3];
+            for (uint32_t k = 0; k < 3; k++) {
+                Scalar c = (hi[k] + lo[k]) / static_cast<Scalar>(2.0);
+                if (c < b.min()[k] && hi[k] > b.max()[k])
+                    side[k] = 1, lo[k] = c;
+                else if (lo[k] < b.min()[k] && c > b.max()[k])
+                    side[k] = 0, hi[k] = c;
+                else
+                    return key;
+            }
+            uint64_t digit = childOf[side[0]][side[1]][side[2]] + 1;
+            key |= digit << buildKeyShift(layer);
+        }
+        return key;
+    }
+    // 按键的高位字节进行LSD基数排序, 每趟各线程先统计再分散
+    void buildSortItems(std::vector<BuildItem>& items, uint32_t keyBits) {
+        ThreadPool& pool = default_thread_pool();
+        std::vector<BuildItem> temp(items.size());
+        uint32_t n = items.size(), slots = pool.size();
+        std::vector<uint32_t> hist(slots * 256);
+        for (uint32_t shift = 64 - ((keyBits + 7) / 8) * 8; shift < 64;
+             shift += 8) {
+            std::fill(hist.begin(), hist.end(), 0u);
+            pool.parallel_for(n, 4096, [&](uint32_t b, uint32_t e, uint32_t s) {
+                for (uint32_t i = b; i < e; i++)
+                    hist[s * 256 + ((items[i].key >> shift) & 0xFF)]++;
+            });
+            uint32_t sum = 0;
+            for (uint32_t d = 0; d < 256; d++) {
+                for (uint32_t s = 0; s < slots; s++) {
+                    uint32_t c = hist[s * 256 + d];
+                    hist[s * 256 + d] = sum;
+                    sum += c;
+                }
+            }
+            pool.parallel_for(n, 4096, [&](uint32_t b, uint32_t e, uint32_t s) {
+                uint32_t* h = &hist[s * 256];
+                for (uint32_t i = b; i < e; i++)
+                    temp[h[(items[i].key >> shift) & 0xFF]++] = items[i];
+            });
+            items.swap(temp);
+        }
+    }
+    static bool hitCloser(const RayHit& a, const RayHit& b) {
+        return a.t < b.t;
+    }
+    // 由近及远遍历, hits为按t排列的大顶堆, 满k个后以堆顶收缩tMax
+    // Swept为true时所有盒先以grow扩张, 即求半长为grow的盒扫过时的接触
+    template <bool Swept = false>
+    void raycastInternal(const Vec3& o,
+                         const Vec3& d,
+                         Scalar tMax,
+                         uint32_t k,
+                         std::vector<RayHit>& hits,
+                         const Vec3& grow = Vec3::Zero()) const {
+        struct Entry {
+            uint32_t node;
+            Scalar t;
+        };
+        auto grown = [&](const Box& b) -> decltype(auto) {
+            if constexpr (Swept)
+                return Box{b.max() + grow, b.min() - grow};
+            else
+                return (b);
+        };
+        Vec3 invD = d.cwiseInverse();
+        Scalar t;
+        if (k == 0 || !intersectRay(o, invD, grown(nodeList[0].extendBox),
+                                    Scalar(0), tMax, &t))
+            return;
+        std::array<Entry, 8 * LAYER_LIMIT> stack;
+        uint32_t top = 0;
+        stack[top++] = {0, t};
+        while (top > 0) {
+            Entry e = stack[--top];
+            if (e.t > tMax)
+                continue;
+            const OctNode& cur = nodeList[e.node];
+            BL_OCTTREE_STAT(nodesVisited, 1);
+            BL_OCTTREE_STAT(boxesTested, cur.count);
+            for (uint32_t p = cur.dataHead; p != NULL_NEXT; p = block(p).next) {
+                if (!intersectRay(o, invD, grown(block(p).objectBox),
+                                  Scalar(0), tMax, &t))
+                    continue;
+                if (hits.size() == k) {
+                    std::pop_heap(hits.begin(), hits.end(), hitCloser);
+                    hits.pop_back();
+                }
+                hits.push_back({p, t});
+                std::push_heap(hits.begin(), hits.end(), hitCloser);
+                if (hits.size() == k)
+                    tMax = hits.front().t;
+            }
+            if (cur.next == NULL_NEXT)
+                continue;
+            BL_OCTTREE_STAT(boxesTested, 8);
+            const OctGroup& g = groupList[to_parent_list_index(cur.next)];
+            Scalar tEnter[8];
+            uint32_t mask;
+            if constexpr (Swept) {
+                AABB8<Scalar> e = g.extend;
+                for (uint32_t a = 0; a < 3; a++)
+                    for (uint32_t i = 0; i < 8; i++) {
+                        e.max[a][i] += grow[a];
+                        e.min[a][i] -= grow[a];
+                    }
+                mask = intersectRay8(o, invD, e, Scalar(0), tMax, tEnter);
+            } else {
+                mask =
+                    intersectRay8(o, invD, g.extend, Scalar(0), tMax, tEnter);
+            }
+            // 远的先入栈, 使近的子节点先被访问
+            uint32_t base = top;
+            for (; mask != 0; mask &= mask - 1) {
+                uint32_t i = std::countr_zero(mask);
+                Entry c = {cur.next + i, tEnter[i]};
+                uint32_t j = top++;
+                while (j > base && stack[j - 1].t < c.t) {
+                    stack[j] = stack[j - 1];
+                    j--;
+                }
+                stack[j] = c;
+            }
+        }
+        BL_OCTTREE_STAT(hits, hits.size());
+    }
+    // 对象b与node的所有下层节点中对象的相交对
+    void pairsObjectBelow(uint32_t b, uint32_t node, PairList& out) {
+        const Box& box = block(b).objectBox;
+        std::array<uint32_t, 8 * LAYER_LIMIT> stack;
+        uint32_t top = 0;
+        auto pushChildren = [&](uint32_t n) {
+            uint32_t base = nodeList[n].next;
+            if (base == NULL_NEXT)
+                return;
+            uint32_t mask =
+                intersectTest8(groupList[to_parent_list_index(base)].extend,
+                               box) &
+                0xFF;
+            for (; mask != 0; mask &= mask - 1)
+                stack[top++] = base + std::countr_zero(mask);
+        };
+        pushChildren(node);
+        while (top > 0) {
+            uint32_t n = stack[--top];
+            for (uint32_t p = nodeList[n].dataHead; p != NULL_NEXT;
+                 p = block(p).next) {
+                if (intersectTest(box, block(p).objectBox) !=
+                    CollisionResult::outer)
+                    out.push_back({&block(b).data, &block(p).data});
+            }
+            pushChildren(n);
+        }
+    }
+    // 以a为根的子树与以c为根的子树之间的相交对, a与c互不为祖先
+    // 两棵子树同时下降: 同层节点的对象两两测试, 一侧节点的对象与另一侧的下层
+    // 对象交给pairsObjectBelow, 每对只报告一次
+    void pairsCross(uint32_t a, uint32_t c, PairList& out) {
+        const Box& ae = nodeList[a].extendBox;
+        const Box& ce = nodeList[c].extendBox;
+        if (intersectTest(ae, ce) == CollisionResult::outer)
+            return;
+        for (uint32_t p = nodeList[a].dataHead; p != NULL_NEXT;
+             p = block(p).next) {
+            const Box& box = block(p).objectBox;
+            if (intersectTest(box, ce) == CollisionResult::outer)
+                continue;
+            for (uint32_t q = nodeList[c].dataHead; q != NULL_NEXT;
+                 q = block(q).next) {
+                if (intersectTest(box, block(q).objectBox) !=
+                    CollisionResult::outer)
+                    out.push_back({&block(p).data, &block(q).data});
+            }
+            pairsObjectBelow(p, c, out);
+        }
+        for (uint32_t q = nodeList[c].dataHead; q != NULL_NEXT;
+             q = block(q).next) {
+            if (intersectTest(block(q).objectBox, ae) != CollisionResult::outer)
+                pairsObjectBelow(q, a, out);
+        }
+        uint32_t ba = nodeList[a].next, bc = nodeList[c].next;
+        if (ba == NULL_NEXT || bc == NULL_NEXT)
+            return;
+        for (uint32_t i = 0; i < 8; i++)
+            for (uint32_t j = 0; j < 8; j++)
+                pairsCross(ba + i, bc + j, out);
+    }
+    // 节点内对象两两之间, 及节点内对象与下层对象的相交对
+    void pairsLocal(uint32_t node, PairList& out) {
+        for (uint32_t p = nodeList[node].dataHead; p != NULL_NEXT;
+             p = block(p).next) {
+            const Box& box = block(p).objectBox;
+            for (uint32_t q = block(p).next; q != NULL_NEXT;
+                 q = block(q).next) {
+                if (intersectTest(box, block(q).objectBox) !=
+                    CollisionResult::outer)
+                    out.push_back({&block(p).data, &block(q).data});
+            }
+            pairsObjectBelow(p, node, out);
+        }
+    }
+    // 以node为根的子树内的全部相交对
+    void pairsSubtree(uint32_t node, PairList& out) {
+        pairsLocal(node, out);
+        uint32_t base = nodeList[node].next;
+        if (base == NULL_NEXT)
+            return;
+        for (uint32_t i = 0; i < 8; i++)
+            for (uint32_t j = i + 1; j < 8; j++)
+                pairsCross(base + i, base + j, out);
+        for (uint32_t i = 0; i < 8; i++)
+            pairsSubtree(base + i, out);
+    }
+    enum struct PairTaskType { Local, Subtree, Cross };
+    struct PairTask {
+        PairTaskType type;
+        uint32_t a, c;
+    };
+    // 将pairsSubtree(node)的前depth层展开为可独立执行的任务
+    void pairsSplitTasks(uint32_t node,
+                         uint32_t depth,
+                         std::vector<PairTask>& tasks) {
+        uint32_t base = nodeList[node].next;
+        if (depth == 0 || base == NULL_NEXT) {
+            tasks.push_back({PairTaskType::Subtree, node, 0});
+            return;
+        }
+        tasks.push_back({PairTaskType::Local, node, 0});
+        for (uint32_t i = 0; i < 8; i++)
+            for (uint32_t j = i + 1; j < 8; j++)
+                tasks.push_back({PairTaskType::Cross, base + i, base + j});
+        for (uint32_t i = 0; i < 8; i++)
+            pairsSplitTasks(base + i, depth - 1, tasks);
+    }
+    // 按layer层的路径键将items[lo,hi)分段, 依次以(子节点序号+1, 起, 止)调用fn
+    // 序号0为停在该层的对象, 其余为空的段被跳过
+    template <typename Fn>
+    static void buildForEachChild(const std::vector<BuildItem>& items,
+                                  uint32_t layer,
+                                  uint32_t lo,
+                                  uint32_t hi,
+                                  Fn&& fn) {
+        uint32_t shift = buildKeyShift(layer);
+        auto first = items.begin() + lo, last = items.begin() + hi;
+        for (uint32_t d = 0; d <= 8; d++) {
+            auto end = std::partition_point(
+                first, last, [&](const BuildItem& it) {
+                    return (uint32_t(it.key >> shift) & 0xF) <= d;
+                });
+            uint32_t b = first - items.begin(), e = end - items.begin();
+            if (d == 0 || b != e)
+                fn(d, b, e);
+            first = end;
+        }
+    }
+    bool buildIsLeaf(uint32_t layer, uint32_t lo, uint32_t hi) const {
+        return hi - lo <= nodeMaxData || layer >= nodeMaxLayer;
+    }
+    // 自顶向下划分节点, 对象数不多于grain的子树记入tasks, 留待并行建立
+    void buildSplit(uint32_t node,
+                    uint32_t layer,
+                    const std::vector<BuildItem>& items,
+                    uint32_t lo,
+                    uint32_t hi,
+                    uint32_t grain,
+                    std::vector<BuildRun>& runs,
+                    std::vector<BuildTask>& tasks) {
+        if (buildIsLeaf(layer, lo, hi)) {
+            runs.push_back({node, lo, hi});
+            return;
+        }
+        if (hi - lo <= grain) {
+            tasks.push_back({node, layer, lo, hi, 0});
+            return;
+        }
+        uint32_t next = insertOctNodeNext(node);
+        buildForEachChild(items, layer, lo, hi,
+                          [&](uint32_t d, uint32_t b, uint32_t e) {
+                              if (d == 0)
+                                  runs.push_back({node, b, e});
+                              else
+                                  buildSplit(next + d - 1, layer + 1, items, b,
+                                             e, grain, runs, tasks);
+                          });
+    }
+    // 以layer层节点为根建立items[lo,hi)的子树所需的节点组数
+    uint32_t buildCountGroups(uint32_t layer,
+                              const std::vector<BuildItem>& items,
+                              uint32_t lo,
+                              uint32_t hi) const {
+        if (buildIsLeaf(layer, lo, hi))
+            return 0;
+        uint32_t count = 1;
+        buildForEachChild(items, layer, lo, hi,
+                          [&](uint32_t d, uint32_t b, uint32_t e) {
+                              if (d != 0)
+                                  count += buildCountGroups(layer + 1, items,
+                                                            b, e);
+                          });
+        return count;
+    }
+    // 为items[lo,hi)建立以node为根的子树, 记录各节点的数据区间
+    // 节点组从group开始依次使用, 须已在各数组中预留
+    void buildRange(uint32_t node,
+                    uint32_t layer,
+                    const std::vector<BuildItem>& items,
+                    uint32_t lo,
+                    uint32_t hi,
+                    uint32_t& group,
+                    std::vector<BuildRun>& runs) {
+        if (buildIsLeaf(layer, lo, hi)) {
+            runs.push_back({node, lo, hi});
+            return;
+        }
+        uint32_t next = 1 + 8 * (group - 1);
+        parentList[group++] = node;
+        splitOctNode(node, next);
+        buildForEachChild(items, layer, lo, hi,
+                          [&](uint32_t d, uint32_t b, uint32_t e) {
+                              if (d == 0)
+                                  runs.push_back({node, b, e});
+                              else
+                                  buildRange(next + d - 1, layer + 1, items, b,
+                                             e, group, runs);
+                          });
+    }
 
    public:
     void create(const Box& maxSize) {
+        freeList.clear();
+        parentList.assign(1, 0);  // 下标0不对应任何节点组
+        groupList.resize(1);
         nodeList.resize(1);
         nodeList[0] = {.sizeBox = maxSize,
                        .extendBox = maxSize,
                        .next = NULL_NEXT,
-                       .dataHead = nullptr,
+                       .dataHead = NULL_NEXT,
                        .count = 0};
+        blockChunks.clear();
+        blockFreeHead = NULL_NEXT;
+        blockUsed = 0;
+        moveQueue.clear();
+    }
+    // 快照文件: HeadBlock之后依次为SnapshotInfo与各数组的原始字节
+    // 树内全部引用均为下标, 载入时只需复制, 不需要重新建树
+    static constexpr uint32_t SNAPSHOT_HEAD = 0x544F4C42;  // "BLOT"
+    static constexpr uint32_t SNAPSHOT_VERSION = 1;
+    struct SnapshotInfo {
+        uint32_t dataSize, scalarSize;
+        uint32_t nodeMaxData, nodeMaxLayer;
+        uint32_t nodeCount, groupCount, freeCount;
+        uint32_t blockUsed, blockFreeHead;
+    };
+    void save(const std::string& path) const
+        requires std::is_trivially_copyable_v<T>
+    {
+        File::FileWriter writer(path, SNAPSHOT_HEAD, SNAPSHOT_VERSION);
+        SnapshotInfo info = {.dataSize = sizeof(T),
+                             .scalarSize = sizeof(Scalar),
+                             .nodeMaxData = nodeMaxData,
+                             .nodeMaxLayer = nodeMaxLayer,
+                             .nodeCount = uint32_t(nodeList.size()),
+                             .groupCount = uint32_t(parentList.size()),
+                             .freeCount = uint32_t(freeList.size()),
+                             .blockUsed = blockUsed,
+                             .blockFreeHead = blockFreeHead};
+        writer.reserve(sizeof(info) + sizeof(OctNode) * nodeList.size() +
+                       (sizeof(uint32_t) + sizeof(OctGroup)) *
+                           parentList.size() +
+                       sizeof(uint32_t) * freeList.size() +
+                       sizeof(DataBlock) * blockUsed);
+        writer.write(&info);
+        writer.write_array(nodeList.data(), nodeList.size());
+        writer.write_array(parentList.data(), parentList.size());
+        writer.write_array(groupList.data(), groupList.size());
+        writer.write_array(freeList.data(), freeList.size());
+        for (uint32_t b = 0; b < blockUsed; b += BLOCK_CHUNK_SIZE)
+            writer.write_array(blockChunks[b >> BLOCK_CHUNK_SHIFT].get(),
+                               std::min(BLOCK_CHUNK_SIZE, blockUsed - b));
+        writer.close();
+    }
+    // 以save写出的快照替换当前树, 文件损坏或布局不符时返回false且树保持不变
+    bool load(const std::string& path)
+        requires std::is_trivially_copyable_v<T>
+    {
+        File::FileReader reader(path, SNAPSHOT_HEAD, SNAPSHOT_VERSION);
+        std::vector<uint8_t> buf;
+        if (!reader.read_all(buf))
+            return false;
+        reader.close();
+        SnapshotInfo info;
+        if (buf.size() < sizeof(info)) {
+            print_error("OctTree", "Snapshot too short:", path);
+            return false;
+        }
+        memcpy(&info, buf.data(), sizeof(info));
+        size_t expect = sizeof(info) + sizeof(OctNode) * info.nodeCount +
+                        (sizeof(uint32_t) + sizeof(OctGroup)) *
+                            info.groupCount +
+                        sizeof(uint32_t) * info.freeCount +
+                        sizeof(DataBlock) * info.blockUsed;
+        if (info.dataSize != sizeof(T) || info.scalarSize != sizeof(Scalar) ||
+            info.nodeCount == 0 || buf.size() != expect) {
+            print_error("OctTree", "Snapshot layout mismatch:", path);
+            return false;
+        }
+        const uint8_t* p = buf.data() + sizeof(info);
+        auto take = [&p]<typename U>(std::vector<U>& v, uint32_t count) {
+            v.resize(count);
+            memcpy((void*)v.data(), p, sizeof(U) * count);
+            p += sizeof(U) * count;
+        };
+        take(nodeList, info.nodeCount);
+        take(parentList, info.groupCount);
+        take(groupList, info.groupCount);
+        take(freeList, info.freeCount);
+        blockChunks.clear();
+        reserve(info.blockUsed);
+        for (uint32_t b = 0; b < info.blockUsed; b += BLOCK_CHUNK_SIZE) {
+            uint32_t n = std::min(BLOCK_CHUNK_SIZE, info.blockUsed - b);
+            memcpy((void*)blockChunks[b >> BLOCK_CHUNK_SHIFT].get(), p,
+                   sizeof(DataBlock) * n);
+            p += sizeof(DataBlock) * n;
+        }
+        nodeMaxData = info.nodeMaxData;
+        nodeMaxLayer = std::min(info.nodeMaxLayer, LAYER_LIMIT);
+        blockUsed = info.blockUsed;
+        blockFreeHead = info.blockFreeHead;
+        moveQueue.clear();
+        return true;
+    }
+    // 预先分配至少能容纳count个数据块的空间
+    void reserve(uint32_t count) {
+        while ((blockChunks.size() << BLOCK_CHUNK_SHIFT) < count)
+            blockChunks.emplace_back(new DataBlock[BLOCK_CHUNK_SIZE]);
+    }
+    DataBlock& block(uint32_t b) {
+        return blockChunks[b >> BLOCK_CHUNK_SHIFT][b & BLOCK_CHUNK_MASK];
+    }
+    const DataBlock& block(uint32_t b) const {
+        return blockChunks[b >> BLOCK_CHUNK_SHIFT][b & BLOCK_CHUNK_MASK];
+    }
+    T& data(uint32_t b) { return block(b).data; }
+    const OctNode& node(uint32_t n) const { return nodeList[n]; }
+    // 调整分裂参数, 只影响此后的插入与build, 已有节点不会重新划分
+    void setNodeMaxData(uint32_t n) { nodeMaxData = std::max(n, 1u); }
+    void setNodeMaxLayer(uint32_t n) {
+        nodeMaxLayer = std::min(n, LAYER_LIMIT);
+    }
+    uint32_t getNodeMaxData() const { return nodeMaxData; }
+    uint32_t getNodeMaxLayer() const { return nodeMaxLayer; }
+#ifdef BL_OCTTREE_STATS
+    QueryStats queryStats() const {
+        return {.nodesVisited = queryCounters.nodesVisited.load(),
+                .boxesTested = queryCounters.boxesTested.load(),
+                .hits = queryCounters.hits.load()};
+    }
+    void resetQueryStats() {
+        queryCounters.nodesVisited = 0;
+        queryCounters.boxesTested = 0;
+        queryCounters.hits = 0;
+    }
+    // 遍历整棵树统计结构信息, 与查询计数一起以JSON输出
+    // objectsPerNodeHistogram的最后一项为对象数不少于2*nodeMaxData的节点数
+    std::string dumpStats() const {
+        using namespace BL::JSON;
+        JSONList depthHist, countHist;
+        auto bump = [](JSONList& hist, size_t i) {
+            while (hist.size() <= i)
+                hist.push_back({int64_t(0)});
+            std::get<int64_t>(hist[i].data)++;
+        };
+        int64_t nodes = 0, leaves = 0, internalObjects = 0, leafObjects = 0;
+        uint32_t maxCount = 0;
+        struct Entry {
+            uint32_t node, layer;
+        };
+        std::array<Entry, 8 * LAYER_LIMIT> stack;
+        uint32_t top = 0;
+        stack[top++] = {0, 0};
+        while (top > 0) {
+            auto [h, layer] = stack[--top];
+            const OctNode& cur = nodeList[h];
+            nodes++;
+            bump(depthHist, layer);
+            bump(countHist, std::min(cur.count, 2 * nodeMaxData));
+            maxCount = std::max(maxCount, cur.count);
+            if (cur.next == NULL_NEXT) {
+                leaves++;
+                leafObjects += cur.count;
+                continue;
+            }
+            internalObjects += cur.count;
+            for (uint32_t i = 0; i < 8; i++)
+                stack[top++] = {cur.next + i, layer + 1};
+        }
+        int64_t freeBlocks = 0;
+        for (uint32_t b = blockFreeHead; b != NULL_NEXT; b = block(b).next)
+            freeBlocks++;
+        QueryStats q = queryStats();
+        JSONDict res;
+        res["nodeMaxData"] = {int64_t(nodeMaxData)};
+        res["nodeMaxLayer"] = {int64_t(nodeMaxLayer)};
+        res["nodeCount"] = {nodes};
+        res["leafCount"] = {leaves};
+        res["depthHistogram"] = {std::move(depthHist)};
+        res["objectsPerNodeHistogram"] = {std::move(countHist)};
+        res["maxObjectsPerNode"] = {int64_t(maxCount)};
+        res["internalObjects"] = {internalObjects};
+        res["leafObjects"] = {leafObjects};
+        res["freeGroups"] = {int64_t(freeList.size())};
+        res["freeBlocks"] = {freeBlocks};
+        res["blockCapacity"] = {
+            int64_t(blockChunks.size() << BLOCK_CHUNK_SHIFT)};
+        res["nodesVisited"] = {int64_t(q.nodesVisited)};
+        res["boxesTested"] = {int64_t(q.boxesTested)};
+        res["hits"] = {int64_t(q.hits)};
+        return dump({std::move(res)});
+    }
+#endif
+    template <typename Visitor>
+        requires std::invocable<Visitor&, const Box&, T&>
+    void iterateData(uint32_t node, Visitor&& fn) {
+        uint32_t p = nodeList[node].dataHead;
+        while (p != NULL_NEXT) {
+            DataBlock& cur = block(p);
+            fn(cur.objectBox, cur.data);
+            p = cur.next;
+        }
+    }
+    void iterateData(uint32_t node, const IterateFunction& fn) {
+        iterateData<const IterateFunction&>(node, fn);
+    }
+    // 对与size相交的每个对象调用fn(box, data), 遍历栈位于调用栈上, 不分配内存
+    template <typename Visitor>
+        requires std::invocable<Visitor&, const Box&, T&>
+    void find(const Box& size, Visitor&& fn) {
+        std::array<uint32_t, 8 * LAYER_LIMIT> stack;
+        uint32_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            uint32_t h = stack[--top];
+            BL_OCTTREE_STAT(nodesVisited, 1);
+            BL_OCTTREE_STAT(boxesTested, nodeList[h].count);
+            for (uint32_t p = nodeList[h].dataHead; p != NULL_NEXT;) {
+                DataBlock& cur = block(p);
+                if (intersectTest(size, cur.objectBox) >=
+                    CollisionResult::intersect) {
+                    BL_OCTTREE_STAT(hits, 1);
+                    fn(cur.objectBox, cur.data);
+                }
+                p = cur.next;
+            }
+            uint32_t base = nodeList[h].next;
+            if (base == NULL_NEXT)
+                continue;
+            BL_OCTTREE_STAT(boxesTested, 8);
+            uint32_t mask =
+                intersectTest8(groupList[to_parent_list_index(base)].extend,
+                               size) &
+                0xFF;
+            for (; mask != 0; mask &= mask - 1)
+                stack[top++] = base + std::countr_zero(mask);
+        }
     }
     void find(const Box& size, const IterateFunction& fn) {
-        std::queue<uint32_t> Q;
-        Q.push(0);
-        while (!Q.empty()) {
-            uint32_t h = Q.front();
-            nodeList[h].iterateData([&size, &fn](const Box& b, T& t) {
-                if (intersectTest(size, b) >= CollisionResult::intersect) {
-                    fn(b, t);
+        find<const IterateFunction&>(size, fn);
+    }
+    // 以boxes[i], data[i]为对象重建整棵树(保留create时的根), data中的元素被移入树中
+    // 节点结构与各对象所在节点同按相同顺序逐个insert的结果一致, 仅节点编号和链表顺序不同
+    // handles非空时写入每个对象的数据块索引, 超出根范围的对象为NULL_NEXT
+    // 返回插入的对象数
+    uint32_t build(std::span<const Box> boxes,
+                   std::span<T> data,
+                   std::span<uint32_t> handles = {}) {
+        create(nodeList[0].sizeBox);
+        ThreadPool& pool = default_thread_pool();
+        uint32_t n = boxes.size();
+        uint32_t maxLayer = std::min(nodeMaxLayer, LAYER_LIMIT);
+        // 1.计算路径键, 超出根范围的对象被剔除
+        std::vector<uint8_t> valid(n);
+        pool.parallel_for(n, 4096, [&](uint32_t b, uint32_t e, uint32_t) {
+            for (uint32_t i = b; i < e; i++)
+                valid[i] = intersectTest(nodeList[0].sizeBox, boxes[i]) ==
+                           CollisionResult::inner;
+        });
+        std::vector<BuildItem> items;
+        items.reserve(n);
+        for (uint32_t i = 0; i < n; i++) {
+            if (valid[i])
+                items.push_back({0, i});
+            else if (!handles.empty())
+                handles[i] = NULL_NEXT;
+        }
+        uint32_t m = items.size();
+        pool.parallel_for(m, 4096, [&](uint32_t b, uint32_t e, uint32_t) {
+            for (uint32_t i = b; i < e; i++)
+                items[i].key = buildPathKey(boxes[items[i].index], maxLayer);
+        });
+        // 2.排序后同一节点的对象连续
+        buildSortItems(items, 4 * (maxLayer - 1));
+        // 3.自顶向下划分节点, 上层逐个分配节点组, 下层子树先统计节点组数,
+        // 一次预留后各子树并行建立
+        std::vector<BuildRun> runs;
+        std::vector<BuildTask> tasks;
+        buildSplit(0, 1, items, 0, m, std::max(m / (8 * pool.size()), 1024u),
+                   runs, tasks);
+        pool.parallel_for(tasks.size(), 1, [&](uint32_t b, uint32_t e,
+                                               uint32_t) {
+            for (uint32_t t = b; t < e; t++)
+                tasks[t].groupBase = buildCountGroups(
+                    tasks[t].layer, items, tasks[t].begin, tasks[t].end);
+        });
+        uint32_t groups = groupList.size();
+        for (BuildTask& task : tasks)
+            groups += std::exchange(task.groupBase, groups);
+        nodeList.resize(1 + 8 * (groups - 1));
+        parentList.resize(groups);
+        groupList.resize(groups);
+        std::vector<std::vector<BuildRun>> taskRuns(tasks.size());
+        pool.parallel_for(tasks.size(), 1, [&](uint32_t b, uint32_t e,
+                                               uint32_t) {
+            for (uint32_t t = b; t < e; t++) {
+                const BuildTask& task = tasks[t];
+                uint32_t group = task.groupBase;
+                buildRange(task.node, task.layer, items, task.begin, task.end,
+                           group, taskRuns[t]);
+            }
+        });
+        for (const auto& r : taskRuns)
+            runs.insert(runs.end(), r.begin(), r.end());
+        // 4.数据块按排序后的顺序分配, 每个节点的链表为连续的一段
+        reserve(m);
+        blockUsed = m;
+        auto fill = [&](uint32_t b, uint32_t e, uint32_t) {
+            for (uint32_t r = b; r < e; r++) {
+                const BuildRun& run = runs[r];
+                for (uint32_t i = run.begin; i < run.end; i++) {
+                    DataBlock& blk = block(i);
+                    uint32_t src = items[i].index;
+                    blk.next = i + 1 < run.end ? i + 1 : NULL_NEXT;
+                    blk.prev = i > run.begin ? i - 1 : NULL_NEXT;
+                    blk.node = run.node;
+                    blk.objectBox = boxes[src];
+                    blk.data = std::move(data[src]);
+                    if (!handles.empty())
+                        handles[src] = i;
+                }
+            }
+        };
+        pool.parallel_for(runs.size(), 64, fill);
+        for (const BuildRun& run : runs) {
+            if (run.begin != run.end) {
+                nodeList[run.node].dataHead = run.begin;
+                nodeList[run.node].count = run.end - run.begin;
+            }
+        }
+        return m;
+    }
+    // 视锥体剔除, 将与视锥体相交的对象的数据块索引追加到out
+    // 节点完全位于某平面内侧时, 其子树不再测试该平面; 全部在内时整棵子树直接输出
+    void cull(const std::array<Plane<Scalar>, 6>& planes,
+              std::vector<uint32_t>& out) {
+        struct Entry {
+            uint32_t node, mask;
+        };
+        std::array<Entry, 8 * LAYER_LIMIT> stack;
+        uint32_t top = 0;
+        stack[top++] = {0, 0x3F};
+        while (top > 0) {
+            auto [h, mask] = stack[--top];
+            const OctNode& cur = nodeList[h];
+            BL_OCTTREE_STAT(nodesVisited, 1);
+            BL_OCTTREE_STAT(boxesTested, 1);
+            bool outside = false;
+            for (uint32_t m = mask; m != 0; m &= m - 1) {
+                uint32_t i = std::countr_zero(m);
+                CollisionResult r = intersectTest(planes[i], cur.extendBox);
+                if (r == CollisionResult::outer) {
+                    outside = true;
+                    break;
+                }
+                if (r == CollisionResult::inner)
+                    mask &= ~(1u << i);
+            }
+            if (outside)
+                continue;
+            if (mask == 0) {
+                uint32_t n = collectSubtree(h, out);
+                BL_OCTTREE_STAT(hits, n);
+                continue;
+            }
+            BL_OCTTREE_STAT(boxesTested, cur.count);
+            for (uint32_t p = cur.dataHead; p != NULL_NEXT;) {
+                const DataBlock& blk = block(p);
+                bool visible = true;
+                for (uint32_t m = mask; m != 0; m &= m - 1) {
+                    if (intersectTest(planes[std::countr_zero(m)],
+                                      blk.objectBox) ==
+                        CollisionResult::outer) {
+                        visible = false;
+                        break;
+                    }
+                }
+                if (visible) {
+                    BL_OCTTREE_STAT(hits, 1);
+                    out.push_back(p);
+                }
+                p = blk.next;
+            }
+            if (cur.next != NULL_NEXT)
+                for (uint32_t i = 0; i < 8; i++)
+                    stack[top++] = {cur.next + i, mask};
+        }
+    }
+    // 射线o+t*d(t在[0,tMax]内)与对象盒的最近交点, 未命中时hit.block为NULL_NEXT
+    RayHit raycast(const Vec3& o, const Vec3& d, Scalar tMax) const {
+        std::vector<RayHit> hits;
+        hits.reserve(1);
+        raycastInternal(o, d, tMax, 1, hits);
+        return hits.empty() ? RayHit{NULL_NEXT, tMax} : hits.front();
+    }
+    // 最近的k个交点, 按t由近及远写入hits, 返回命中数
+    uint32_t raycast(const Vec3& o,
+                     const Vec3& d,
+                     Scalar tMax,
+                     uint32_t k,
+                     std::vector<RayHit>& hits) const {
+        hits.clear();
+        raycastInternal(o, d, tMax, k, hits);
+        std::sort_heap(hits.begin(), hits.end(), hitCloser);
+        return hits.size();
+    }
+    // 盒size沿delta平移(t在[0,1]内)时接触到的对象, 按接触时间t由小到大写入hits
+    // 开始时已相交的对象t为0, 至多返回k个最早接触的对象; 返回命中数
+    // 快速移动的物体每帧只需一次查询, 无需分步; OBB可先用其外接AABB查询,
+    // 再对候选调用intersectSweep精确测试
+    uint32_t sweep(const Box& size,
+                   const Vec3& delta,
+                   std::vector<RayHit>& hits,
+                   uint32_t k = std::numeric_limits<uint32_t>::max()) const {
+        hits.clear();
+        raycastInternal<true>(size.c(), delta, Scalar(1), k, hits, size.h());
+        std::sort_heap(hits.begin(), hits.end(), hitCloser);
+        return hits.size();
+    }
+    // 批量求每条射线的最近交点, 各射线分配到线程池中并行计算
+    void raycastBatch(std::span<const Vec3> o,
+                      std::span<const Vec3> d,
+                      Scalar tMax,
+                      std::span<RayHit> hits) const {
+        default_thread_pool().parallel_for(
+            o.size(), 64, [&](uint32_t b, uint32_t e, uint32_t) {
+                std::vector<RayHit> tmp;
+                tmp.reserve(1);
+                for (uint32_t i = b; i < e; i++) {
+                    tmp.clear();
+                    raycastInternal(o[i], d[i], tMax, 1, tmp);
+                    hits[i] = tmp.empty() ? RayHit{NULL_NEXT, tMax}
+                                          : tmp.front();
                 }
             });
-            uint32_t base = nodeList[h].next;
-            for (uint32_t i = 0; i < 8; i++) {
-                uint32_t curInd = base + i;
-                if (intersectTest(size, nodeList[curInd].extendBox) >=
-                    CollisionResult::intersect) {
-                    Q.push(curInd);
+    }
+    // 收集全部相交(含接触)的对象对, 每对只出现一次
+    // 子树在线程池中并行处理, 各线程写入自己的缓冲区后合并到out
+    void collectPairs(PairList& out) {
+        std::vector<PairTask> tasks;
+        pairsSplitTasks(0, 2, tasks);
+        ThreadPool& pool = default_thread_pool();
+        std::vector<PairList> buffers(pool.size());
+        std::atomic<uint32_t> nextTask = 0;
+        pool.parallel_for(pool.size(), 1, [&](uint32_t, uint32_t, uint32_t s) {
+            for (uint32_t i; (i = nextTask++) < tasks.size();) {
+                const PairTask& task = tasks[i];
+                if (task.type == PairTaskType::Local)
+                    pairsLocal(task.a, buffers[s]);
+                else if (task.type == PairTaskType::Subtree)
+                    pairsSubtree(task.a, buffers[s]);
+                else
+                    pairsCross(task.a, task.c, buffers[s]);
+            }
+        });
+        out.clear();
+        size_t total = 0;
+        for (const PairList& buf : buffers)
+            total += buf.size();
+        out.reserve(total);
+        for (const PairList& buf : buffers)
+            out.insert(out.end(), buf.begin(), buf.end());
+    }
+    // 距点p最近的k个对象, 按距离由近及远写入out, 返回个数
+    // 节点按到extendBox的距离最优先遍历, 松散节点中的对象都在extendBox内
+    uint32_t knn(const Vec3& p,
+                 uint32_t k,
+                 std::vector<NearHit>& out,
+                 KnnScratch& scratch) const {
+        auto closer = [](const NearHit& a, const NearHit& b) {
+            return a.dist2 < b.dist2;
+        };
+        auto farther = [](const NearHit& a, const NearHit& b) {
+            return a.dist2 > b.dist2;
+        };
+        std::vector<NearHit>& Q = scratch.nodeQueue;
+        Q.clear();
+        out.clear();
+        if (k == 0)
+            return 0;
+        Q.push_back({0, distanceSquared(p, nodeList[0].extendBox)});
+        while (!Q.empty()) {
+            std::pop_heap(Q.begin(), Q.end(), farther);
+            NearHit e = Q.back();
+            Q.pop_back();
+            if (out.size() == k && e.dist2 > out.front().dist2)
+                break;
+            const OctNode& cur = nodeList[e.block];
+            BL_OCTTREE_STAT(nodesVisited, 1);
+            BL_OCTTREE_STAT(boxesTested, cur.count);
+            for (uint32_t b = cur.dataHead; b != NULL_NEXT; b = block(b).next) {
+                Scalar d2 = distanceSquared(p, block(b).objectBox);
+                if (out.size() == k) {
+                    if (d2 >= out.front().dist2)
+                        continue;
+                    std::pop_heap(out.begin(), out.end(), closer);
+                    out.pop_back();
                 }
+                out.push_back({b, d2});
+                std::push_heap(out.begin(), out.end(), closer);
+            }
+            if (cur.next == NULL_NEXT)
+                continue;
+            BL_OCTTREE_STAT(boxesTested, 8);
+            for (uint32_t i = 0; i < 8; i++) {
+                const Box& ext = nodeList[cur.next + i].extendBox;
+                Scalar d2 = distanceSquared(p, ext);
+                if (out.size() == k && d2 > out.front().dist2)
+                    continue;
+                Q.push_back({cur.next + i, d2});
+                std::push_heap(Q.begin(), Q.end(), farther);
             }
         }
+        std::sort_heap(out.begin(), out.end(), closer);
+        BL_OCTTREE_STAT(hits, out.size());
+        return out.size();
+    }
+    std::vector<NearHit> knn(const Vec3& p, uint32_t k) const {
+        std::vector<NearHit> out;
+        KnnScratch scratch;
+        out.reserve(k);
+        knn(p, k, out, scratch);
+        return out;
     }
-    DataBlock* insert(const Box& size, uint32_t* ret_octnode) {
-        uint32_t c = 1, p = 0;
+    // 将与以p为心r为半径的球相交的对象的数据块索引追加到out, 遍历不分配内存
+    void radius(const Vec3& p, Scalar r, std::vector<uint32_t>& out) const {
+        Scalar r2 = r * r;
+        if (distanceSquared(p, nodeList[0].extendBox) > r2)
+            return;
+        std::array<uint32_t, 8 * LAYER_LIMIT> stack;
+        uint32_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const OctNode& cur = nodeList[stack[--top]];
+            BL_OCTTREE_STAT(nodesVisited, 1);
+            BL_OCTTREE_STAT(boxesTested, cur.count);
+            for (uint32_t b = cur.dataHead; b != NULL_NEXT; b = block(b).next)
+                if (distanceSquared(p, block(b).objectBox) <= r2) {
+                    BL_OCTTREE_STAT(hits, 1);
+                    out.push_back(b);
+                }
+            if (cur.next == NULL_NEXT)
+                continue;
+            BL_OCTTREE_STAT(boxesTested, 8);
+            for (uint32_t i = 0; i < 8; i++)
+                if (intersectSphere(p, r, nodeList[cur.next + i].extendBox))
+                    stack[top++] = cur.next + i;
+        }
+    }
+    std::vector<uint32_t> radius(const Vec3& p, Scalar r) const {
+        std::vector<uint32_t> out;
+        radius(p, r, out);
+        return out;
+    }
+    // 将以node为根的子树中全部数据块索引追加到out, 返回追加的个数
+    uint32_t collectSubtree(uint32_t node, std::vector<uint32_t>& out) {
+        size_t begin = out.size();
+        std::array<uint32_t, 8 * LAYER_LIMIT> stack;
+        uint32_t top = 0;
+        stack[top++] = node;
+        while (top > 0) {
+            const OctNode& cur = nodeList[stack[--top]];
+            for (uint32_t p = cur.dataHead; p != NULL_NEXT; p = block(p).next)
+                out.push_back(p);
+            if (cur.next != NULL_NEXT)
+                for (uint32_t i = 0; i < 8; i++)
+                    stack[top++] = cur.next + i;
+        }
+        return uint32_t(out.size() - begin);
+    }
+    // 返回数据块索引, 失败时返回NULL_NEXT
+    uint32_t insert(const Box& size, uint32_t* ret_octnode) {
         if (intersectTest(nodeList[0].sizeBox, size) !=
             CollisionResult::inner) {
             *ret_octnode = NULL_NEXT;
-            return nullptr;
-        }
-        DataBlock* node = new DataBlock();
-        node->objectBox = size;
-        if (nodeList[0].next == NULL_NEXT) {
-            FitPosition fp = expendOctNodeNext(0, node);
-            *ret_octnode = (fp == FitPosition::Self)
-                               ? 0
-                               : nodeList[0].next + static_cast<uint32_t>(fp);
-            nodeList[*ret_octnode].count++;
-            return node;
-        } else {
-            FitPosition fp = calculateOctNodeFit(0, size);
-            if (fp == FitPosition::Self)
-                nodeList[0].insert(node);
-            else
-                p = nodeList[0].next + static_cast<uint32_t>(fp), c++;
-            while (true) {
-                if (c >= nodeMaxLayer) {
-                    nodeList[p].insert(node);
-                    *ret_octnode = p;
-                    nodeList[p].count++;
-                    return node;
-                } else if (nodeList[p].next != NULL_NEXT) {
-                    fp = calculateOctNodeFit(p, size);
-                    if (fp == FitPosition::Self) {
-                        nodeList[p].insert(node);
-                        *ret_octnode = p;
-                        nodeList[p].count++;
-                        return node;
-                    } else {
-                        p = nodeList[p].next + static_cast<uint32_t>(fp), c++;
-                    }
-                } else {
-                    fp = expendOctNodeNext(p, node);
-                    *ret_octnode =
-                        fp == FitPosition::Self
-                            ? p
-                            : nodeList[p].next + static_cast<uint32_t>(fp);
-                    nodeList[*ret_octnode].count++;
-                    return node;
-                }
-            }
+            return NULL_NEXT;
         }
+        uint32_t b = allocBlock();
+        block(b).objectBox = size;
+        *ret_octnode = insertBeginAt(b, 0);
+        return b;
     }
-    uint32_t drop(DataBlock* block, uint32_t belongTo) {
-        drop_internal(block, belongTo);
-        delete block;
+    uint32_t nodeOf(uint32_t b) const { return block(b).node; }
+    uint32_t drop(uint32_t b) {
+        uint32_t belongTo = block(b).node;
+        unlinkBlock(b);
+        freeBlock(b);
         if (nodeList[belongTo].count == 0 && belongTo != 0)
             return deleteNode(belongTo);
         return belongTo;
     }
-    uint32_t drop_nodelete(DataBlock* block, uint32_t belongTo) {
-        drop_internal(block, belongTo);
+    uint32_t drop_nodelete(uint32_t b) {
+        uint32_t belongTo = block(b).node;
+        unlinkBlock(b);
         if (nodeList[belongTo].count == 0 && belongTo != 0)
             return deleteNode(belongTo);
         return belongTo;
     }
-    uint32_t move(DataBlock* block, uint32_t belongTo, Vec3 dir) {
-        block->objectBox.min() += dir;
-        block->objectBox.max() += dir;
-        uint32_t startNode = drop_nodelete(block, belongTo);
-        while (intersectTest(nodeList[startNode].extendBox, block->objectBox) !=
+    uint32_t move(uint32_t b, Vec3 dir) {
+        Box& box = block(b).objectBox;
+        box.min() += dir;
+        box.max() += dir;
+        uint32_t startNode = drop_nodelete(b);
+        while (intersectTest(nodeList[startNode].extendBox, box) !=
                CollisionResult::inner) {
-            uint32_t qt = to_parent_list_index(startNode);
-            if (qt == to_parent_list_index(0))
-                throw std::out_of_range();
-            startNode = parentList[qt];
+            if (startNode == 0) {
+                freeBlock(b);
+                throw std::out_of_range("OctTree: object moved out of range");
+            }
+            startNode = parentList[to_parent_list_index(startNode)];
+        }
+        return insertBeginAt(b, startNode);
+    }
+    // 记录对象的移动, 在commitMoves时统一处理
+    void queueMove(uint32_t b, const Vec3& delta) {
+        moveQueue.push_back({b, delta});
+    }
+    // 提交queueMove记录的移动, 返回更换了节点的对象数
+    // 仍在所在节点extendBox内的对象原地不动; 与move一样, 移出根节点
+    // extendBox的对象被拒绝: 撤销其移动, 对象留在原位, 数据块索引写入rejected
+    // 空节点在全部对象重新插入后统一回收
+    uint32_t commitMoves(std::vector<uint32_t>* rejected = nullptr) {
+        moveFrom.resize(moveQueue.size());
+        for (size_t i = 0; i < moveQueue.size(); i++) {
+            const PendingMove& m = moveQueue[i];
+            Box& box = block(m.block).objectBox;
+            moveFrom[i] = box;
+            box.min() += m.delta;
+            box.max() += m.delta;
+        }
+        moveRelink.clear();
+        moveSources.clear();
+        moveRejected.clear();
+        for (const PendingMove& m : moveQueue) {
+            uint32_t b = m.block;
+            uint32_t owner = block(b).node;
+            if (owner == NULL_NEXT)  // 同一对象多次记录, 已取下
+                continue;
+            const Box& box = block(b).objectBox;
+            if (intersectTest(nodeList[owner].extendBox, box) ==
+                CollisionResult::inner)
+                continue;
+            if (intersectTest(nodeList[0].extendBox, box) !=
+                CollisionResult::inner) {
+                moveRejected.push_back(b);
+                continue;
+            }
+            unlinkBlock(b);
+            block(b).node = NULL_NEXT;
+            moveSources.push_back(owner);
+            uint32_t start = owner;
+            while (start != 0 &&
+                   intersectTest(nodeList[start].extendBox, box) !=
+                       CollisionResult::inner)
+                start = parentList[to_parent_list_index(start)];
+            moveRelink.push_back({start, b});
+        }
+        if (!moveRejected.empty()) {
+            std::sort(moveRejected.begin(), moveRejected.end());
+            moveRejected.erase(
+                std::unique(moveRejected.begin(), moveRejected.end()),
+                moveRejected.end());
+            // 逆序恢复, 最后写入的是第一次记录前的盒
+            for (size_t i = moveQueue.size(); i-- > 0;)
+                if (std::binary_search(moveRejected.begin(),
+                                       moveRejected.end(), moveQueue[i].block))
+                    block(moveQueue[i].block).objectBox = moveFrom[i];
+            if (rejected)
+                rejected->insert(rejected->end(), moveRejected.begin(),
+                                 moveRejected.end());
         }
-        return insertBeginAt(block, startNode);
+        moveQueue.clear();
+        // 按目标子树分组插入
+        std::sort(moveRelink.begin(), moveRelink.end());
+        for (auto [start, b] : moveRelink)
+            insertBeginAt(b, start);
+        std::sort(moveSources.begin(), moveSources.end());
+        moveSources.erase(std::unique(moveSources.begin(), moveSources.end()),
+                          moveSources.end());
+        for (uint32_t n : moveSources)
+            if (n != 0 && isLiveNode(n))
+                deleteNode(n);
+        return moveRelink.size();
     }
 };
 }  // namespace BL::Math
-#endif  //!_BOUNDLESS_OCTTREE_CXX_HPP_
\ No newline at end of file
+#undef BL_OCTTREE_STAT
+#endif  //!_BOUNDLESS_OCTTREE_CXX_HPP_
@@ -0,0 +1,104 @@
+#ifndef _BOUNDLESS_PARALLEL_CXX_HPP_
+#define _BOUNDLESS_PARALLEL_CXX_HPP_
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace BL {
+// 常驻工作线程池, 调用线程也参与执行
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+
+    bool runOne() {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty())
+                return false;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+        return true;
+    }
+
+   public:
+    explicit ThreadPool(
+        uint32_t threadCount = std::thread::hardware_concurrency()) {
+        for (uint32_t i = 1; i < threadCount; i++) {
+            workers.emplace_back([this] {
+                while (true) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cv.wait(lock,
+                                [this] { return stopping || !tasks.empty(); });
+                        if (stopping && tasks.empty())
+                            return;
+                        task = std::move(tasks.front());
+                        tasks.pop_front();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto& t : workers)
+            t.join();
+    }
+    // 可同时执行的线程数(含调用线程)
+    uint32_t size() const { return uint32_t(workers.size()) + 1; }
+    // 将[0,count)分为至多size()段, 每段不少于grain个, 并行调用
+    // fn(begin, end, slot), slot为段序号, 可用于索引每线程的缓冲区
+    template <typename Fn>
+    void parallel_for(uint32_t count, uint32_t grain, Fn&& fn) {
+        grain = std::max(grain, 1u);
+        uint32_t slots = std::min(size(), (count + grain - 1) / grain);
+        if (slots <= 1) {
+            if (count > 0)
+                fn(0u, count, 0u);
+            return;
+        }
+        uint32_t step = (count + slots - 1) / slots;
+        slots = (count + step - 1) / step;
+        std::atomic<uint32_t> remaining = slots - 1;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (uint32_t s = 1; s < slots; s++) {
+                tasks.emplace_back([&fn, &remaining, s, step, count] {
+                    fn(s * step, std::min(count, (s + 1) * step), s);
+                    remaining.fetch_sub(1, std::memory_order_release);
+                });
+            }
+        }
+        cv.notify_all();
+        fn(0u, step, 0u);
+        // 等待期间帮助执行队列中的任务, 使嵌套调用不会死锁
+        while (remaining.load(std::memory_order_acquire) != 0) {
+            if (!runOne())
+                std::this_thread::yield();
+        }
+    }
+};
+inline ThreadPool& default_thread_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+}  // namespace BL
+#endif  //!_BOUNDLESS_PARALLEL_CXX_HPP_
@@ -0,0 +1,687 @@
+#ifndef _BOUNDLESS_RIGID_BODY_CXX_HPP_
+#define _BOUNDLESS_RIGID_BODY_CXX_HPP_
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "bl_collision.hpp"
+#include "bl_parallel.hpp"
+#include "bl_sweep_prune.hpp"
+namespace BL::Math {
+// 接触点: position为两表面之间的中点, separation为沿法线的距离, 负值为穿透
+template <std::floating_point Real>
+struct ContactPoint {
+    vec3<Real> position;
+    Real separation;
+};
+// 以逆时针顺序的多边形poly裁剪到m·p <= o一侧
+template <std::floating_point Real>
+uint32_t contact_clip(const vec3<Real>* poly,
+                      uint32_t count,
+                      const vec3<Real>& m,
+                      Real o,
+                      vec3<Real>* out) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const vec3<Real>& p = poly[i];
+        const vec3<Real>& q = poly[(i + 1) % count];
+        Real dp = m.dot(p) - o, dq = m.dot(q) - o;
+        if (dp <= 0)
+            out[n++] = p;
+        if ((dp <= 0) != (dq <= 0))
+            out[n++] = p + (q - p) * (dp / (dp - dq));
+    }
+    return n;
+}
+// 面接触: ref的第i个面(外法线n)为参考面, inc上与n最反向的面为入射面
+// 入射面裁剪到参考面的4个侧面内, 保留到参考面距离不超过margin的点
+template <std::floating_point Real>
+uint32_t contact_face(const OBB<Real>& ref,
+                      uint32_t i,
+                      const vec3<Real>& n,
+                      const OBB<Real>& inc,
+                      Real margin,
+                      ContactPoint<Real>* out) {
+    const vec3<Real> a[3] = {ref.u(), ref.v(), ref.w()};
+    const vec3<Real> b[3] = {inc.u(), inc.v(), inc.w()};
+    const vec3<Real> ha = ref.h(), hb = inc.h();
+    uint32_t j = 0;
+    for (uint32_t k = 1; k < 3; k++)
+        if (std::abs(n.dot(b[k])) > std::abs(n.dot(b[j])))
+            j = k;
+    uint32_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+    vec3<Real> c = inc.c() - b[j] * (n.dot(b[j]) > 0 ? hb[j] : -hb[j]);
+    vec3<Real> e1 = b[j1] * hb[j1], e2 = b[j2] * hb[j2];
+    vec3<Real> buf[2][8] = {{c + e1 + e2, c - e1 + e2, c - e1 - e2,
+                             c + e1 - e2}};
+    uint32_t count = 4, cur = 0;
+    for (uint32_t k : {(i + 1) % 3, (i + 2) % 3}) {
+        Real o = a[k].dot(ref.c());
+        count = contact_clip(buf[cur], count, a[k], o + ha[k], buf[cur ^ 1]);
+        cur ^= 1;
+        count = contact_clip(buf[cur], count, vec3<Real>(-a[k]),
+                             ha[k] - o, buf[cur ^ 1]);
+        cur ^= 1;
+    }
+    Real face = n.dot(ref.c()) + ha[i];
+    uint32_t m = 0;
+    for (uint32_t k = 0; k < count; k++) {
+        Real s = n.dot(buf[cur][k]) - face;
+        if (s <= margin)
+            out[m++] = {buf[cur][k] - n * (s / 2), s};
+    }
+    return m;
+}
+// 多于4个点时保留最深的点, 离它最远的点, 以及两侧围成面积最大的点
+template <std::floating_point Real>
+uint32_t contact_reduce(ContactPoint<Real>* p,
+                        uint32_t count,
+                        const vec3<Real>& n) {
+    if (count <= 4)
+        return count;
+    auto pick = [&](uint32_t slot, auto score) {
+        uint32_t best = slot;
+        for (uint32_t k = slot + 1; k < count; k++)
+            if (score(p[k]) > score(p[best]))
+                best = k;
+        std::swap(p[slot], p[best]);
+    };
+    pick(0, [](const ContactPoint<Real>& q) { return -q.separation; });
+    pick(1, [&](const ContactPoint<Real>& q) {
+        return (q.position - p[0].position).squaredNorm();
+    });
+    vec3<Real> e = p[1].position - p[0].position;
+    auto area = [&](const ContactPoint<Real>& q) {
+        return e.cross(q.position - p[0].position).dot(n);
+    };
+    pick(2, area);
+    pick(3, [&](const ContactPoint<Real>& q) { return -area(q); });
+    return area(p[3]) < 0 ? 4 : 3;
+}
+// 盒与盒的接触: 在intersectTest的15个分离轴上求分离距离
+// 距离最大(穿透最浅)的轴为面法线时裁剪入射面, 得到至多4个点
+// 为棱叉积时取两条棱的最近点, 得到1个点; 面轴略优先以保持帧间稳定
+// normal为从A指向B的单位向量; 任一轴的距离超过margin时返回0
+template <std::floating_point Real>
+uint32_t contactOBB(const OBB<Real>& A,
+                    const OBB<Real>& B,
+                    Real margin,
+                    vec3<Real>& normal,
+                    ContactPoint<Real> (&out)[4]) {
+    constexpr Real eps = std::numeric_limits<Real>::epsilon() * 8;
+    const Real tol = margin * Real(0.1) + eps;
+    const vec3<Real> a[3] = {A.u(), A.v(), A.w()};
+    const vec3<Real> b[3] = {B.u(), B.v(), B.w()};
+    const vec3<Real> ha = A.h(), hb = B.h();
+    vec3<Real> d = B.c() - A.c();
+    Real R[3][3], absR[3][3], t[3];
+    Real sepA = -std::numeric_limits<Real>::infinity(), sepB = sepA;
+    Real sepE = sepA;
+    uint32_t faceA = 0, faceB = 0, edgeA = 0, edgeB = 0;
+    vec3<Real> edgeN = vec3<Real>::Zero();
+    for (uint32_t i = 0; i < 3; i++) {
+        t[i] = a[i].dot(d);
+        Real rb = 0;
+        for (uint32_t j = 0; j < 3; j++) {
+            R[i][j] = a[i].dot(b[j]);
+            absR[i][j] = std::abs(R[i][j]) + eps;
+            rb += hb[j] * absR[i][j];
+        }
+        Real s = std::abs(t[i]) - (ha[i] + rb);
+        if (s > margin)
+            return 0;
+        if (s > sepA)
+            sepA = s, faceA = i;
+    }
+    for (uint32_t j = 0; j < 3; j++) {
+        Real tb = t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j];
+        Real ra = ha[0] * absR[0][j] + ha[1] * absR[1][j] + ha[2] * absR[2][j];
+        Real s = std::abs(tb) - (ra + hb[j]);
+        if (s > margin)
+            return 0;
+        if (s > sepB)
+            sepB = s, faceB = j;
+    }
+    for (uint32_t i = 0; i < 3; i++) {
+        uint32_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+        for (uint32_t j = 0; j < 3; j++) {
+            uint32_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+            vec3<Real> L = a[i].cross(b[j]);
+            Real len = L.norm();
+            // 棱接近平行时该轴已由面轴覆盖
+            if (len < Real(1e-3))
+                continue;
+            Real ra = ha[i1] * absR[i2][j] + ha[i2] * absR[i1][j];
+            Real rb = hb[j1] * absR[i][j2] + hb[j2] * absR[i][j1];
+            Real s = (std::abs(t[i2] * R[i1][j] - t[i1] * R[i2][j]) -
+                      (ra + rb)) / len;
+            if (s > margin)
+                return 0;
+            if (s > sepE)
+                sepE = s, edgeA = i, edgeB = j, edgeN = L / len;
+        }
+    }
+    Real sepF = std::max(sepA, sepB);
+    if (sepE > sepF + tol) {
+        if (edgeN.dot(d) < 0)
+            edgeN = -edgeN;
+        // A上沿normal, B上沿-normal最远的棱, 两直线的最近点
+        vec3<Real> pA = A.c(), pB = B.c();
+        for (uint32_t k = 0; k < 3; k++) {
+            if (k != edgeA)
+                pA += a[k] * (edgeN.dot(a[k]) > 0 ? ha[k] : -ha[k]);
+            if (k != edgeB)
+                pB -= b[k] * (edgeN.dot(b[k]) > 0 ? hb[k] : -hb[k]);
+        }
+        const vec3<Real>& u = a[edgeA];
+        const vec3<Real>& v = b[edgeB];
+        vec3<Real> r = pA - pB;
+        Real k = u.dot(v), c = u.dot(r), f = v.dot(r);
+        Real s = std::clamp((k * f - c) / (1 - k * k), -ha[edgeA], ha[edgeA]);
+        Real w = std::clamp(f + s * k, -hb[edgeB], hb[edgeB]);
+        normal = edgeN;
+        out[0] = {(pA + u * s + pB + v * w) / 2, sepE};
+        return 1;
+    }
+    ContactPoint<Real> buf[8];
+    uint32_t count;
+    if (sepB > sepA + tol) {
+        vec3<Real> n = b[faceB];
+        if (n.dot(d) > 0)
+            n = -n;
+        count = contact_face(B, faceB, n, A, margin, buf);
+        normal = -n;
+    } else {
+        vec3<Real> n = t[faceA] < 0 ? vec3<Real>(-a[faceA]) : a[faceA];
+        count = contact_face(A, faceA, n, B, margin, buf);
+        normal = n;
+    }
+    count = contact_reduce(buf, count, normal);
+    std::copy(buf, buf + count, out);
+    return count;
+}
+
+// 盒形刚体的世界: SweepAndPrune粗测, contactOBB生成接触, 并查集划分岛
+// 各岛以顺序冲量法(sequential impulse)在线程池上并行求解
+// 每步: 更新包围盒并提交粗测 -> 并行更新接触流形 -> 划分岛 -> 并行求解与积分
+// 流形在粗测对存在期间保留, 新接触点与旧点位置相近时继承其冲量用于热启动
+template <std::floating_point Scalar = float>
+class RigidWorld {
+   public:
+    using Vec3 = vec3<Scalar>;
+    using Mat3 = mat3<Scalar>;
+    using Quat = Eigen::Quaternion<Scalar>;
+    using Box = AABB<Scalar>;
+    static constexpr uint32_t NULL_NEXT = (~0u);
+    struct Settings {
+        Vec3 gravity = Vec3(0, Scalar(-9.8), 0);
+        uint32_t velocityIterations = 10;
+        Scalar baumgarte = Scalar(0.2);
+        Scalar slop = Scalar(0.005);
+        // 预测接触距离, 包围盒同样扩张此距离
+        Scalar margin = Scalar(0.02);
+        // 新旧接触点在A的局部坐标中距离小于此值时视为同一点
+        Scalar matchDistance = Scalar(0.05);
+        // 相对速度超过此值时才产生反弹
+        Scalar restitutionThreshold = Scalar(1);
+        Scalar linearDamping = Scalar(0.01);
+        Scalar angularDamping = Scalar(0.05);
+    };
+    struct Body {
+        Vec3 position;
+        Quat orientation;
+        Vec3 linearVelocity = Vec3::Zero();
+        Vec3 angularVelocity = Vec3::Zero();
+        Vec3 halfSize;
+        Scalar invMass;
+        Vec3 invInertia;  // 局部坐标系中的惯量的逆(对角)
+        Scalar friction = Scalar(0.6);
+        Scalar restitution = 0;
+        Mat3 invInertiaWorld;
+        uint32_t proxy;
+        bool alive;
+        bool isStatic() const { return invMass == 0; }
+        OBB<Scalar> box() const {
+            Mat3 r = orientation.toRotationMatrix();
+            return {position, r.col(0), r.col(1), halfSize};
+        }
+    };
+    struct Contact {
+        Vec3 position;
+        Vec3 localA;  // 在A局部坐标中的位置, 用于与下一帧的点匹配
+        Scalar separation;
+        Scalar normalImpulse;
+    };
+    // 摩擦作用于接触点的中心: 两个切向与一个绕法线的扭转约束
+    // 比逐点摩擦少2/3的约束, 且不会在各点间留下相互抵消的冲量使堆叠晃动
+    struct Manifold {
+        uint32_t a, b;
+        uint32_t count;
+        Vec3 normal;  // 从a指向b
+        Contact points[4];
+        Scalar tangentImpulse[2], twistImpulse;
+    };
+    Settings settings;
+
+   private:
+    struct SolverBody {
+        Vec3 v, w;
+        Scalar invMass;
+        Mat3 invI;
+    };
+    // 一个速度约束: 相对速度为d·(vB - vA) + jB·wB - jA·wA
+    // iA, iB为惯量的逆乘以jA, jB, 预先求出使迭代中没有矩阵乘法
+    struct SolverRow {
+        Vec3 d, jA, jB, iA, iB;
+        Scalar mass, bias, P;
+    };
+    // rows依次为2个切向, 扭转, 以及count个法向约束
+    struct SolverManifold {
+        uint32_t a, b;  // 岛内局部序号, 0为静止物体
+        uint32_t row, count;
+        Scalar friction, radius;
+    };
+    struct Island {
+        uint32_t bodyBegin, bodyEnd, manifoldBegin, manifoldEnd;
+    };
+    struct Scratch {
+        std::vector<SolverBody> bodies;
+        std::vector<SolverManifold> manifolds;
+        std::vector<SolverRow> rows;
+    };
+    std::vector<Body> bodies;
+    std::vector<uint32_t> freeBodies, pendingFree;
+    SweepAndPrune<uint32_t, Scalar> broadphase;
+    std::vector<Manifold> manifolds;
+    std::unordered_map<uint64_t, uint32_t> manifoldOf;
+    // 每步重建的岛
+    std::vector<uint32_t> parent, islandOf, bodyLocal;
+    std::vector<uint32_t> islandBodies, islandManifolds, order;
+    std::vector<Island> islands;
+    std::vector<Scratch> scratch;
+    uint32_t contactTotal = 0;
+
+    static uint64_t pairKey(uint32_t a, uint32_t b) {
+        if (a > b)
+            std::swap(a, b);
+        return (uint64_t(a) << 32) | b;
+    }
+    Box fatBox(const Body& b, Scalar dt) const {
+        Mat3 r = b.orientation.toRotationMatrix();
+        Vec3 e = r.cwiseAbs() * b.halfSize +
+                 Vec3::Constant(settings.margin);
+        Vec3 move = b.linearVelocity * dt;
+        return {b.position + e + move.cwiseMax(Scalar(0)),
+                b.position - e + move.cwiseMin(Scalar(0))};
+    }
+    static void updateInertia(Body& b) {
+        Mat3 r = b.orientation.toRotationMatrix();
+        b.invInertiaWorld = r * b.invInertia.asDiagonal() * r.transpose();
+    }
+    void removeManifold(uint64_t key) {
+        auto it = manifoldOf.find(key);
+        if (it == manifoldOf.end())
+            return;
+        uint32_t m = it->second;
+        manifoldOf.erase(it);
+        if (m + 1 != manifolds.size()) {
+            manifolds[m] = manifolds.back();
+            manifoldOf[pairKey(manifolds[m].a, manifolds[m].b)] = m;
+        }
+        manifolds.pop_back();
+    }
+    void syncBroadphase(Scalar dt, ThreadPool& pool) {
+        pool.parallel_for(bodies.size(), 1024, [&](uint32_t b, uint32_t e,
+                                                  uint32_t) {
+            for (uint32_t i = b; i < e; i++)
+                if (bodies[i].alive && !bodies[i].isStatic())
+                    broadphase.update(bodies[i].proxy, fatBox(bodies[i], dt));
+        });
+        broadphase.commit();
+        for (const auto& [p, q] : broadphase.removed())
+            removeManifold(pairKey(*p, *q));
+        for (const auto& [p, q] : broadphase.added()) {
+            if (bodies[*p].isStatic() && bodies[*q].isStatic())
+                continue;
+            Manifold m;
+            m.a = *p, m.b = *q, m.count = 0;
+            m.normal = Vec3::Zero();
+            m.tangentImpulse[0] = m.tangentImpulse[1] = m.twistImpulse = 0;
+            manifoldOf[pairKey(m.a, m.b)] = manifolds.size();
+            manifolds.push_back(m);
+        }
+    }
+    void updateManifold(Manifold& m, Scalar dt) const {
+        const Body& A = bodies[m.a];
+        const Body& B = bodies[m.b];
+        Scalar speed = (A.linearVelocity - B.linearVelocity).norm();
+        ContactPoint<Scalar> pts[4];
+        Vec3 n;
+        uint32_t count = contactOBB(A.box(), B.box(),
+                                    settings.margin + speed * dt, n, pts);
+        Quat inv = A.orientation.conjugate();
+        Scalar tol2 = settings.matchDistance * settings.matchDistance;
+        Contact next[4];
+        for (uint32_t k = 0; k < count; k++) {
+            Contact& c = next[k];
+            c.position = pts[k].position;
+            c.localA = inv * (c.position - A.position);
+            c.separation = pts[k].separation;
+            c.normalImpulse = 0;
+            Scalar best = tol2;
+            for (uint32_t o = 0; o < m.count; o++) {
+                Scalar d2 = (m.points[o].localA - c.localA).squaredNorm();
+                if (d2 < best) {
+                    best = d2;
+                    c.normalImpulse = m.points[o].normalImpulse;
+                }
+            }
+        }
+        if (count == 0 || m.count == 0)
+            m.tangentImpulse[0] = m.tangentImpulse[1] = m.twistImpulse = 0;
+        m.count = count;
+        m.normal = n;
+        std::copy(next, next + count, m.points);
+    }
+    uint32_t find(uint32_t i) {
+        while (parent[i] != i)
+            i = parent[i] = parent[parent[i]];
+        return i;
+    }
+    // 以接触的动态物体划分岛, 静止物体不连接不同的岛
+    void buildIslands() {
+        uint32_t n = bodies.size();
+        parent.resize(n);
+        std::iota(parent.begin(), parent.end(), 0u);
+        contactTotal = 0;
+        for (const Manifold& m : manifolds) {
+            contactTotal += m.count;
+            if (m.count == 0 || bodies[m.a].isStatic() ||
+                bodies[m.b].isStatic())
+                continue;
+            uint32_t ra = find(m.a), rb = find(m.b);
+            if (ra != rb)
+                parent[std::max(ra, rb)] = std::min(ra, rb);
+        }
+        // 计数排序, 将物体与流形按岛连续存放
+        islandOf.assign(n, NULL_NEXT);
+        islands.clear();
+        for (uint32_t i = 0; i < n; i++) {
+            if (!bodies[i].alive || bodies[i].isStatic())
+                continue;
+            uint32_t r = find(i);
+            if (islandOf[r] == NULL_NEXT) {
+                islandOf[r] = islands.size();
+                islands.push_back({0, 0, 0, 0});
+            }
+            islands[islandOf[r]].bodyEnd++;
+        }
+        for (const Manifold& m : manifolds)
+            if (m.count != 0)
+                islands[islandOf[find(dynamicOf(m))]].manifoldEnd++;
+        uint32_t bodySum = 0, manifoldSum = 0;
+        for (Island& is : islands) {
+            is.bodyBegin = bodySum, bodySum += is.bodyEnd;
+            is.manifoldBegin = manifoldSum, manifoldSum += is.manifoldEnd;
+            is.bodyEnd = is.bodyBegin;
+            is.manifoldEnd = is.manifoldBegin;
+        }
+        islandBodies.resize(bodySum);
+        islandManifolds.resize(manifoldSum);
+        for (uint32_t i = 0; i < n; i++)
+            if (bodies[i].alive && !bodies[i].isStatic())
+                islandBodies[islands[islandOf[find(i)]].bodyEnd++] = i;
+        for (uint32_t k = 0; k < manifolds.size(); k++) {
+            const Manifold& m = manifolds[k];
+            if (m.count != 0)
+                islandManifolds[islands[islandOf[find(dynamicOf(m))]]
+                                    .manifoldEnd++] = k;
+        }
+        // 大岛先求解, 使各线程的负载接近
+        order.resize(islands.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(), [&](uint32_t x, uint32_t y) {
+            return islands[x].manifoldEnd - islands[x].manifoldBegin >
+                   islands[y].manifoldEnd - islands[y].manifoldBegin;
+        });
+    }
+    uint32_t dynamicOf(const Manifold& m) const {
+        return bodies[m.a].isStatic() ? m.b : m.a;
+    }
+    static Scalar relative(const SolverBody& A,
+                           const SolverBody& B,
+                           const SolverRow& r) {
+        return r.d.dot(B.v - A.v) + r.jB.dot(B.w) - r.jA.dot(A.w);
+    }
+    static void apply(SolverBody& A,
+                      SolverBody& B,
+                      const SolverRow& r,
+                      Scalar P) {
+        A.v -= r.d * (A.invMass * P);
+        A.w -= r.iA * P;
+        B.v += r.d * (B.invMass * P);
+        B.w += r.iB * P;
+    }
+    // 构造约束行, 并以上一帧的冲量P对A, B热启动
+    static SolverRow makeRow(SolverBody& A,
+                             SolverBody& B,
+                             const Vec3& d,
+                             const Vec3& jA,
+                             const Vec3& jB,
+                             Scalar P) {
+        SolverRow r{d, jA, jB, A.invI * jA, B.invI * jB, 0, 0, P};
+        Scalar k = (A.invMass + B.invMass) * d.squaredNorm() + jA.dot(r.iA) +
+                   jB.dot(r.iB);
+        r.mass = k > 0 ? 1 / k : Scalar(0);
+        apply(A, B, r, P);
+        return r;
+    }
+    void solveIsland(const Island& is, Scratch& s, Scalar dt) {
+        const Settings& cfg = settings;
+        uint32_t bodyCount = is.bodyEnd - is.bodyBegin;
+        s.bodies.resize(bodyCount + 1);
+        s.bodies[0] = {Vec3::Zero(), Vec3::Zero(), 0, Mat3::Zero()};
+        Scalar linDamp = 1 / (1 + dt * cfg.linearDamping);
+        Scalar angDamp = 1 / (1 + dt * cfg.angularDamping);
+        for (uint32_t k = 0; k < bodyCount; k++) {
+            uint32_t i = islandBodies[is.bodyBegin + k];
+            const Body& b = bodies[i];
+            bodyLocal[i] = k + 1;
+            s.bodies[k + 1] = {(b.linearVelocity + cfg.gravity * dt) * linDamp,
+                               b.angularVelocity * angDamp, b.invMass,
+                               b.invInertiaWorld};
+        }
+        auto local = [&](uint32_t i) {
+            return bodies[i].isStatic() ? 0u : bodyLocal[i];
+        };
+        // 准备约束并热启动
+        s.manifolds.clear();
+        s.rows.clear();
+        for (uint32_t k = is.manifoldBegin; k < is.manifoldEnd; k++) {
+            const Manifold& m = manifolds[islandManifolds[k]];
+            const Body& A = bodies[m.a];
+            const Body& B = bodies[m.b];
+            SolverManifold sm;
+            sm.a = local(m.a), sm.b = local(m.b);
+            sm.row = s.rows.size(), sm.count = m.count;
+            sm.friction = std::sqrt(A.friction * B.friction);
+            SolverBody& sa = s.bodies[sm.a];
+            SolverBody& sb = s.bodies[sm.b];
+            Scalar restitution = std::max(A.restitution, B.restitution);
+            Vec3 n = m.normal, t0;
+            if (std::abs(n.x()) >= Scalar(0.57735))
+                t0 = Vec3(n.y(), -n.x(), 0).normalized();
+            else
+                t0 = Vec3(0, n.z(), -n.y()).normalized();
+            Vec3 t1 = n.cross(t0);
+            Vec3 center = Vec3::Zero();
+            for (uint32_t p = 0; p < m.count; p++)
+                center += m.points[p].position;
+            center /= Scalar(m.count);
+            sm.radius = 0;
+            for (uint32_t p = 0; p < m.count; p++)
+                sm.radius += (m.points[p].position - center).norm();
+            sm.radius /= Scalar(m.count);
+            Vec3 rA = center - A.position, rB = center - B.position;
+            s.rows.push_back(makeRow(sa, sb, t0, rA.cross(t0), rB.cross(t0),
+                                     m.tangentImpulse[0]));
+            s.rows.push_back(makeRow(sa, sb, t1, rA.cross(t1), rB.cross(t1),
+                                     m.tangentImpulse[1]));
+            s.rows.push_back(
+                makeRow(sa, sb, Vec3::Zero(), n, n, m.twistImpulse));
+            for (uint32_t p = 0; p < m.count; p++) {
+                const Contact& c = m.points[p];
+                rA = c.position - A.position, rB = c.position - B.position;
+                SolverRow r = makeRow(sa, sb, n, rA.cross(n), rB.cross(n),
+                                      c.normalImpulse);
+                // 分离时只允许接近到接触, 穿透时以Baumgarte项推出
+                if (c.separation > 0)
+                    r.bias = -c.separation / dt;
+                else
+                    r.bias = cfg.baumgarte / dt *
+                             std::max(-c.separation - cfg.slop, Scalar(0));
+                Scalar vn = relative(sa, sb, r);
+                if (restitution > 0 && vn < -cfg.restitutionThreshold)
+                    r.bias = std::max(r.bias, -restitution * vn);
+                s.rows.push_back(r);
+            }
+            s.manifolds.push_back(sm);
+        }
+        for (uint32_t it = 0; it < cfg.velocityIterations; it++) {
+            for (const SolverManifold& sm : s.manifolds) {
+                SolverBody& sa = s.bodies[sm.a];
+                SolverBody& sb = s.bodies[sm.b];
+                SolverRow* rows = s.rows.data() + sm.row;
+                Scalar sumN = 0;
+                for (uint32_t p = 0; p < sm.count; p++)
+                    sumN += rows[3 + p].P;
+                for (uint32_t k = 0; k < 3; k++) {
+                    SolverRow& r = rows[k];
+                    Scalar maxF = sm.friction * sumN * (k == 2 ? sm.radius : 1);
+                    Scalar P = std::clamp(r.P - r.mass * relative(sa, sb, r),
+                                          -maxF, maxF);
+                    apply(sa, sb, r, P - r.P);
+                    r.P = P;
+                }
+                for (uint32_t p = 0; p < sm.count; p++) {
+                    SolverRow& r = rows[3 + p];
+                    Scalar P = std::max(
+                        r.P - r.mass * (relative(sa, sb, r) - r.bias),
+                        Scalar(0));
+                    apply(sa, sb, r, P - r.P);
+                    r.P = P;
+                }
+            }
+        }
+        // 写回冲量与速度, 并积分位置
+        for (uint32_t k = is.manifoldBegin; k < is.manifoldEnd; k++) {
+            Manifold& m = manifolds[islandManifolds[k]];
+            const SolverRow* rows =
+                s.rows.data() + s.manifolds[k - is.manifoldBegin].row;
+            m.tangentImpulse[0] = rows[0].P;
+            m.tangentImpulse[1] = rows[1].P;
+            m.twistImpulse = rows[2].P;
+            for (uint32_t p = 0; p < m.count; p++)
+                m.points[p].normalImpulse = rows[3 + p].P;
+        }
+        for (uint32_t k = 0; k < bodyCount; k++) {
+            Body& b = bodies[islandBodies[is.bodyBegin + k]];
+            const SolverBody& sb = s.bodies[k + 1];
+            b.linearVelocity = sb.v;
+            b.angularVelocity = sb.w;
+            b.position += sb.v * dt;
+            Vec3 hw = sb.w * (dt / 2);
+            Quat dq(0, hw.x(), hw.y(), hw.z());
+            b.orientation.coeffs() += (dq * b.orientation).coeffs();
+            b.orientation.normalize();
+            updateInertia(b);
+        }
+    }
+
+   public:
+    // mass为0时为静止物体, 不受力且不移动
+    uint32_t addBox(const Vec3& halfSize,
+                    const Vec3& position,
+                    Scalar mass,
+                    const Quat& orientation = Quat::Identity()) {
+        Body b;
+        b.position = position;
+        b.orientation = orientation.normalized();
+        b.halfSize = halfSize;
+        b.invMass = mass > 0 ? 1 / mass : 0;
+        if (mass > 0) {
+            Vec3 s = (halfSize * 2).cwiseAbs2();
+            b.invInertia = Vec3(s.y() + s.z(), s.x() + s.z(), s.x() + s.y())
+                               .cwiseInverse() *
+                           (12 / mass);
+        } else {
+            b.invInertia = Vec3::Zero();
+        }
+        b.alive = true;
+        updateInertia(b);
+        b.proxy = broadphase.insert(fatBox(b, 0));
+        uint32_t id;
+        if (freeBodies.empty()) {
+            id = bodies.size();
+            bodies.push_back(b);
+        } else {
+            id = freeBodies.back();
+            freeBodies.pop_back();
+            bodies[id] = b;
+        }
+        broadphase.data(b.proxy) = id;
+        return id;
+    }
+    // 相关的接触在下次step时移除, id在其后才被复用
+    void removeBody(uint32_t id) {
+        bodies[id].alive = false;
+        broadphase.drop(bodies[id].proxy);
+        pendingFree.push_back(id);
+    }
+    Body& body(uint32_t id) { return bodies[id]; }
+    const Body& body(uint32_t id) const { return bodies[id]; }
+    // 静止物体移动后需调用, 使其包围盒更新
+    void touch(uint32_t id) {
+        updateInertia(bodies[id]);
+        broadphase.update(bodies[id].proxy, fatBox(bodies[id], 0));
+    }
+    uint32_t bodyCount() const {
+        return bodies.size() - freeBodies.size() - pendingFree.size();
+    }
+    uint32_t manifoldCount() const { return manifolds.size(); }
+    uint32_t contactCount() const { return contactTotal; }
+    uint32_t islandCount() const { return islands.size(); }
+    const std::vector<Manifold>& getManifolds() const { return manifolds; }
+
+    void step(Scalar dt, ThreadPool& pool = default_thread_pool()) {
+        if (dt <= 0)
+            return;
+        syncBroadphase(dt, pool);
+        freeBodies.insert(freeBodies.end(), pendingFree.begin(),
+                          pendingFree.end());
+        pendingFree.clear();
+        pool.parallel_for(manifolds.size(), 64, [&](uint32_t b, uint32_t e,
+                                                    uint32_t) {
+            for (uint32_t i = b; i < e; i++)
+                updateManifold(manifolds[i], dt);
+        });
+        buildIslands();
+        bodyLocal.resize(bodies.size());
+        scratch.resize(pool.size());
+        // 按order动态领取岛
+        std::atomic<uint32_t> cursor = 0;
+        pool.parallel_for(pool.size(), 1, [&](uint32_t, uint32_t,
+                                              uint32_t slot) {
+            for (uint32_t i; (i = cursor.fetch_add(1)) < order.size();)
+                solveIsland(islands[order[i]], scratch[slot], dt);
+        });
+    }
+};
+}  // namespace BL::Math
+#endif  //!_BOUNDLESS_RIGID_BODY_CXX_HPP_
@@ -0,0 +1,231 @@
+#ifndef _BOUNDLESS_SWEEP_PRUNE_CXX_HPP_
+#define _BOUNDLESS_SWEEP_PRUNE_CXX_HPP_
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "bl_collision.hpp"
+namespace BL::Math {
+// 排序扫描(Sweep and Prune)粗测: 每轴保存全部对象min/max端点的有序数组
+// 对象逐帧移动不大时端点顺序变化很少, 插入排序接近O(n)
+// 耗时随每帧越过的端点数增长, 移动距离远小于对象间距时才明显快于OctTree
+// 排序中端点相互越过即为该轴上重叠的开始或结束, 据此增量维护重叠对
+// insert/update/drop先记录, commit后added/removed为本次新增和消失的对
+template <typename T, std::floating_point Scalar = float>
+class SweepAndPrune {
+   public:
+    using Box = AABB<Scalar>;
+    using PairList = std::vector<std::pair<T*, T*>>;
+    static constexpr uint32_t NULL_NEXT = (~0u);
+    // 新插入的对象多于现有对象的1/REBUILD_RATIO时, 整体排序重建而非插入排序
+    static constexpr uint32_t REBUILD_RATIO = 8;
+
+   private:
+    struct Endpoint {
+        Scalar value;
+        uint32_t id;  // 句柄 << 1 | (是否为max端)
+    };
+    struct Object {
+        Box objectBox;
+        bool alive;
+        T data;
+    };
+    std::vector<Object> objects;  // 以句柄为下标
+    std::vector<uint32_t> freeHandles, inserted, dropped;
+    std::array<std::vector<Endpoint>, 3> axes;
+    std::unordered_set<uint64_t> pairs;  // 当前重叠的对, 见pairKey
+    std::vector<uint64_t> addedKeys, removedKeys;
+    PairList addedPairs, removedPairs;
+    uint32_t liveCount = 0;
+
+    static uint64_t pairKey(uint32_t a, uint32_t b) {
+        if (a > b)
+            std::swap(a, b);
+        return (uint64_t(a) << 32) | b;
+    }
+    // 值相同时min端在前, 使相接触的对象也算重叠, 与intersectTest一致
+    static bool less(const Endpoint& a, const Endpoint& b) {
+        return a.value < b.value ||
+               (a.value == b.value && (a.id & 1) < (b.id & 1));
+    }
+    bool overlap(uint32_t a, uint32_t b) const {
+        return intersectTest(objects[a].objectBox, objects[b].objectBox) !=
+               CollisionResult::outer;
+    }
+    void refresh(uint32_t k) {
+        for (Endpoint& e : axes[k]) {
+            const Box& b = objects[e.id >> 1].objectBox;
+            e.value = (e.id & 1) ? b.max()[k] : b.min()[k];
+        }
+    }
+    // 插入排序轴k, 端点e左移越过f时:
+    // e为min, f为max: 两者在该轴上开始重叠, 若各轴都重叠则新增
+    // e为max, f为min: 两者在该轴上分离, 若存在则移除
+    void sortAxis(uint32_t k) {
+        std::vector<Endpoint>& a = axes[k];
+        for (size_t i = 1; i < a.size(); i++) {
+            Endpoint e = a[i];
+            size_t j = i;
+            while (j > 0 && less(e, a[j - 1])) {
+                const Endpoint& f = a[j - 1];
+                uint32_t eh = e.id >> 1, fh = f.id >> 1;
+                if (eh != fh) {
+                    if (!(e.id & 1) && (f.id & 1)) {
+                        if (overlap(eh, fh) &&
+                            pairs.insert(pairKey(eh, fh)).second)
+                            addedKeys.push_back(pairKey(eh, fh));
+                    } else if ((e.id & 1) && !(f.id & 1)) {
+                        if (pairs.erase(pairKey(eh, fh)))
+                            removedKeys.push_back(pairKey(eh, fh));
+                    }
+                }
+                a[j] = f;
+                j--;
+            }
+            a[j] = e;
+        }
+    }
+    // 整体排序并沿x轴扫描求出全部重叠对, 与原有的对比较得出增删
+    void rebuild() {
+        for (uint32_t k = 0; k < 3; k++) {
+            refresh(k);
+            std::sort(axes[k].begin(), axes[k].end(), less);
+        }
+        std::unordered_set<uint64_t> current;
+        current.reserve(pairs.size());
+        std::vector<uint32_t> active, activeSlot(objects.size());
+        for (const Endpoint& e : axes[0]) {
+            uint32_t h = e.id >> 1;
+            if (e.id & 1) {
+                uint32_t s = activeSlot[h];
+                activeSlot[active.back()] = s;
+                active[s] = active.back();
+                active.pop_back();
+                continue;
+            }
+            for (uint32_t o : active)
+                if (overlap(h, o))
+                    current.insert(pairKey(h, o));
+            activeSlot[h] = active.size();
+            active.push_back(h);
+        }
+        for (uint64_t key : current)
+            if (!pairs.count(key))
+                addedKeys.push_back(key);
+        for (uint64_t key : pairs)
+            if (!current.count(key))
+                removedKeys.push_back(key);
+        pairs = std::move(current);
+    }
+    void toPairs(const std::vector<uint64_t>& keys, PairList& out) {
+        out.clear();
+        out.reserve(keys.size());
+        for (uint64_t key : keys)
+            out.push_back({&objects[key >> 32].data,
+                           &objects[uint32_t(key)].data});
+    }
+
+   public:
+    void clear() {
+        objects.clear();
+        freeHandles.clear();
+        inserted.clear();
+        dropped.clear();
+        for (auto& a : axes)
+            a.clear();
+        pairs.clear();
+        addedKeys.clear();
+        removedKeys.clear();
+        addedPairs.clear();
+        removedPairs.clear();
+        liveCount = 0;
+    }
+    uint32_t size() const { return liveCount; }
+    uint32_t pairCount() const { return pairs.size(); }
+    T& data(uint32_t h) { return objects[h].data; }
+    const Box& box(uint32_t h) const { return objects[h].objectBox; }
+    // 返回对象句柄, 在commit后参与配对
+    uint32_t insert(const Box& size) {
+        uint32_t h;
+        if (freeHandles.empty()) {
+            h = objects.size();
+            objects.emplace_back();
+        } else {
+            h = freeHandles.back();
+            freeHandles.pop_back();
+        }
+        objects[h].objectBox = size;
+        objects[h].alive = true;
+        inserted.push_back(h);
+        liveCount++;
+        return h;
+    }
+    // 在commit时移除, 其所在的对计入removed, 句柄随后可被复用
+    void drop(uint32_t h) {
+        objects[h].alive = false;
+        dropped.push_back(h);
+        liveCount--;
+    }
+    void update(uint32_t h, const Box& size) { objects[h].objectBox = size; }
+    void move(uint32_t h, const vec3<Scalar>& dir) {
+        const Box& b = objects[h].objectBox;
+        update(h, {b.max() + dir, b.min() + dir});
+    }
+    // 应用insert/update/drop并更新重叠对
+    void commit() {
+        addedKeys.clear();
+        removedKeys.clear();
+        if (!dropped.empty()) {
+            for (auto& a : axes)
+                std::erase_if(a, [&](const Endpoint& e) {
+                    return !objects[e.id >> 1].alive;
+                });
+            std::erase_if(pairs, [&](uint64_t key) {
+                if (objects[key >> 32].alive && objects[uint32_t(key)].alive)
+                    return false;
+                removedKeys.push_back(key);
+                return true;
+            });
+        }
+        uint32_t added = 0;
+        for (uint32_t h : inserted) {
+            if (!objects[h].alive)
+                continue;
+            for (auto& a : axes) {
+                a.push_back({0, h << 1});
+                a.push_back({0, (h << 1) | 1});
+            }
+            added++;
+        }
+        // 新端点位于各轴末尾, 即视为与所有对象都不重叠, 排序时逐个越过
+        if (uint64_t(added) * REBUILD_RATIO > liveCount)
+            rebuild();
+        else
+            for (uint32_t k = 0; k < 3; k++) {
+                refresh(k);
+                sortAxis(k);
+            }
+        inserted.clear();
+        // 被删除对象的数据在复用句柄前保持有效, 供removed引用
+        toPairs(addedKeys, addedPairs);
+        toPairs(removedKeys, removedPairs);
+        freeHandles.insert(freeHandles.end(), dropped.begin(), dropped.end());
+        dropped.clear();
+    }
+    // 上次commit新增/消失的对, 指针在下次insert前有效
+    const PairList& added() const { return addedPairs; }
+    const PairList& removed() const { return removedPairs; }
+    // 收集当前全部重叠的对, 与OctTree::collectPairs的接口相同
+    void collectPairs(PairList& out) {
+        out.clear();
+        out.reserve(pairs.size());
+        for (uint64_t key : pairs)
+            out.push_back({&objects[key >> 32].data,
+                           &objects[uint32_t(key)].data});
+    }
+};
+}  // namespace BL::Math
+#endif  //!_BOUNDLESS_SWEEP_PRUNE_CXX_HPP_
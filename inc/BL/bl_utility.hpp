@@ -3,7 +3,7 @@
 #include <zlib.h>
 #include <cstdint>
 #include <cstdlib>
-#include <log.hpp>
+#include "bl_log.hpp"
 namespace BL {
 struct compressed_data {
     uint32_t real_size;
@@ -21,7 +21,7 @@ struct ShaderFileHead {
     uint32_t partCount;
     Part parts[];
 };
-const uint32_t MESH_HEAD_CODE = 0x240720FE;
+const uint32_t MESH_HEAD_CODE = 0x261017FE;  // 加入包围体后更新
 struct MeshFileHead {
     struct VertexAttr {
         alignas(4) VkFormat format;
@@ -48,6 +48,12 @@ struct MeshFileHead {
 
     Range vertexBuffers;  // 指向一些BufferInfo
     Range indexBuffer;    // 指向索引缓冲， 压缩
+    // 顶点位置的包围体, 离线生成, 运行时剔除无需读取顶点
+    struct Bounds {
+        float aabbMax[3], aabbMin[3];
+        float sphereCenter[3], sphereRadius;
+        float obbCenter[3], obbU[3], obbV[3], obbHalf[3];
+    } bounds;
 
     std::string getName() {
         std::string res;
@@ -1,110 +1,136 @@
 #ifndef _BOUNDLESS_INTERSECT_CXX_FILE_
 #define _BOUNDLESS_INTERSECT_CXX_FILE_
-#include <limits>
-#include "bl_math_types.hpp"
+#include "bl_collision.hpp"
 namespace BL {
+/*
+ * 旧接口, 类型与实现统一到bl_collision.hpp的BL::Math中
+ * AABB以max/min存储, 构造为{max, min}; 不再有c与半长的存储
+ * 射线测试的语义与Math::intersectRay不同, 保留旧实现以保持结果不变
+ */
+using AABB = Math::AABB<float>;
+using OBB = Math::OBB<float>;
+using Plane = Math::Plane<float>;
+using Sphere = Math::Sphere<float>;
+enum FrustumPlaneIndex { left = 0, right, top, bottom, near, far };
 const float ϵ = 1e-20;
-bool intersect_ray_sphere(const vec3f& o,
-                          const vec3f& d,
-                          const vec3f& c,
-                          float r);
-bool intersect_ray_sphere_res(const vec3f& o,
-                              const vec3f& d,
-                              const vec3f& c,
-                              float r,
-                              float* t);
-class OBB {
-    vec3f _c, _u, _v, _h;
-
-   public:
-    vec3f c() const { return _c; }
-    vec3f u() const { return _u; }
-    vec3f v() const { return _v; }
-    vec3f w() const { return _u.cross(_v); }
-    vec3f h() const { return _h; }
-    float h_u() const { return _h.x(); }
-    float h_v() const { return _h.y(); }
-    float h_w() const { return _h.z(); }
-
-    void set_c(const vec3f& new_c) { _c = new_c; }
-    void set_size(const vec3f& x, const vec3f& y, float h_z) {
-        _h.x() = x.norm();
-        _u = x / _h.x();
-        _h.y() = y.norm();
-        _v = y / _h.y();
-        _h.z() = h_z;
+// 球只在起点位于球内且球心在前方时命中, t为离开距离
+// 盒: 起点在盒内时t为离开距离; AABB测试整条直线, 盒在起点后方也命中
+inline bool intersect_ray_sphere_res(const vec3f& o,
+                                     const vec3f& d,
+                                     const vec3f& c,
+                                     float r,
+                                     float* t) {
+    vec3f l = c - o;
+    float s = l.dot(d);
+    float l2 = l.dot(l);
+    float r2 = r * r;
+    if (s < 0.0f || l2 > r2)
+        return false;
+    float m2 = l2 - s * s;
+    if (m2 > r2)
+        return false;
+    *t = s + std::sqrt(r2 - m2);
+    return true;
+}
+inline bool intersect_ray_sphere(const vec3f& o,
+                                 const vec3f& d,
+                                 const vec3f& c,
+                                 float r) {
+    float t;
+    return intersect_ray_sphere_res(o, d, c, r, &t);
+}
+// 一个轴上的slab, 相对起点的区间为[lo, hi], f为方向在该轴上的分量
+// 方向与该轴近似垂直时只判断起点是否在区间内
+inline bool legacy_ray_slab(float lo, float hi, float f, float& t0, float& t1) {
+    if (std::abs(f) < ϵ)
+        return lo <= 0.0f && hi >= 0.0f;
+    float f_i = 1.0f / f;
+    float a = lo * f_i, b = hi * f_i;
+    if (a > b)
+        std::swap(a, b);
+    t0 = std::max(a, t0);
+    t1 = std::min(b, t1);
+    return t0 <= t1;
+}
+inline bool intersect_ray_OBB_res(const vec3f& o,
+                                  const vec3f& d,
+                                  const OBB& A,
+                                  float* t) {
+    float t0 = -std::numeric_limits<float>::infinity();
+    float t1 = std::numeric_limits<float>::infinity();
+    vec3f p = A.c() - o;
+    vec3f axes[3] = {A.u(), A.v(), A.w()};
+    for (uint32_t k = 0; k < 3; k++) {
+        float e = p.dot(axes[k]);
+        if (!legacy_ray_slab(e - A.h()[k], e + A.h()[k], d.dot(axes[k]), t0,
+                             t1) ||
+            t1 < 0.0f)
+            return false;
     }
-};
-bool intersect_ray_OBB_res(const vec3f& o,
-                           const vec3f& d,
-                           const OBB& A,
-                           float* t);
+    *t = t0 > 0.0f ? t0 : t1;
+    return true;
+}
 inline bool intersect_ray_OBB(const vec3f& o, const vec3f& d, const OBB& A) {
     float t;
     return intersect_ray_OBB_res(o, d, A, &t);
 }
-class AABB {
-    vec3f _c, _s;
-
-   public:
-    vec3f c() const { return _c; }
-    vec3f u() const { return vec3f::UnitX(); }
-    vec3f v() const { return vec3f::UnitY(); }
-    vec3f w() const { return vec3f::UnitZ(); }
-    vec3f h() const { return _s; }
-    float h_u() const { return _s.x(); }
-    float h_v() const { return _s.y(); }
-    float h_w() const { return _s.z(); }
-    vec3f max() const { return _c + _s; }
-    vec3f min() const { return _c - _s; }
-
-    void set_c(const vec3f& new_c) { _c = new_c; }
-    void set_size(const vec3f& new_s) { _s = new_s; }
-};
-bool intersect_ray_AABB_res(const vec3f& o,
-                            const vec3f& d,
-                            const AABB& A,
-                            float* t);
+inline bool intersect_ray_AABB_res(const vec3f& o,
+                                   const vec3f& d,
+                                   const AABB& A,
+                                   float* t) {
+    float t0 = -std::numeric_limits<float>::infinity();
+    float t1 = std::numeric_limits<float>::infinity();
+    for (uint32_t k = 0; k < 3; k++)
+        if (!legacy_ray_slab(A.min()[k] - o[k], A.max()[k] - o[k], d[k], t0,
+                             t1))
+            return false;
+    *t = t0 > 0.0f ? t0 : t1;
+    return true;
+}
 inline bool intersect_ray_AABB(const vec3f& o, const vec3f& d, const AABB& A) {
     float t;
     return intersect_ray_AABB_res(o, d, A, &t);
 }
-// 结果：0相交，+1在面内，-1在面外，n为单位向量，以法线方向为面外
-int intersect_plane_AABB(const vec3f& n, float d, const AABB& A);
-int intersect_plane_OBB(const vec3f& n, float d, const OBB& A);
-
-bool intersect_sphere_AABB(const vec3f& c, float r, const AABB& A);
-bool intersect_AABB(const AABB& A, const AABB& B);
-struct Plane {
-    vec3f n;
-    float d;
-
-    // 自动归一化向量，无需提前进行
-    void set(const vec3f& nn, float nd) {
-        float len = nn.norm();
-        n = nn / len;
-        d = nd / len;
-    }
-    void norm() {
-        float len = n.norm();
-        n = n / len;
-        d = d / len;
-    }
-    void set_nonorm(const vec3f& nn, float nd) {
-        n = nn;
-        d = nd;
-    }
-};
-enum FrustumPlaneIndex { left = 0, right, top, bottom, near, far };
-void spawn_frustum_plane(std::array<Plane, 6>& planes, const mat4f& vp_mat);
+// 结果：0相交，+1在面内，-1在面外，以法线方向为面外
+inline int to_plane_side(Math::CollisionResult r) {
+    return r == Math::CollisionResult::outer   ? -1
+           : r == Math::CollisionResult::inner ? +1
+                                               : 0;
+}
 inline int intersect_plane_AABB(const Plane& p, const AABB& A) {
-    return intersect_plane_AABB(p.n, p.d, A);
+    return to_plane_side(Math::intersectTest(p, A));
 }
 inline int intersect_plane_OBB(const Plane& p, const OBB& A) {
-    return intersect_plane_OBB(p.n, p.d, A);
+    return to_plane_side(Math::intersectTest(p, A));
+}
+// n为单位向量, 平面为n.dot(x) + d = 0
+inline int intersect_plane_AABB(const vec3f& n, float d, const AABB& A) {
+    Plane p;
+    p.set_nonorm(n, d);
+    return intersect_plane_AABB(p, A);
+}
+inline int intersect_plane_OBB(const vec3f& n, float d, const OBB& A) {
+    Plane p;
+    p.set_nonorm(n, d);
+    return intersect_plane_OBB(p, A);
+}
+inline bool intersect_sphere_AABB(const vec3f& c, float r, const AABB& A) {
+    return Math::intersectSphere(c, r, A);
+}
+inline bool intersect_AABB(const AABB& A, const AABB& B) {
+    return Math::intersectTest(A, B) != Math::CollisionResult::outer;
+}
+inline void spawn_frustum_plane(std::array<Plane, 6>& planes,
+                                const mat4f& vp_mat) {
+    Math::spawnFrustumPlanes(vp_mat, planes);
+}
+inline bool intersect_frustum_planes_AABB(const std::array<Plane, 6>& ps,
+                                          const AABB& A) {
+    return Math::intersectFrustum(ps, A) != Math::CollisionResult::outer;
+}
+inline bool intersect_frustum_planes_OBB(const std::array<Plane, 6>& ps,
+                                         const OBB& A) {
+    return Math::intersectFrustum(ps, A) != Math::CollisionResult::outer;
 }
-bool intersect_frustum_planes_AABB(const std::array<Plane, 6>& ps,
-                                   const AABB& A);
-bool intersect_frustum_planes_OBB(const std::array<Plane, 6>& ps, const OBB& A);
 }  // namespace BL
-#endif  //!_BOUNDLESS_INTERSECT_CXX_FILE_
\ No newline at end of file
+#endif  //!_BOUNDLESS_INTERSECT_CXX_FILE_
@@ -2,6 +2,7 @@
 #define BOUNDLESS_MESH_FILE
 #include <fstream>
 #include <string>
+#include "bl_mesh_bounds.hpp"
 #include "ftypes.hpp"
 #include "render.hpp"
 #include "log.hpp"
@@ -17,6 +18,10 @@ struct MeshInfo {
     bool restartEnable;
     std::vector<VkVertexInputBindingDescription> inputBindings;
     std::vector<VkVertexInputAttributeDescription> inputAttributes;
+    // 顶点位置的包围体, 从文件头读取
+    Math::AABB<float> boundBox;
+    Math::Sphere<float> boundSphere;
+    Math::OBB<float> boundOBB;
 };
 class Mesh {
     std::string name;
@@ -34,6 +39,11 @@ class Mesh {
               uint32_t baseBinding = 0);
 };
 void copy_mesh_info(MeshFileHead* pFileData,MeshInfo* info);
+// 按inputAttributes中location处的属性(须为3或4个float)描述顶点位置
+// data为该属性所在binding的顶点数据, 格式不符时返回空的流
+Math::PointStream position_stream(const MeshInfo& info,
+                                  const void* data,
+                                  uint32_t location = 0);
 void read_buffer_info_list(
     MeshFileHead* pHead,
     std::ifstream& inFile,
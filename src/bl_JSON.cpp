@@ -1,12 +1,50 @@
 #include "bl_JSON.hpp"
+#include <algorithm>
+#include <bit>
 #include <charconv>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <optional>
 #include <regex>
 #include <sstream>
+// x86-64上SSE2总是可用, AVX2按运行时检测选择
+// 定义BL_JSON_NO_SIMD以强制使用标量实现
+#if !defined(BL_JSON_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define BL_JSON_SIMD_DISPATCH
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BL_JSON_TARGET_AVX2
+#define BL_JSON_INLINE_AVX2 __forceinline
+#else
+#define BL_JSON_TARGET_AVX2 __attribute__((target("avx2")))
+// 块内的比较需内联到扫描循环中
+#define BL_JSON_INLINE_AVX2 \
+    __attribute__((target("avx2"), always_inline)) inline
+#endif
+#endif
 
 namespace BL::JSON {
+#if defined(BL_JSON_SIMD_DISPATCH)
+bool json_avx2_supported() {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7)
+        return false;
+    __cpuid(r, 1);
+    // OSXSAVE, AVX, 系统保存YMM寄存器
+    if (!(r[2] & (1 << 27)) || !(r[2] & (1 << 28)) || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(r, 7, 0);
+    return r[1] & (1 << 5);
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
 std::optional<int64_t> try_parse_integer(const char* begin, const char* end) {
     int64_t val;
     int base, offset, neg = 1;
@@ -62,29 +100,31 @@ char from_unescaped_char(char c) {
 }
 int to_escaped_char(int c) {
     switch (c) {
+        case '\"':
+            return ('\\' << 8) + '\"';
         case '\\':
-            return '\\' << 8 + '\\';
+            return ('\\' << 8) + '\\';
         case '\n':
-            return '\\' << 8 + 'n';
+            return ('\\' << 8) + 'n';
         case '\r':
-            return '\\' << 8 + 'r';
+            return ('\\' << 8) + 'r';
         case '\0':
-            return '\\' << 8 + '0';
+            return ('\\' << 8) + '0';
         case '\t':
-            return '\\' << 8 + 't';
+            return ('\\' << 8) + 't';
         case '\v':
-            return '\\' << 8 + 'v';
+            return ('\\' << 8) + 'v';
         case '\f':
-            return '\\' << 8 + 'f';
+            return ('\\' << 8) + 'f';
         case '\b':
-            return '\\' << 8 + 'b';
+            return ('\\' << 8) + 'b';
         case '\a':
-            return '\\' << 8 + 'a';
+            return ('\\' << 8) + 'a';
         default:
             return c;
     }
 }
-std::pair<JSONObject, size_t> parse(std::string_view json) {
+std::pair<JSONObject, size_t> parse_recursive(std::string_view json) {
     if (json.empty()) {
         print_error("JSON", "empty json string!");
         return {JSONObject{std::monostate{}}, 0u};
@@ -162,7 +202,7 @@ std::pair<JSONObject, size_t> parse(std::string_view json) {
                 j++;
                 break;
             }
-            auto [obj, eaten] = parse(json.substr(j));
+            auto [obj, eaten] = parse_recursive(json.substr(j));
             if (eaten == 0) {
                 print_error("JSON", "Parse list error!");
                 break;
@@ -192,7 +232,7 @@ std::pair<JSONObject, size_t> parse(std::string_view json) {
                 j++;
                 break;
             }
-            auto [keyobj, keyeaten] = parse(json.substr(j));
+            auto [keyobj, keyeaten] = parse_recursive(json.substr(j));
             if (keyeaten == 0) {
                 print_error("JSON", "Parse dict key error!");
                 break;
@@ -211,7 +251,7 @@ std::pair<JSONObject, size_t> parse(std::string_view json) {
                 print_error("JSON", "Parse dict key type error!");
                 break;
             }
-            auto [valobj, valeaten] = parse(json.substr(j));
+            auto [valobj, valeaten] = parse_recursive(json.substr(j));
             if (valeaten == 0) {
                 print_error("JSON", "Parse dict value error!");
                 break;
@@ -236,6 +276,401 @@ PARSE_FAILED:
     print_error("JSON", "Parse failed! ->", json, "<-");
     return {JSONObject{std::monostate{}}, 0u};
 }
+/*
+ * 两阶段解析:
+ * 1. 以64字节为块用SIMD比较得到引号, 反斜杠, 括号等字符的位掩码,
+ *    由位运算求出转义与字符串内区域, 得到结构字符的位置索引
+ * 2. 沿索引构建JSONObject, 无需逐字符判断与递归切分输入
+ * 单引号字符串, 语法错误等非标准输入回退到parse_recursive,
+ * 因此结果(包括出错时的部分结果与错误信息)与之相同
+ */
+// 块中各类字符的位掩码, 第i位对应块中第i个字节
+struct BlockMasks {
+    uint64_t quote, backslash, squote, op, space;
+};
+BlockMasks classify_block_scalar(const char* p) {
+    BlockMasks m{};
+    for (uint32_t i = 0; i < 64; i++) {
+        uint64_t bit = uint64_t(1) << i;
+        switch (p[i]) {
+            case '"':
+                m.quote |= bit;
+                break;
+            case '\\':
+                m.backslash |= bit;
+                break;
+            case '\'':
+                m.squote |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                m.op |= bit;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\v':
+            case '\f':
+            case '\r':
+                m.space |= bit;
+                break;
+        }
+    }
+    return m;
+}
+#if defined(BL_JSON_SIMD_DISPATCH)
+inline uint64_t movemask_sse2(__m128i a, __m128i b, __m128i c, __m128i d) {
+    return uint64_t(uint16_t(_mm_movemask_epi8(a))) |
+           uint64_t(uint16_t(_mm_movemask_epi8(b))) << 16 |
+           uint64_t(uint16_t(_mm_movemask_epi8(c))) << 32 |
+           uint64_t(uint16_t(_mm_movemask_epi8(d))) << 48;
+}
+inline BlockMasks classify_block_sse2(const char* p) {
+    __m128i v[4];
+    for (int i = 0; i < 4; i++)
+        v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+    auto eq = [&](char c) {
+        __m128i s = _mm_set1_epi8(c);
+        return movemask_sse2(
+            _mm_cmpeq_epi8(v[0], s), _mm_cmpeq_epi8(v[1], s),
+            _mm_cmpeq_epi8(v[2], s), _mm_cmpeq_epi8(v[3], s));
+    };
+    // '['与']'的0x20位置1后为'{'与'}'
+    __m128i lower = _mm_set1_epi8(0x20), open = _mm_set1_epi8('{'),
+            close = _mm_set1_epi8('}');
+    // \t到\r为连续的9~13, 减9后饱和减4为0即在范围内
+    __m128i nine = _mm_set1_epi8(9), four = _mm_set1_epi8(4),
+            zero = _mm_setzero_si128();
+    __m128i br[4], ctl[4];
+    for (int i = 0; i < 4; i++) {
+        __m128i l = _mm_or_si128(v[i], lower);
+        br[i] = _mm_or_si128(_mm_cmpeq_epi8(l, open),
+                             _mm_cmpeq_epi8(l, close));
+        ctl[i] = _mm_cmpeq_epi8(
+            _mm_subs_epu8(_mm_sub_epi8(v[i], nine), four), zero);
+    }
+    return {eq('"'), eq('\\'), eq('\''),
+            movemask_sse2(br[0], br[1], br[2], br[3]) | eq(':') | eq(','),
+            movemask_sse2(ctl[0], ctl[1], ctl[2], ctl[3]) | eq(' ')};
+}
+BL_JSON_INLINE_AVX2 uint64_t eq_mask_avx2(__m256i lo, __m256i hi, char c) {
+    __m256i s = _mm256_set1_epi8(c);
+    return uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, s)))) |
+           uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, s))))
+               << 32;
+}
+BL_JSON_INLINE_AVX2 uint64_t op_mask_avx2(__m256i lo, __m256i hi) {
+    __m256i lower = _mm256_set1_epi8(0x20);
+    lo = _mm256_or_si256(lo, lower);
+    hi = _mm256_or_si256(hi, lower);
+    return eq_mask_avx2(lo, hi, '{') | eq_mask_avx2(lo, hi, '}');
+}
+BL_JSON_INLINE_AVX2 uint64_t control_mask_avx2(__m256i lo, __m256i hi) {
+    __m256i nine = _mm256_set1_epi8(9), four = _mm256_set1_epi8(4);
+    lo = _mm256_subs_epu8(_mm256_sub_epi8(lo, nine), four);
+    hi = _mm256_subs_epu8(_mm256_sub_epi8(hi, nine), four);
+    return eq_mask_avx2(lo, hi, 0);
+}
+BL_JSON_INLINE_AVX2 BlockMasks classify_block_avx2(const char* p) {
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    return {eq_mask_avx2(lo, hi, '"'), eq_mask_avx2(lo, hi, '\\'),
+            eq_mask_avx2(lo, hi, '\''),
+            op_mask_avx2(lo, hi) | eq_mask_avx2(lo, hi, ':') |
+                eq_mask_avx2(lo, hi, ','),
+            control_mask_avx2(lo, hi) | eq_mask_avx2(lo, hi, ' ')};
+}
+#endif
+// 由各块的掩码求结构字符, 块间通过进位状态衔接
+struct StructuralScanner {
+    uint32_t* out;
+    uint64_t escaped = 0;   // 下一块首字节被转义
+    uint64_t inString = 0;  // 全1表示上一块结束于字符串内
+    uint64_t scalar = 0;    // 上一块末字节属于数字/布尔等标量
+    uint64_t badQuote = 0;  // 字符串外出现单引号
+    void block(const BlockMasks& m, uint32_t base) {
+        // 奇数长度的反斜杠序列之后的字节被转义:
+        // 序列起点加上序列本身, 进位停在序列之后, 以起止的奇偶判断长度
+        constexpr uint64_t EVEN = 0x5555555555555555;
+        uint64_t bs = m.backslash & ~escaped;
+        uint64_t starts = bs & ~(bs << 1);
+        uint64_t evenEnds = (bs + (starts & EVEN)) & ~bs;
+        uint64_t oddEnds = (bs + (starts & ~EVEN)) & ~bs;
+        uint64_t esc = (evenEnds & ~EVEN) | (oddEnds & EVEN) | escaped;
+        escaped = std::countl_one(bs) & 1;
+        // 引号的前缀异或为字符串区域, 含起始引号而不含结束引号
+        uint64_t quote = m.quote & ~esc;
+        uint64_t str = quote;
+        for (int s = 1; s < 64; s <<= 1)
+            str ^= str << s;
+        str ^= inString;
+        inString = uint64_t(int64_t(str) >> 63);
+        badQuote |= m.squote & ~str;
+        // 标量只记录起始字节
+        uint64_t sc = ~(m.op | m.space | quote | str);
+        uint64_t scStart = sc & ~(sc << 1 | scalar);
+        scalar = sc >> 63;
+        uint64_t bits = (m.op & ~str) | (quote & str) | scStart;
+        while (bits) {
+            *out++ = base + std::countr_zero(bits);
+            bits &= bits - 1;
+        }
+    }
+};
+// 末尾不足64字节的部分以空格补齐
+const char* pad_tail(std::string_view json, size_t full, char (&tail)[64]) {
+    std::memset(tail, ' ', 64);
+    std::memcpy(tail, json.data() + full, json.size() - full);
+    return tail;
+}
+template <BlockMasks (*Classify)(const char*)>
+inline void scan_blocks(std::string_view json, StructuralScanner& sc) {
+    size_t full = json.size() / 64 * 64;
+    for (size_t i = 0; i < full; i += 64)
+        sc.block(Classify(json.data() + i), uint32_t(i));
+    char tail[64];
+    if (full < json.size())
+        sc.block(Classify(pad_tail(json, full, tail)), uint32_t(full));
+}
+#if defined(BL_JSON_SIMD_DISPATCH)
+// 单独写出循环, 使掩码计算内联到同为AVX2目标的函数中
+BL_JSON_TARGET_AVX2 void scan_blocks_avx2(std::string_view json,
+                                          StructuralScanner& sc) {
+    size_t full = json.size() / 64 * 64;
+    for (size_t i = 0; i < full; i += 64)
+        sc.block(classify_block_avx2(json.data() + i), uint32_t(i));
+    char tail[64];
+    if (full < json.size())
+        sc.block(classify_block_avx2(pad_tail(json, full, tail)),
+                 uint32_t(full));
+}
+#endif
+// 返回结构字符个数, 字符串未闭合或出现单引号字符串时返回0
+size_t build_structural_index(std::string_view json, uint32_t* index) {
+    StructuralScanner sc{index};
+#if defined(BL_JSON_SIMD_DISPATCH)
+    static const bool avx2 = json_avx2_supported();
+    if (avx2)
+        scan_blocks_avx2(json, sc);
+    else
+        scan_blocks<classify_block_sse2>(json, sc);
+#else
+    scan_blocks<classify_block_scalar>(json, sc);
+#endif
+    if (sc.inString || sc.badQuote)
+        return 0;
+    return sc.out - index;
+}
+// 字符串中下一个引号或反斜杠
+const char* find_quote_or_escape(const char* p, const char* end) {
+#if defined(BL_JSON_SIMD_DISPATCH)
+    __m128i quote = _mm_set1_epi8('"'), bs = _mm_set1_epi8('\\');
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int m = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                               _mm_cmpeq_epi8(v, bs)));
+        if (m)
+            return p + std::countr_zero(uint32_t(m));
+    }
+#endif
+    while (p < end && *p != '"' && *p != '\\')
+        p++;
+    return p;
+}
+// 与parse_recursive中的数字正则相同, 从begin起匹配, 返回匹配长度
+size_t match_number(const char* begin, const char* end) {
+    auto digits = [&](const char* p) {
+        while (p < end && '0' <= *p && *p <= '9')
+            p++;
+        return p;
+    };
+    const char* p = begin;
+    if (p < end && (*p == '+' || *p == '-'))
+        p++;
+    const char* d = p;
+    if (end - p >= 2 && p[0] == '0' &&
+        (p[1] == 'x' || p[1] == 'X' || p[1] == 'b' || p[1] == 'B') &&
+        digits(p + 2) != p + 2)
+        d = p + 2;
+    const char* q = digits(d);
+    if (q == d)
+        return 0;
+    if (q < end && *q == '.')
+        q = digits(q + 1);
+    if (q < end && (*q == 'e' || *q == 'E')) {
+        const char* e = q + 1;
+        if (e < end && (*e == '+' || *e == '-'))
+            e++;
+        if (digits(e) != e)
+            q = digits(e);
+    }
+    return q - begin;
+}
+bool is_scalar_end(char c) {
+    switch (c) {
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+        case '"':
+            return true;
+        default:
+            return std::isspace((unsigned char)c);
+    }
+}
+class IndexedParser {
+    std::string_view json;
+    const uint32_t* index;
+    size_t count, next = 0;
+    JSONList stack;
+
+    char peek() const { return next < count ? json[index[next]] : '\0'; }
+    bool string(uint32_t pos, std::string& out, size_t& end) {
+        const char* p = json.data() + pos + 1;
+        const char* last = json.data() + json.size();
+        for (;;) {
+            const char* q = find_quote_or_escape(p, last);
+            if (q == last)
+                return false;
+            out.append(p, q);
+            if (*q == '"') {
+                end = q + 1 - json.data();
+                return true;
+            }
+            if (q + 1 == last)
+                return false;
+            out.push_back(from_unescaped_char(q[1]));
+            p = q + 2;
+        }
+    }
+    bool scalar(uint32_t pos, JSONObject& out, size_t& end) {
+        const char* b = json.data() + pos;
+        const char* e = b;
+        const char* last = json.data() + json.size();
+        while (e < last && !is_scalar_end(*e))
+            e++;
+        end = e - json.data();
+        if (*b == 't' || *b == 'T' || *b == 'f' || *b == 'F') {
+            // 与parse_recursive相同, 不区分大小写
+            std::string_view tok(b, e - b);
+            auto is = [&](std::string_view word) {
+                return tok.size() == word.size() &&
+                       std::equal(tok.begin(), tok.end(), word.begin(),
+                                  [](char x, char y) {
+                                      return std::tolower(x) == y;
+                                  });
+            };
+            if (is("true"))
+                return out.data = true, true;
+            if (is("false"))
+                return out.data = false, true;
+            return false;
+        }
+        if (match_number(b, e) != size_t(e - b))
+            return false;
+        if (auto num = try_parse_integer(b, e); num.has_value())
+            return out.data = *num, true;
+        if (auto num = try_parse_float(b, e); num.has_value())
+            return out.data = *num, true;
+        return false;
+    }
+    // 元素先放入共用的栈中, 结束时按个数一次分配列表
+    bool list(JSONObject& out, size_t& end) {
+        size_t mark = stack.size();
+        for (;;) {
+            if (peek() == ']')
+                break;
+            JSONObject obj;
+            if (!value(obj, end))
+                return false;
+            stack.push_back(std::move(obj));
+            if (peek() != ',')
+                break;
+            next++;
+        }
+        if (peek() != ']')
+            return false;
+        end = index[next++] + 1;
+        out.data = JSONList(std::make_move_iterator(stack.begin() + mark),
+                            std::make_move_iterator(stack.end()));
+        stack.resize(mark);
+        return true;
+    }
+    bool dict(JSONObject& out, size_t& end) {
+        JSONDict res;
+        for (;;) {
+            if (peek() == '}')
+                break;
+            if (peek() != '"')
+                return false;
+            std::string key;
+            if (!string(index[next++], key, end) || peek() != ':')
+                return false;
+            next++;
+            JSONObject obj;
+            if (!value(obj, end))
+                return false;
+            res.try_emplace(std::move(key), std::move(obj));
+            if (peek() != ',')
+                break;
+            next++;
+        }
+        if (peek() != '}')
+            return false;
+        end = index[next++] + 1;
+        out.data = std::move(res);
+        return true;
+    }
+
+   public:
+    IndexedParser(std::string_view json, const uint32_t* index, size_t count)
+        : json(json), index(index), count(count) {}
+    // 成功时end为值之后的位置
+    bool value(JSONObject& out, size_t& end) {
+        if (next >= count)
+            return false;
+        uint32_t pos = index[next++];
+        switch (json[pos]) {
+            case '"': {
+                std::string str;
+                if (!string(pos, str, end))
+                    return false;
+                out.data = std::move(str);
+                return true;
+            }
+            case '[':
+                return list(out, end);
+            case '{':
+                return dict(out, end);
+            case ']':
+            case '}':
+            case ':':
+            case ',':
+                return false;
+            default:
+                return scalar(pos, out, end);
+        }
+    }
+};
+std::pair<JSONObject, size_t> parse(std::string_view json) {
+    if (!json.empty() && json.size() < UINT32_MAX) {
+        // 每个字节至多一个结构字符
+        std::unique_ptr<uint32_t[]> index(new uint32_t[json.size()]);
+        size_t count = build_structural_index(json, index.get());
+        JSONObject res;
+        size_t end;
+        if (count > 0 &&
+            IndexedParser(json, index.get(), count).value(res, end))
+            return {std::move(res), end};
+    }
+    return parse_recursive(json);
+}
 struct dump_visitor {
     std::stringstream& stream;
     void operator()(int64_t val) { stream << val; }
@@ -243,7 +678,7 @@ struct dump_visitor {
     void operator()(bool val) { stream << (val ? "true" : "false"); }
     void operator()(const std::string& val) {
         stream.put('\"');
-        for (size_t i = 0 : i < val.size(); i++) {
+        for (size_t i = 0; i < val.size(); i++) {
             int ch = to_escaped_char(val[i]);
             if (ch > 0xFF) {
                 stream.put('\\');
@@ -268,18 +703,16 @@ struct dump_visitor {
     void operator()(const JSONDict& val) {
         stream.put('{');
         auto it = val.begin();
-        while (true) {
+        while (it != val.end()) {
             stream << '\"' << it->first << '\"' << ':';
             std::visit(*this, it->second.data);
             ++it;
             if (it != val.end())
                 stream.put(',');
-            else
-                break;
         }
         stream.put('}');
     }
-    void operator()(std::monostate v) { stream << "Error"; }
+    void operator()(std::monostate) { stream << "Error"; }
 };
 std::string dump(const JSONObject& json) {
     std::stringstream stm;
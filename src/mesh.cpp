@@ -76,6 +76,31 @@ void copy_mesh_info(MeshFileHead* pFileData, MeshInfo* info) {
     info->indexCount = pFileData->vertexCount;
     info->restartIndex = pFileData->restartIndex;
     info->restartEnable = bool(pFileData->restartEnable);
+    const MeshFileHead::Bounds& b = pFileData->bounds;
+    info->boundBox = {vec3f(b.aabbMax), vec3f(b.aabbMin)};
+    info->boundSphere = {vec3f(b.sphereCenter), b.sphereRadius};
+    info->boundOBB = {vec3f(b.obbCenter), vec3f(b.obbU), vec3f(b.obbV),
+                      vec3f(b.obbHalf)};
+}
+Math::PointStream position_stream(const MeshInfo& info,
+                                  const void* data,
+                                  uint32_t location) {
+    for (const auto& attr : info.inputAttributes) {
+        if (attr.location != location)
+            continue;
+        if (attr.format != VK_FORMAT_R32G32B32_SFLOAT &&
+            attr.format != VK_FORMAT_R32G32B32A32_SFLOAT)
+            break;
+        for (const auto& bind : info.inputBindings) {
+            if (bind.binding == attr.binding)
+                return {(const uint8_t*)data + attr.offset, info.vertexCount,
+                        bind.stride};
+        }
+        break;
+    }
+    print_error("Mesh", "No float3 position attribute at location:",
+                location);
+    return {};
 }
 void read_buffer_info_list(
     MeshFileHead* pHead,
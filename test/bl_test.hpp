@@ -0,0 +1,42 @@
+#ifndef _BOUNDLESS_TEST_HPP_FILE_
+#define _BOUNDLESS_TEST_HPP_FILE_
+#include <cstdio>
+#include <random>
+#include "bl_collision.hpp"
+/*
+ * 测试用的最小工具: BL_CHECK失败时打印位置并计数, main返回bl_test_result()
+ */
+inline int& bl_test_failures() {
+    static int n = 0;
+    return n;
+}
+#define BL_CHECK(cond, ...)                                             \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            if (bl_test_failures()++ < 20) {                            \
+                std::printf("%s:%d: check failed: %s ", __FILE__,       \
+                            __LINE__, #cond);                           \
+                std::printf(__VA_ARGS__);                               \
+                std::printf("\n");                                      \
+            }                                                           \
+        }                                                               \
+    } while (0)
+inline int bl_test_result() {
+    if (bl_test_failures() == 0) {
+        std::printf("ok\n");
+        return 0;
+    }
+    std::printf("%d checks failed\n", bl_test_failures());
+    return 1;
+}
+// [-range, range]内的随机立方盒, 半边长在[hmin, hmax]内
+inline BL::Math::AABB<float> random_box(std::mt19937& rng,
+                                        float range,
+                                        float hmin,
+                                        float hmax) {
+    std::uniform_real_distribution<float> u(-range, range), s(hmin, hmax);
+    BL::vec3<float> c(u(rng), u(rng), u(rng));
+    float h = s(rng);
+    return {c + BL::vec3<float>::Constant(h), c - BL::vec3<float>::Constant(h)};
+}
+#endif  //!_BOUNDLESS_TEST_HPP_FILE_
@@ -0,0 +1,60 @@
+// FileWriter写出的文件能通过FileReader::read_all的CRC32校验,
+// 压缩块的长度与内容正确
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "bl_bin_file.hpp"
+#include "bl_test.hpp"
+using namespace BL::File;
+struct Record {
+    uint32_t id;
+    float value;
+};
+int main() {
+    std::string path =
+        (std::filesystem::temp_directory_path() / "bl_test_bin_file.bin")
+            .string();
+    const uint32_t head = 0x4C42, type = 7;
+    Record rec{42, 1.5f};
+    std::vector<uint32_t> arr(100);
+    std::vector<uint8_t> raw(64 * 1024);
+    for (size_t i = 0; i < arr.size(); i++)
+        arr[i] = uint32_t(i * i);
+    for (size_t i = 0; i < raw.size(); i++)
+        raw[i] = uint8_t((i / 7) ^ (i % 13));
+    uint32_t zipBegin, zipEnd;
+    {
+        FileWriter w(path, head, type);
+        w.write(&rec);
+        w.write_array(arr.data(), arr.size());
+        zipBegin = w.tellp();
+        w.write(raw.data(), raw.size());
+        zipEnd = w.tellp();
+        w.close();
+    }
+    FileReader r(path, head, type);
+    std::vector<uint8_t> body;
+    BL_CHECK(r.read_all(body), "read_all failed");
+    size_t headSize = sizeof(HeadBlock);
+    BL_CHECK(body.size() + headSize == zipEnd, "%zu bytes vs eof %u",
+             body.size(), zipEnd);
+    if (bl_test_failures() == 0) {
+        Record got;
+        std::memcpy(&got, body.data(), sizeof(got));
+        BL_CHECK(got.id == rec.id && got.value == rec.value, "record");
+        BL_CHECK(std::memcmp(body.data() + sizeof(rec), arr.data(),
+                             arr.size() * sizeof(uint32_t)) == 0,
+                 "array");
+        std::vector<uint8_t> unzipped(raw.size());
+        uLongf len = unzipped.size();
+        int z = uncompress(unzipped.data(), &len,
+                           body.data() + (zipBegin - headSize),
+                           zipEnd - zipBegin);
+        BL_CHECK(z == Z_OK && len == raw.size() && unzipped == raw,
+                 "compressed block: zlib %d, %lu bytes", z,
+                 (unsigned long)len);
+    }
+    r.close();
+    std::filesystem::remove(path);
+    return bl_test_result();
+}
@@ -0,0 +1,66 @@
+// cullFrustumBatch在各指令集及有无平面缓存时与逐个盒测试平面的结果一致,
+// 盒数覆盖不足一组和带尾部的情况; 复用的CullBatchScratch与在线程池任务中
+// 嵌套调用的结果相同
+#include <vector>
+#include "bl_collision_batch.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using BL::vec3;
+static std::array<Plane<float>, 6> frustum(float cx) {
+    std::array<Plane<float>, 6> p;
+    p[0].set(vec3<float>(-1, 0.2f, 0), cx - 30);
+    p[1].set(vec3<float>(1, 0.1f, 0), -cx - 30);
+    p[2].set(vec3<float>(0, -1, 0.3f), -30);
+    p[3].set(vec3<float>(0.2f, 1, 0), -30);
+    p[4].set(vec3<float>(0, 0, -1), -30);
+    p[5].set(vec3<float>(0, 0.1f, 1), -30);
+    return p;
+}
+int main() {
+    std::mt19937 rng(9);
+    CullBatchScratch scratch;
+    for (uint32_t n : {0u, 3u, 8u, 13u, 5000u, 70001u}) {
+        AABBSoA soa;
+        std::vector<AABB<float>> boxes;
+        for (uint32_t i = 0; i < n; i++) {
+            boxes.push_back(random_box(rng, 100, 0.1f, 3));
+            soa.push_back(boxes.back());
+        }
+        for (int level = int(detect_simd_level()); level >= 0; level--) {
+            set_simd_level(SimdLevel(level));
+            std::vector<uint8_t> cache;
+            for (int f = 0; f < 10; f++) {
+                auto planes = frustum(f * 3.0f - 15);
+                // 结果追加在已有内容之后
+                std::vector<uint32_t> got{12345}, expect{12345};
+                std::vector<uint8_t>* c = f % 3 ? &cache : nullptr;
+                uint32_t count = f % 2 ? cullFrustumBatch(planes, soa, got, c)
+                                       : cullFrustumBatch(planes, soa, got,
+                                                          scratch, c);
+                for (uint32_t i = 0; i < n; i++) {
+                    bool visible = true;
+                    for (const auto& p : planes)
+                        if (intersectTest(p, boxes[i]) ==
+                            CollisionResult::outer)
+                            visible = false;
+                    if (visible)
+                        expect.push_back(i);
+                }
+                BL_CHECK(got == expect && count == expect.size() - 1,
+                         "n=%u level %d frame %d: %zu vs %zu", n, level, f,
+                         got.size(), expect.size());
+            }
+        }
+        // 每个任务剔除一个视锥体, 等待内层调用时可能执行其他任务的剔除
+        std::vector<std::vector<uint32_t>> serial(8), nested(8);
+        for (uint32_t f = 0; f < 8; f++)
+            cullFrustumBatch(frustum(f * 4.0f - 16), soa, serial[f]);
+        BL::default_thread_pool().parallel_for(
+            8, 1, [&](uint32_t b, uint32_t e, uint32_t) {
+                for (uint32_t f = b; f < e; f++)
+                    cullFrustumBatch(frustum(f * 4.0f - 16), soa, nested[f]);
+            });
+        BL_CHECK(nested == serial, "n=%u: nested calls differ", n);
+    }
+    return bl_test_result();
+}
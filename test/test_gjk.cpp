@@ -0,0 +1,91 @@
+// queryConvex/intersectConvex与解析结果比较: 球与球的距离和穿透深度,
+// OBB与OBB的相交判定和穿透深度(15轴SAT), 以及热启动不改变结果
+#include <vector>
+#include "bl_gjk.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using BL::vec2;
+using BL::vec3;
+template <typename R>
+static OBB<R> random_obb(std::mt19937& rng, R spread) {
+    using V = vec3<R>;
+    std::uniform_real_distribution<R> u(-1, 1), s(R(0.2), 2);
+    OBB<R> o;
+    o.setCenter(V(u(rng), u(rng), u(rng)) * spread);
+    V x = V(u(rng), u(rng), u(rng)).normalized();
+    V y = x.cross(V(u(rng), u(rng), u(rng))).normalized();
+    o.setBoxSize(x * s(rng), y * s(rng), s(rng));
+    return o;
+}
+// 15条分离轴上重叠量的最小值, 为负时分离
+template <typename R>
+static R sat_depth(const OBB<R>& a, const OBB<R>& b) {
+    using V = vec3<R>;
+    V A[3] = {a.u(), a.v(), a.w()}, B[3] = {b.u(), b.v(), b.w()};
+    std::vector<V> axes(A, A + 3);
+    axes.insert(axes.end(), B, B + 3);
+    for (const V& x : A)
+        for (const V& y : B)
+            if (x.cross(y).norm() > R(1e-6))
+                axes.push_back(x.cross(y).normalized());
+    R best = std::numeric_limits<R>::max();
+    for (const V& n : axes) {
+        vec2<R> pa = projOBB2(a, n, a.w()), pb = projOBB2(b, n, b.w());
+        best = std::min(best, std::min(pa.y() - pb.x(), pb.y() - pa.x()));
+    }
+    return best;
+}
+template <typename R>
+static void check(std::mt19937& rng, R tol) {
+    using V = vec3<R>;
+    std::uniform_real_distribution<R> u(-1, 1), s(R(0.1), 2);
+    for (int it = 0; it < 20000; it++) {
+        Sphere<R> sa{V(u(rng), u(rng), u(rng)) * 3, s(rng)};
+        Sphere<R> sb{V(u(rng), u(rng), u(rng)) * 3, s(rng)};
+        R expect = (sa.c() - sb.c()).norm() - sa.r() - sb.r();
+        auto r = queryConvex(sa, sb);
+        BL_CHECK(std::abs(r.distance - expect) <= tol &&
+                     r.intersect == (expect < 0),
+                 "sphere %d: %g vs %g", it, double(r.distance),
+                 double(expect));
+        BL_CHECK(std::abs(expect) <= tol ||
+                     intersectConvex(sa, sb) == (expect < 0),
+                 "sphere bool %d: %g", it, double(expect));
+
+        OBB<R> a = random_obb(rng, R(1.5)), b = random_obb(rng, R(1.5));
+        R depth = sat_depth(a, b);
+        r = queryConvex(a, b);
+        bool sat = intersectTest(a, b) != CollisionResult::outer;
+        // 刚好接触时两种判定都可接受
+        if (std::abs(depth) <= tol)
+            continue;
+        BL_CHECK(r.intersect == sat && intersectConvex(a, b) == sat,
+                 "obb %d: sat %d gjk %d, depth %g", it, sat, r.intersect,
+                 double(depth));
+        if (sat)
+            BL_CHECK(std::abs(r.distance + depth) <= tol,
+                     "obb %d: depth %g vs %g", it, double(-r.distance),
+                     double(depth));
+        else
+            BL_CHECK(std::abs((r.pointB - r.pointA).norm() - r.distance) <=
+                         tol,
+                     "obb %d: witness %g vs %g", it,
+                     double((r.pointB - r.pointA).norm()),
+                     double(r.distance));
+        // 从上一次的单纯形热启动, 结果应与冷启动相同
+        GJKCache<R> cache;
+        queryConvex(a, b, &cache);
+        a.setCenter(a.c() + V(R(0.01), 0, 0));
+        auto warm = queryConvex(a, b, &cache), cold = queryConvex(a, b);
+        BL_CHECK(warm.intersect == cold.intersect &&
+                     std::abs(warm.distance - cold.distance) <= tol,
+                 "obb %d: warm %g cold %g", it, double(warm.distance),
+                 double(cold.distance));
+    }
+}
+int main() {
+    std::mt19937 rng(20);
+    check<double>(rng, 1e-6);
+    check<float>(rng, 1e-3f);
+    return bl_test_result();
+}
@@ -0,0 +1,98 @@
+// SpatialHashGrid的find, radius与collectPairs和逐个对象测试的结果一致
+// 对象中心多为负坐标, 部分对象大于格子, 覆盖按maxHalfSize扩大的查询范围与
+// collectPairs的相邻格子环; 大范围查询走遍历全部对象的分支
+#include <algorithm>
+#include <vector>
+#include "bl_hash_grid.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using Grid = SpatialHashGrid<uint32_t, float>;
+using Vec3 = Grid::Vec3;
+int main() {
+    const uint32_t n = 4000;
+    std::mt19937 rng(14);
+    std::uniform_real_distribution<float> u(-45, 15), s(0, 1);
+    auto sorted = [](std::vector<uint32_t> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    };
+    // 格子边长分别小于, 接近与大于多数对象
+    for (float cell : {0.5f, 1.0f, 3.0f}) {
+        for (float bigHalf : {0.0f, 2.5f}) {
+            std::vector<AABB<float>> boxes(n);
+            std::vector<uint32_t> data(n);
+            for (uint32_t i = 0; i < n; i++) {
+                // 中心在[-45, 15]内, 偏向负坐标; 少数为点或大于格子的对象
+                AABB<float> b = random_box(rng, 30, 0, 0.6f);
+                if (i % 97 == 0)
+                    b = {b.c(), b.c()};
+                else if (bigHalf > 0 && i % 41 == 0)
+                    b = random_box(rng, 30, bigHalf, bigHalf * 2);
+                boxes[i] = {b.max() - Vec3::Constant(15),
+                            b.min() - Vec3::Constant(15)};
+                data[i] = i;
+            }
+            Grid g;
+            g.setCellSize(cell);
+            g.build(boxes, data);
+            BL_CHECK(g.size() == n, "size %u", g.size());
+            for (int q = 0; q < 200; q++) {
+                Vec3 c(u(rng), u(rng), u(rng));
+                // 偶尔使用大范围查询, 格子数多于对象数
+                float h = q % 50 == 0 ? 40 : 3 * s(rng);
+                AABB<float> area{c + Vec3::Constant(h), c - Vec3::Constant(h)};
+                std::vector<uint32_t> got, expect;
+                g.find(area, [&](const AABB<float>&, uint32_t& i) {
+                    got.push_back(i);
+                });
+                for (uint32_t i = 0; i < n; i++)
+                    if (intersectTest(area, boxes[i]) >=
+                        CollisionResult::intersect)
+                        expect.push_back(i);
+                BL_CHECK(sorted(got) == expect,
+                         "cell %g big %g find %d: %zu vs %zu", cell, bigHalf,
+                         q, got.size(), expect.size());
+
+                float r = q % 50 == 1 ? 40 : 4 * s(rng);
+                got = {12345};
+                g.radius(c, r, got);
+                BL_CHECK(got[0] == 12345, "radius %d: output not appended", q);
+                got.erase(got.begin());
+                expect.clear();
+                for (uint32_t i = 0; i < n; i++)
+                    if (distanceSquared(c, boxes[i]) <= r * r)
+                        expect.push_back(i);
+                BL_CHECK(sorted(got) == expect,
+                         "cell %g big %g radius %d: %zu vs %zu", cell, bigHalf,
+                         q, got.size(), expect.size());
+            }
+            // 相交对, 每对恰好一次
+            Grid::PairList pairs;
+            g.collectPairs(pairs);
+            std::vector<uint64_t> got, expect;
+            for (const auto& [a, b] : pairs) {
+                uint64_t i = *a, j = *b;
+                BL_CHECK(i != j, "self pair %llu", (unsigned long long)i);
+                got.push_back(std::min(i, j) << 32 | std::max(i, j));
+            }
+            std::sort(got.begin(), got.end());
+            BL_CHECK(std::adjacent_find(got.begin(), got.end()) == got.end(),
+                     "cell %g big %g: duplicate pairs", cell, bigHalf);
+            for (uint64_t i = 0; i < n; i++)
+                for (uint64_t j = i + 1; j < n; j++)
+                    if (intersectTest(boxes[i], boxes[j]) >=
+                        CollisionResult::intersect)
+                        expect.push_back(i << 32 | j);
+            BL_CHECK(got == expect, "cell %g big %g pairs: %zu vs %zu", cell,
+                     bigHalf, got.size(), expect.size());
+        }
+    }
+    // 空网格
+    Grid empty;
+    empty.build({}, {});
+    Grid::PairList pairs{{nullptr, nullptr}};
+    empty.collectPairs(pairs);
+    BL_CHECK(pairs.empty() && empty.radius(Vec3::Zero(), 10).empty(),
+             "empty grid");
+    return bl_test_result();
+}
@@ -0,0 +1,138 @@
+// intersect.hpp的旧接口与原实现(src/intersect.cpp, 已删除)的结果一致
+// 参考实现按原代码逐行保留在这里
+#include "bl_test.hpp"
+#include "intersect.hpp"
+using namespace BL;
+static bool old_ray_sphere(const vec3f& o,
+                           const vec3f& d,
+                           const vec3f& c,
+                           float r,
+                           float* t) {
+    vec3f l = c - o;
+    float s = l.dot(d);
+    float l2 = l.dot(l);
+    float r2 = r * r;
+    if (s < 0.0 || l2 > r2)
+        return false;
+    float m2 = l2 - s * s;
+    if (m2 > r2)
+        return false;
+    float q = std::sqrt(r2 - m2);
+    if (l2 > r2)
+        *t = s - q;
+    else
+        *t = s + q;
+    return true;
+}
+static bool old_ray_OBB(const vec3f& o, const vec3f& d, const OBB& A, float* t) {
+    float t_min = -std::numeric_limits<float>::infinity();
+    float t_max = std::numeric_limits<float>::infinity();
+    vec3f p = A.c() - o;
+    vec3f axes[3] = {A.u(), A.v(), A.w()};
+    for (int k = 0; k < 3; k++) {
+        float e = p.dot(axes[k]);
+        float f = d.dot(axes[k]);
+        float h = A.h()[k];
+        if (std::abs(f) > ϵ) {
+            float f_i = 1 / f;
+            float t1 = (e + h) * f_i;
+            float t2 = (e - h) * f_i;
+            if (t1 > t2)
+                std::swap(t1, t2);
+            t_min = std::max(t1, t_min);
+            t_max = std::min(t2, t_max);
+            if (t_max < 0.0f || t_min > t_max)
+                return false;
+        } else if (-e - h > 0.0f || -e + h < 0.0f)
+            return false;
+    }
+    *t = t_min > 0.0f ? t_min : t_max;
+    return true;
+}
+static bool old_ray_AABB(const vec3f& o,
+                         const vec3f& d,
+                         const AABB& A,
+                         float* t) {
+    float t_min = -std::numeric_limits<float>::infinity();
+    float t_max = std::numeric_limits<float>::infinity();
+    vec3f amin = A.min();
+    vec3f amax = A.max();
+    for (int k = 0; k < 3; k++) {
+        if (std::abs(d[k]) < ϵ) {
+            if (o[k] < amin[k] || o[k] > amax[k])
+                return false;
+        } else {
+            float d_i = 1.0f / d[k];
+            float t1 = (amin[k] - o[k]) * d_i;
+            float t2 = (amax[k] - o[k]) * d_i;
+            if (t1 > t2)
+                std::swap(t1, t2);
+            t_min = std::max(t1, t_min);
+            t_max = std::min(t2, t_max);
+            if (t_min > t_max)
+                return false;
+        }
+    }
+    *t = t_min > 0.0f ? t_min : t_max;
+    return true;
+}
+static int old_plane_OBB(const vec3f& n, float d, const OBB& A) {
+    vec3f n_abs(A.u().dot(n), A.v().dot(n), A.w().dot(n));
+    n_abs = n_abs.array().abs().matrix();
+    float e = A.h().dot(n_abs);
+    float s = A.c().dot(n) + d;
+    if (s - e > 0.0f)
+        return -1;
+    if (s + e < 0.0f)
+        return +1;
+    return 0;
+}
+int main() {
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> u(-1, 1), s(0.1f, 3);
+    for (int it = 0; it < 200000; it++) {
+        vec3f o = vec3f(u(rng), u(rng), u(rng)) * 5;
+        vec3f d = vec3f(u(rng), u(rng), u(rng)).normalized();
+        // 部分射线与坐标轴平行
+        if (it % 5 == 0)
+            d[it / 5 % 3] = 0;
+        vec3f c = vec3f(u(rng), u(rng), u(rng)) * 3;
+        float r = s(rng), t = -1, t2 = -1;
+        bool hit = intersect_ray_sphere_res(o, d, c, r, &t);
+        bool expect = old_ray_sphere(o, d, c, r, &t2);
+        BL_CHECK(hit == expect && (!hit || t == t2) &&
+                     intersect_ray_sphere(o, d, c, r) == expect,
+                 "sphere %d: %d %g vs %d %g", it, hit, t, expect, t2);
+
+        AABB box{c + vec3f(s(rng), s(rng), s(rng)),
+                 c - vec3f(s(rng), s(rng), s(rng))};
+        hit = intersect_ray_AABB_res(o, d, box, &t);
+        expect = old_ray_AABB(o, d, box, &t2);
+        BL_CHECK(hit == expect && (!hit || t == t2) &&
+                     intersect_ray_AABB(o, d, box) == expect,
+                 "AABB %d: %d %g vs %d %g", it, hit, t, expect, t2);
+
+        OBB obb;
+        obb.setCenter(c);
+        vec3f x = vec3f(u(rng), u(rng), u(rng)).normalized();
+        vec3f y = x.cross(vec3f(u(rng), u(rng), u(rng))).normalized();
+        if (it % 7 == 0)
+            x = vec3f::UnitX(), y = vec3f::UnitY();
+        obb.setBoxSize(x * s(rng), y * s(rng), s(rng));
+        hit = intersect_ray_OBB_res(o, d, obb, &t);
+        expect = old_ray_OBB(o, d, obb, &t2);
+        BL_CHECK(hit == expect && (!hit || t == t2) &&
+                     intersect_ray_OBB(o, d, obb) == expect,
+                 "OBB %d: %d %g vs %d %g", it, hit, t, expect, t2);
+
+        float pd = u(rng) * 5;
+        BL_CHECK(intersect_plane_OBB(d, pd, obb) == old_plane_OBB(d, pd, obb),
+                 "plane OBB %d", it);
+        Plane p;
+        p.set_nonorm(d, pd);
+        BL_CHECK(intersect_plane_AABB(d, pd, box) ==
+                     intersect_plane_AABB(p, box),
+                 "plane AABB %d", it);
+    }
+    return bl_test_result();
+}
@@ -0,0 +1,33 @@
+// dump输出的字符串转义序列, 以及dump后再parse得到原字符串
+#include <string>
+#include "bl_JSON.hpp"
+#include "bl_test.hpp"
+using namespace BL::JSON;
+int main() {
+    struct Case {
+        std::string raw, text;
+    };
+    const Case cases[] = {
+        {"a\nb", "\"a\\nb\""},         {"tab\there", "\"tab\\there\""},
+        {"back\\slash", "\"back\\\\slash\""},
+        {"say \"hi\"", "\"say \\\"hi\\\"\""},
+        {std::string("nul\0x", 5), "\"nul\\0x\""},
+        {"\r\v\f\b\a", "\"\\r\\v\\f\\b\\a\""},
+        {"plain", "\"plain\""},
+    };
+    for (const Case& c : cases) {
+        std::string text = dump(JSONObject{c.raw});
+        BL_CHECK(text == c.text, "dump gave %s, expected %s", text.c_str(),
+                 c.text.c_str());
+        auto [obj, n] = parse(text);
+        auto* s = std::get_if<std::string>(&obj.data);
+        BL_CHECK(n == text.size() && s && *s == c.raw, "round trip of %s",
+                 c.text.c_str());
+    }
+    // 容器中的字符串同样转义
+    JSONObject list{JSONList{JSONObject{std::string("x\"y")},
+                             JSONObject{int64_t(3)}}};
+    std::string text = dump(list);
+    BL_CHECK(text == "[\"x\\\"y\",3]", "dump gave %s", text.c_str());
+    return bl_test_result();
+}
@@ -0,0 +1,155 @@
+// parse与parse_recursive对随机文档(含非标准输入与随机破坏)的结果一致:
+// 解析出的对象相同且消耗的字符数相同
+#include <iostream>
+#include <string>
+#include "bl_JSON.hpp"
+#include "bl_test.hpp"
+using namespace BL::JSON;
+namespace BL::JSON {
+// 递归下降的原实现, 在bl_JSON.cpp中, 未在头文件中声明
+std::pair<JSONObject, size_t> parse_recursive(std::string_view json);
+}  // namespace BL::JSON
+static bool same(const JSONObject& a, const JSONObject& b) {
+    if (a.data.index() != b.data.index())
+        return false;
+    if (auto* x = std::get_if<double>(&a.data)) {
+        double y = std::get<double>(b.data);
+        return *x == y || (*x != *x && y != y);
+    }
+    if (auto* x = std::get_if<JSONList>(&a.data)) {
+        const JSONList& y = std::get<JSONList>(b.data);
+        if (x->size() != y.size())
+            return false;
+        for (size_t i = 0; i < x->size(); i++)
+            if (!same((*x)[i], y[i]))
+                return false;
+        return true;
+    }
+    if (auto* x = std::get_if<JSONDict>(&a.data)) {
+        const JSONDict& y = std::get<JSONDict>(b.data);
+        if (x->size() != y.size())
+            return false;
+        for (const auto& [k, v] : *x) {
+            auto it = y.find(k);
+            if (it == y.end() || !same(v, it->second))
+                return false;
+        }
+        return true;
+    }
+    if (auto* x = std::get_if<std::string>(&a.data))
+        return *x == std::get<std::string>(b.data);
+    if (auto* x = std::get_if<int64_t>(&a.data))
+        return *x == std::get<int64_t>(b.data);
+    if (auto* x = std::get_if<bool>(&a.data))
+        return *x == std::get<bool>(b.data);
+    return true;
+}
+static std::mt19937 rng(25);
+static uint32_t pick(uint32_t n) {
+    return rng() % n;
+}
+static std::string space() {
+    static const char* ws[] = {"", " ", "\n  ", "\t"};
+    return ws[pick(4)];
+}
+// 随机文档, 包括大小写不同的布尔值, 十六进制/二进制数字, 单引号与转义
+static std::string gen(int depth) {
+    static const char* numbers[] = {"0",     "-1",    "42",  "3.25",
+                                    "-0.5e3", "1e5",  "+7",  "017",
+                                    "0x1F",  "0b101", "1.",  "2E-3",
+                                    "123456789012"};
+    static const char* bools[] = {"true", "false", "True", "FALSE"};
+    static const char* strings[] = {"\"x\"", "\"\"", "\"a\\\\\"",
+                                    "\"\\\\\\\"\""};
+    std::string s;
+    switch (depth > 4 ? pick(4) : pick(6)) {
+        case 0:
+            return numbers[pick(13)];
+        case 1:
+            return bools[pick(4)];
+        case 2: {
+            static const char* parts[] = {"\\\"", "\\\\", "\\n", "'",
+                                          "\\u", "{[,:"};
+            s = "\"";
+            for (uint32_t i = pick(20); i > 0; i--) {
+                uint32_t c = pick(12);
+                s += c < 6 ? std::string(parts[c]) : std::string(1, 'a' + pick(26));
+            }
+            return s + "\"";
+        }
+        case 3:
+            return strings[pick(4)];
+        case 4: {
+            s = "[" + space();
+            uint32_t n = pick(5);
+            for (uint32_t i = 0; i < n; i++)
+                s += (i ? "," + space() : "") + gen(depth + 1) + space();
+            // 偶尔带多余的逗号
+            if (n && pick(8) == 0)
+                s += ",";
+            return s + "]";
+        }
+        default: {
+            s = "{" + space();
+            uint32_t n = pick(5);
+            for (uint32_t i = 0; i < n; i++)
+                s += (i ? "," + space() : "") + "\"k" +
+                     std::to_string(pick(6)) + "\"" + space() + ":" + space() +
+                     gen(depth + 1);
+            if (n && pick(8) == 0)
+                s += ",";
+            return s + "}";
+        }
+    }
+}
+// 随机替换, 插入或删除1到3个字符
+static std::string mutate(std::string s) {
+    static const char chars[] = "{}[]:,\"'\\ xt0.-e\0";
+    for (uint32_t n = 1 + pick(3); n > 0 && !s.empty(); n--) {
+        size_t p = pick(s.size());
+        char c = chars[pick(sizeof(chars))];
+        switch (pick(3)) {
+            case 0:
+                s[p] = c;
+                break;
+            case 1:
+                s.insert(s.begin() + p, c);
+                break;
+            default:
+                s.erase(p, 1);
+        }
+    }
+    return s;
+}
+static void check(const std::string& s) {
+    auto [a, na] = parse(s);
+    auto [b, nb] = parse_recursive(s);
+    BL_CHECK(same(a, b) && na == nb, "eaten %zu vs %zu: [%s]", na, nb,
+             s.c_str());
+}
+int main() {
+    // 解析失败时的错误日志写到std::cerr, 数量很大, 测试中关闭
+    std::cerr.rdbuf(nullptr);
+    for (int t = 0; t < 200000; t++) {
+        std::string s = (pick(3) ? "" : "  ") + gen(0) +
+                        (pick(4) ? "" : " trailing");
+        if (t % 2)
+            s = mutate(s);
+        if (!s.empty())
+            check(s);
+    }
+    // 较大的文档, 包含长串反斜杠
+    for (int t = 0; t < 200; t++) {
+        std::string s = "[";
+        for (size_t len = 1000 + pick(200000); s.size() < len;) {
+            s += gen(0) + ",";
+            if (pick(5) == 0) {
+                uint32_t n = pick(70);
+                s += "\"" + std::string(n + n % 2, '\\') + "x\",";
+            }
+        }
+        s += "0]";
+        check(t % 2 ? mutate(s) : s);
+    }
+    return bl_test_result();
+}
@@ -0,0 +1,96 @@
+// LinearOctTree的raycast/knn/collectPairs与OctTree的结果一致,
+// 树经过commit增量更新(移动与删除)之后
+#include <algorithm>
+#include <set>
+#include <vector>
+#include "bl_linear_octtree.hpp"
+#include "bl_octtree.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using Tree = OctTree<int, float>;
+using LTree = LinearOctTree<int, float>;
+using Vec3 = LTree::Vec3;
+int main() {
+    const int n = 20000;
+    const LTree::Box root{{100, 100, 100}, {-100, -100, -100}};
+    std::mt19937 rng(8);
+    std::vector<LTree::Box> boxes(n);
+    std::vector<int> data(n), data2(n);
+    for (int i = 0; i < n; i++) {
+        boxes[i] = random_box(rng, 90, 0.05f, 1.5f);
+        data[i] = data2[i] = i;
+    }
+    LTree L;
+    L.create(root);
+    std::vector<uint32_t> hs(n);
+    L.build(boxes, std::span<int>(data), hs);
+    // 移动一半对象, 删除一部分, 再与按最终状态建立的OctTree比较
+    std::uniform_real_distribution<float> u(-90, 90), d(-0.5f, 0.5f);
+    std::vector<bool> alive(n, true);
+    for (int i = 0; i < n; i += 2) {
+        Vec3 delta(d(rng), d(rng), d(rng));
+        LTree::Box nb{boxes[i].max() + delta, boxes[i].min() + delta};
+        if (intersectTest(root, nb) != CollisionResult::inner)
+            continue;
+        boxes[i] = nb;
+        L.update(hs[i], nb);
+    }
+    for (int i = 1; i < n; i += 37) {
+        L.drop(hs[i]);
+        alive[i] = false;
+    }
+    L.commit();
+    std::vector<LTree::Box> liveBoxes;
+    std::vector<int> liveData;
+    for (int i = 0; i < n; i++)
+        if (alive[i]) {
+            liveBoxes.push_back(boxes[i]);
+            liveData.push_back(i);
+        }
+    Tree t;
+    t.create(root);
+    t.build(liveBoxes, std::span<int>(liveData));
+
+    for (int q = 0; q < 200; q++) {
+        Vec3 o(u(rng), u(rng), u(rng));
+        Vec3 dir(d(rng), d(rng), d(rng));
+        dir.normalize();
+        std::vector<LTree::RayHit> a;
+        std::vector<Tree::RayHit> b;
+        L.raycast(o, dir, 150, 8, a);
+        t.raycast(o, dir, 150, 8, b);
+        BL_CHECK(a.size() == b.size(), "ray %d: %zu vs %zu hits", q, a.size(),
+                 b.size());
+        for (size_t i = 0; i < std::min(a.size(), b.size()); i++)
+            BL_CHECK(a[i].t == b[i].t, "ray %d hit %zu: t %g vs %g", q, i,
+                     a[i].t, b[i].t);
+        LTree::RayHit first = L.raycast(o, dir, 150);
+        BL_CHECK(a.empty() ? first.block == LTree::NULL_NEXT
+                           : first.t == a[0].t,
+                 "ray %d nearest", q);
+
+        auto na = L.knn(o, 10);
+        auto nb = t.knn(o, 10);
+        BL_CHECK(na.size() == nb.size(), "knn %d: %zu vs %zu", q, na.size(),
+                 nb.size());
+        for (size_t i = 0; i < std::min(na.size(), nb.size()); i++)
+            BL_CHECK(na[i].dist2 == nb[i].dist2, "knn %d #%zu: %g vs %g", q,
+                     i, na[i].dist2, nb[i].dist2);
+    }
+
+    auto pairSet = [](const auto& list) {
+        std::set<std::pair<int, int>> s;
+        for (auto [x, y] : list)
+            s.insert({std::min(*x, *y), std::max(*x, *y)});
+        return s;
+    };
+    LTree::PairList pa;
+    Tree::PairList pb;
+    L.collectPairs(pa);
+    t.collectPairs(pb);
+    auto sa = pairSet(pa), sb = pairSet(pb);
+    BL_CHECK(sa.size() == pa.size(), "duplicate pairs: %zu of %zu",
+             pa.size() - sa.size(), pa.size());
+    BL_CHECK(sa == sb, "pairs: %zu vs %zu", sa.size(), sb.size());
+    return bl_test_result();
+}
@@ -0,0 +1,144 @@
+// computeAABB, computeBoundingSphere与computeOBB在各指令集与顶点间距下的结果:
+// AABB与逐点求得的相同, 球与OBB包含所有顶点; 顶点数覆盖0, 1, 2, 奇偶与多段
+// 顶点数据紧贴不可读的页, 最后一个顶点之后读取越界会导致崩溃; 顶点间的
+// 填充字节为极大值, 被误读入结果时会被发现
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "bl_mesh_bounds.hpp"
+#include "bl_test.hpp"
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+using namespace BL::Math;
+using BL::vec3;
+using Vec3 = vec3<float>;
+// 末尾对齐到页边界的缓冲区, 其后一页不可访问
+class GuardedBuffer {
+    uint8_t* base = nullptr;
+    size_t total = 0;
+    std::vector<uint8_t> fallback;
+
+   public:
+    uint8_t* data = nullptr;
+    explicit GuardedBuffer(size_t size) {
+#if __has_include(<sys/mman.h>)
+        size_t page = sysconf(_SC_PAGESIZE);
+        size_t used = (size + page - 1) / page * page;
+        total = used + page;
+        void* p = mmap(nullptr, total, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p != MAP_FAILED) {
+            base = (uint8_t*)p;
+            mprotect(base + used, page, PROT_NONE);
+            data = base + used - size;
+            return;
+        }
+#endif
+        fallback.resize(size);
+        data = fallback.data();
+    }
+    GuardedBuffer(const GuardedBuffer&) = delete;
+    ~GuardedBuffer() {
+#if __has_include(<sys/mman.h>)
+        if (base)
+            munmap(base, total);
+#endif
+    }
+};
+// 由旋转后的各向异性盒中的随机点组成, 主轴为axis
+static std::vector<Vec3> make_points(uint32_t n, std::mt19937& rng,
+                                     Vec3& axis) {
+    std::uniform_real_distribution<float> u(-1, 1);
+    Eigen::Quaternionf q(Eigen::AngleAxisf(
+        0.7f, Vec3(0.3f, -0.5f, 0.8f).normalized()));
+    Eigen::Matrix3f rot = q.toRotationMatrix();
+    axis = rot.col(0);
+    std::vector<Vec3> p(n);
+    for (auto& v : p)
+        v = rot * Vec3(u(rng) * 20, u(rng) * 5, u(rng)) + Vec3(-30, -7, 12);
+    return p;
+}
+int main() {
+    std::mt19937 rng(22);
+    const uint32_t counts[] = {0,    1,    2, 3, 4, 5, 7,
+                               1000, 1001, BOUNDS_GRAIN * 2 + 3};
+    for (uint32_t stride : {12u, 16u, 20u, 32u}) {
+        for (uint32_t n : counts) {
+            Vec3 axis;
+            std::vector<Vec3> pts = make_points(n, rng, axis);
+            // 最后一个顶点只有12字节, 紧贴不可读页
+            size_t size = n ? size_t(n - 1) * stride + 12 : 0;
+            GuardedBuffer buf(size);
+            const float pad = 1e30f;
+            for (size_t i = 0; i < size; i += 4)
+                std::memcpy(buf.data + i, &pad, 4);
+            for (uint32_t i = 0; i < n; i++)
+                std::memcpy(buf.data + size_t(i) * stride, pts[i].data(), 12);
+            PointStream s{buf.data, n, stride};
+            Vec3 lo = Vec3::Constant(INFINITY), hi = Vec3::Constant(-INFINITY);
+            for (const Vec3& p : pts) {
+                lo = lo.cwiseMin(p);
+                hi = hi.cwiseMax(p);
+            }
+            for (int level = int(detect_simd_level()); level >= 0; level--) {
+                set_simd_level(SimdLevel(level));
+                AABB<float> box = computeAABB(s);
+                BL_CHECK(box.min() == lo && box.max() == hi,
+                         "stride %u n %u level %d: aabb", stride, n, level);
+                if (n == 0)
+                    BL_CHECK((box.min().array() > box.max().array()).all(),
+                             "empty aabb");
+            }
+            Sphere<float> sp = computeBoundingSphere(s);
+            float far = 0;
+            for (const Vec3& p : pts)
+                far = std::max(far, (p - sp.c()).norm() / sp.r());
+            BL_CHECK(n == 0 ? sp.r() == 0 : far <= 1 || sp.r() == 0,
+                     "stride %u n %u: point at %g radii", stride, n, far);
+            // 结果不应比AABB的外接球大很多
+            BL_CHECK(n < 2 || sp.r() <= (hi - lo).norm() / 2 * 1.05f,
+                     "stride %u n %u: radius %g", stride, n, sp.r());
+            if (n == 1)
+                BL_CHECK(sp.c() == pts[0] && sp.r() == 0, "single point");
+
+            OBB<float> obb = computeOBB(s);
+            Vec3 ax[3] = {obb.u(), obb.v(), obb.w()};
+            bool ortho = true;
+            for (int a = 0; a < 3; a++)
+                for (int b = 0; b < 3; b++)
+                    ortho &= std::abs(ax[a].dot(ax[b]) - (a == b)) < 1e-5f;
+            BL_CHECK(ortho, "stride %u n %u: obb axes", stride, n);
+            float out = 0;
+            for (const Vec3& p : pts)
+                for (int a = 0; a < 3; a++)
+                    out = std::max(out, std::abs((p - obb.c()).dot(ax[a])) -
+                                            obb.h()[a]);
+            BL_CHECK(out <= 1e-4f * 40, "stride %u n %u: point %g outside obb",
+                     stride, n, out);
+            if (n == 0)
+                BL_CHECK(obb.h() == Vec3::Zero(), "empty obb");
+            if (n == 1)
+                BL_CHECK(obb.h().norm() < 1e-4f, "single point obb");
+            if (n == 2) {
+                // 两点时u沿两点连线, 其余半长为0
+                Vec3 d = pts[1] - pts[0];
+                BL_CHECK(std::abs(std::abs(obb.u().dot(d.normalized())) - 1) <
+                                 1e-4f &&
+                             std::abs(obb.h_u() - d.norm() / 2) < 1e-3f &&
+                             obb.h_v() < 1e-3f && obb.h_w() < 1e-3f,
+                         "stride %u: two point obb", stride);
+            }
+            if (n >= 1000) {
+                // 点数足够时主轴与生成时的最长轴一致, 体积小于AABB
+                Vec3 ext = hi - lo;
+                BL_CHECK(std::abs(obb.u().dot(axis)) > 0.99f &&
+                             obb.h().prod() * 8 < ext.prod(),
+                         "stride %u n %u: obb axis %g", stride, n,
+                         obb.u().dot(axis));
+            }
+        }
+    }
+    return bl_test_result();
+}
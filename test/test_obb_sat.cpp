@@ -0,0 +1,108 @@
+// OBB的15轴SAT与按顶点投影的参考实现逐对比较, 批量版本与逐个测试比较
+#include <vector>
+#include "bl_collision_batch.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using BL::vec3;
+static std::mt19937 rng(11);
+static std::uniform_real_distribution<float> u(-1, 1), hs(0.2f, 2.f);
+static OBB<float> random_obb(float spread) {
+    OBB<float> o;
+    vec3<float> x(u(rng), u(rng), u(rng)), y(u(rng), u(rng), u(rng));
+    x.normalize();
+    y = (y - x * x.dot(y)).normalized();
+    o.setBoxSize(x * hs(rng), y * hs(rng), hs(rng));
+    o.setCenter(vec3<float>(u(rng), u(rng), u(rng)) * spread);
+    return o;
+}
+static std::array<vec3<float>, 8> vertices(const OBB<float>& o) {
+    std::array<vec3<float>, 8> v;
+    for (int i = 0; i < 8; i++)
+        v[i] = o.c() + o.u() * ((i & 1 ? 1 : -1) * o.h_u()) +
+               o.v() * ((i & 2 ? 1 : -1) * o.h_v()) +
+               o.w() * ((i & 4 ? 1 : -1) * o.h_w());
+    return v;
+}
+// 参考实现: 两盒的全部顶点投影到15个轴上, 平行边的叉积跳过
+static CollisionResult reference(const OBB<float>& A, const OBB<float>& B) {
+    auto va = vertices(A), vb = vertices(B);
+    vec3<float> ax[3] = {A.u(), A.v(), A.w()}, bx[3] = {B.u(), B.v(), B.w()};
+    std::vector<vec3<float>> axes;
+    for (int i = 0; i < 3; i++) {
+        axes.push_back(ax[i]);
+        axes.push_back(bx[i]);
+        for (int j = 0; j < 3; j++) {
+            vec3<float> c = ax[i].cross(bx[j]);
+            if (c.norm() > 1e-4f)
+                axes.push_back(c.normalized());
+        }
+    }
+    for (const auto& d : axes) {
+        float a0 = 1e30f, a1 = -1e30f, b0 = 1e30f, b1 = -1e30f;
+        for (const auto& p : va) {
+            a0 = std::min(a0, p.dot(d));
+            a1 = std::max(a1, p.dot(d));
+        }
+        for (const auto& p : vb) {
+            b0 = std::min(b0, p.dot(d));
+            b1 = std::max(b1, p.dot(d));
+        }
+        if (a1 < b0 - 1e-6f || b1 < a0 - 1e-6f)
+            return CollisionResult::outer;
+    }
+    float h[3] = {A.h_u(), A.h_v(), A.h_w()};
+    for (const auto& p : vb)
+        for (int k = 0; k < 3; k++)
+            if (std::abs((p - A.c()).dot(ax[k])) >= h[k])
+                return CollisionResult::intersect;
+    return CollisionResult::inner;
+}
+int main() {
+    for (int it = 0; it < 200000; it++) {
+        OBB<float> A = random_obb(2), B = random_obb(2);
+        // 四分之一的B放在A中心附近并缩小, 覆盖包含的情况
+        if (it % 4 == 0) {
+            B.setCenter(A.c() + vec3<float>(u(rng), u(rng), u(rng)) * 0.3f);
+            B._h *= 0.3f;
+        }
+        CollisionResult got = intersectTest(A, B), expect = reference(A, B);
+        BL_CHECK(got == expect, "pair %d: %d vs %d", it, int(got),
+                 int(expect));
+    }
+    // 绕w旋转90度且重叠: 边两两平行, 叉积为零的轴不能判为分离
+    OBB<float> A, B;
+    A.setBoxSize(vec3<float>(1, 0, 0), vec3<float>(0, 1, 0), 1);
+    A.setCenter(vec3<float>(0, 0, 0));
+    B.setBoxSize(vec3<float>(0, 1, 0), vec3<float>(-1, 0, 0), 1);
+    B.setCenter(vec3<float>(0.5f, 0, 0));
+    BL_CHECK(intersectTest(A, B) == CollisionResult::intersect, "rotated 90");
+
+    for (uint32_t n : {0u, 5u, 8u, 13u, 2000u}) {
+        OBBSoA soa;
+        std::vector<OBB<float>> boxes;
+        for (uint32_t i = 0; i < n; i++) {
+            OBB<float> b = random_obb(3);
+            if (i % 5 == 0) {
+                b.setCenter(vec3<float>(u(rng), u(rng), u(rng)) * 0.2f);
+                b._h *= 0.2f;
+            }
+            boxes.push_back(b);
+            soa.push_back(b);
+        }
+        for (int level = int(detect_simd_level()); level >= 0; level--) {
+            set_simd_level(SimdLevel(level));
+            for (int q = 0; q < 50; q++) {
+                OBB<float> query = random_obb(1);
+                query._h *= 2;
+                // 末尾的哨兵检查不写越界
+                std::vector<uint8_t> res(n + 1, 77);
+                intersectTestBatch(query, soa, res.data());
+                BL_CHECK(res[n] == 77, "n=%u level %d: overrun", n, level);
+                for (uint32_t i = 0; i < n; i++)
+                    BL_CHECK(res[i] == uint8_t(intersectTest(query, boxes[i])),
+                             "n=%u level %d box %u", n, level, i);
+            }
+        }
+    }
+    return bl_test_result();
+}
@@ -0,0 +1,79 @@
+// OctTree::build与逐个insert的结果一致: 每个对象落在同一大小的节点上,
+// 且查询返回相同的对象集合
+#include <algorithm>
+#include <vector>
+#include "bl_octtree.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using Tree = OctTree<int, float>;
+int main() {
+    const int n = 50000;
+    std::mt19937 rng(2);
+    std::vector<Tree::Box> boxes(n);
+    std::vector<int> data(n);
+    for (int i = 0; i < n; i++) {
+        // 部分对象越出根节点, 两种方式都应拒绝
+        boxes[i] = random_box(rng, 99, 0.01f, 2);
+        data[i] = i;
+    }
+    Tree::Box root{{100, 100, 100}, {-100, -100, -100}};
+    Tree a, b;
+    a.create(root);
+    b.create(root);
+    std::vector<uint32_t> ha(n), hb(n);
+    int inserted = 0;
+    for (int i = 0; i < n; i++) {
+        uint32_t node;
+        ha[i] = a.insert(boxes[i], &node);
+        if (ha[i] != Tree::NULL_NEXT) {
+            a.data(ha[i]) = i;
+            inserted++;
+        }
+    }
+    uint32_t built = b.build(boxes, std::span<int>(data), hb);
+    BL_CHECK(built == uint32_t(inserted), "%u vs %d", built, inserted);
+    for (int i = 0; i < n; i++) {
+        bool va = ha[i] != Tree::NULL_NEXT, vb = hb[i] != Tree::NULL_NEXT;
+        BL_CHECK(va == vb, "object %d", i);
+        if (!va || !vb)
+            continue;
+        BL_CHECK(b.data(hb[i]) == i, "object %d data %d", i, b.data(hb[i]));
+        const Tree::Box& na = a.node(a.nodeOf(ha[i])).sizeBox;
+        const Tree::Box& nb = b.node(b.nodeOf(hb[i])).sizeBox;
+        BL_CHECK(na._max == nb._max && na._min == nb._min, "object %d", i);
+        BL_CHECK(a.node(a.nodeOf(ha[i])).count ==
+                     b.node(b.nodeOf(hb[i])).count,
+                 "object %d", i);
+    }
+    auto same_queries = [&](const char* stage) {
+        for (int q = 0; q < 200; q++) {
+            Tree::Box qb = random_box(rng, 99, 1, 12);
+            std::vector<int> x, y;
+            a.find(qb, [&](const Tree::Box&, int& v) { x.push_back(v); });
+            b.find(qb, [&](const Tree::Box&, int& v) { y.push_back(v); });
+            std::sort(x.begin(), x.end());
+            std::sort(y.begin(), y.end());
+            BL_CHECK(x == y, "%s query %d: %zu vs %zu hits", stage, q,
+                     x.size(), y.size());
+        }
+    };
+    same_queries("initial");
+    // 构建后的树可以继续移动与删除, 结果仍与逐个insert的树一致
+    for (int i = 0; i < n; i += 3) {
+        // move越出根节点会抛出异常, 跳过贴近边界的对象
+        if (ha[i] == Tree::NULL_NEXT || hb[i] == Tree::NULL_NEXT ||
+            boxes[i]._max.x() > 99 || boxes[i]._min.z() < -99)
+            continue;
+        a.move(ha[i], Tree::Vec3(0.5f, 0, -0.25f));
+        b.move(hb[i], Tree::Vec3(0.5f, 0, -0.25f));
+    }
+    same_queries("move");
+    for (int i = 1; i < n; i += 3) {
+        if (ha[i] == Tree::NULL_NEXT || hb[i] == Tree::NULL_NEXT)
+            continue;
+        a.drop(ha[i]);
+        b.drop(hb[i]);
+    }
+    same_queries("drop");
+    return bl_test_result();
+}
@@ -0,0 +1,51 @@
+// OctTree::cull与逐个对象测试平面的结果一致, 不定义BL_OCTTREE_STATS构建,
+// 覆盖整棵子树位于视锥体内直接输出的路径
+#include <algorithm>
+#include <vector>
+#include "bl_octtree.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using Tree = OctTree<int, float>;
+int main() {
+    const int n = 100000;
+    std::mt19937 rng(3);
+    std::vector<Tree::Box> boxes(n);
+    std::vector<int> data(n);
+    std::vector<uint32_t> handles(n);
+    for (int i = 0; i < n; i++) {
+        boxes[i] = random_box(rng, 99, 0.01f, 2);
+        data[i] = i;
+    }
+    Tree t;
+    t.create({{100, 100, 100}, {-100, -100, -100}});
+    t.build(boxes, std::span<int>(data), handles);
+    std::uniform_real_distribution<float> u(-50, 50), d(-1, 1), r(20, 200);
+    for (int q = 0; q < 60; q++) {
+        std::array<Plane<float>, 6> planes;
+        Tree::Vec3 c(u(rng), u(rng), u(rng));
+        // 后几次的平面足够远, 整棵树都在内侧
+        float rmin = q < 50 ? 20 : 400;
+        for (auto& p : planes) {
+            Tree::Vec3 nrm(d(rng), d(rng), d(rng));
+            nrm.normalize();
+            p.set(nrm, -nrm.dot(c) - std::max(rmin, r(rng)));
+        }
+        std::vector<uint32_t> got, expect;
+        t.cull(planes, got);
+        for (int i = 0; i < n; i++) {
+            if (handles[i] == Tree::NULL_NEXT)
+                continue;
+            bool visible = std::none_of(
+                planes.begin(), planes.end(), [&](const Plane<float>& p) {
+                    return intersectTest(p, boxes[i]) == CollisionResult::outer;
+                });
+            if (visible)
+                expect.push_back(handles[i]);
+        }
+        std::sort(got.begin(), got.end());
+        std::sort(expect.begin(), expect.end());
+        BL_CHECK(got == expect, "frustum %d: %zu vs %zu objects", q,
+                 got.size(), expect.size());
+    }
+    return bl_test_result();
+}
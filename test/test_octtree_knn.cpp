@@ -0,0 +1,86 @@
+// OctTree::knn与radius和逐个对象计算距离的结果一致, 包括复用KnnScratch与
+// 追加输出的版本; 树由insert与commitMoves得到, 对象留在各层节点中
+#include <algorithm>
+#include <vector>
+#include "bl_octtree.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using Tree = OctTree<uint32_t, float>;
+using Vec3 = Tree::Vec3;
+int main() {
+    const uint32_t n = 30000;
+    std::mt19937 rng(8);
+    Tree t;
+    t.create({{100, 100, 100}, {-100, -100, -100}});
+    std::vector<Tree::Box> boxes(n);
+    std::vector<uint32_t> handles(n);
+    for (uint32_t i = 0; i < n; i++) {
+        // 少数大对象留在浅层节点
+        boxes[i] = i % 50 ? random_box(rng, 90, 0.05f, 1.5f)
+                          : random_box(rng, 80, 2, 15);
+        uint32_t node;
+        handles[i] = t.insert(boxes[i], &node);
+        t.data(handles[i]) = i;
+    }
+    std::uniform_real_distribution<float> u(-120, 120), d(-3, 3), s(0, 1);
+    // 移出根范围的移动被拒绝, 对象留在原位
+    std::vector<Tree::Box> before = boxes;
+    for (uint32_t i = 0; i < n; i += 3) {
+        Vec3 delta(d(rng), d(rng), d(rng));
+        if (i % 300 == 0)
+            delta.y() -= 300;
+        t.queueMove(handles[i], delta);
+        boxes[i] = {boxes[i].max() + delta, boxes[i].min() + delta};
+    }
+    std::vector<uint32_t> rejected;
+    t.commitMoves(&rejected);
+    BL_CHECK(rejected.size() == (n + 299) / 300, "%zu moves rejected",
+             rejected.size());
+    for (uint32_t b : rejected)
+        boxes[t.data(b)] = before[t.data(b)];
+    Tree::KnnScratch scratch;
+    std::vector<Tree::NearHit> got;
+    std::vector<float> dist(n);
+    for (int q = 0; q < 300; q++) {
+        // 部分查询点在根范围之外
+        Vec3 p(u(rng), u(rng), u(rng));
+        for (uint32_t i = 0; i < n; i++)
+            dist[i] = distanceSquared(p, boxes[i]);
+        std::vector<float> sorted = dist;
+        std::sort(sorted.begin(), sorted.end());
+        uint32_t k = q % 7 == 0 ? 1 : 1 + rng() % 64;
+        if (q == 0)
+            k = 0;
+        uint32_t count = t.knn(p, k, got, scratch);
+        bool ok = count == k && got.size() == k;
+        for (uint32_t j = 0; ok && j < k; j++)
+            ok = got[j].dist2 == sorted[j] &&
+                 dist[t.data(got[j].block)] == got[j].dist2;
+        BL_CHECK(ok, "knn %d (k=%u): %u results", q, k, count);
+        std::vector<Tree::NearHit> alloc = t.knn(p, k);
+        BL_CHECK(alloc.size() == got.size() &&
+                     std::equal(alloc.begin(), alloc.end(), got.begin(),
+                                [](const auto& a, const auto& b) {
+                                    return a.dist2 == b.dist2;
+                                }),
+                 "knn %d: allocating version differs", q);
+
+        float r = q % 5 == 0 ? 0 : 20 * s(rng);
+        std::vector<uint32_t> out{12345}, expect;
+        t.radius(p, r, out);
+        BL_CHECK(out[0] == 12345, "radius %d: output not appended", q);
+        std::vector<uint32_t> objs;
+        for (size_t j = 1; j < out.size(); j++)
+            objs.push_back(t.data(out[j]));
+        for (uint32_t i = 0; i < n; i++)
+            if (dist[i] <= r * r)
+                expect.push_back(i);
+        std::sort(objs.begin(), objs.end());
+        BL_CHECK(objs == expect, "radius %d (r=%g): %zu vs %zu", q, r,
+                 objs.size(), expect.size());
+        std::vector<uint32_t> alloc2 = t.radius(p, r);
+        BL_CHECK(alloc2.size() == out.size() - 1,
+                 "radius %d: allocating version differs", q);
+    }
+    return bl_test_result();
+}
@@ -0,0 +1,125 @@
+// queueMove/commitMoves后find, raycast, radius与cull和逐个对象测试的结果一致
+// 每帧有少量对象被移出根范围, 须被拒绝并留在原位; 同一对象可被多次记录
+#include <algorithm>
+#include <vector>
+#include "bl_octtree.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using Tree = OctTree<uint32_t, float>;
+using Vec3 = Tree::Vec3;
+int main() {
+    const uint32_t n = 20000;
+    std::mt19937 rng(6);
+    Tree::Box root{{100, 100, 100}, {-100, -100, -100}};
+    Tree t;
+    t.create(root);
+    std::vector<Tree::Box> boxes(n);
+    std::vector<uint32_t> handles(n);
+    for (uint32_t i = 0; i < n; i++) {
+        boxes[i] = random_box(rng, 95, 0.05f, 2);
+        uint32_t node;
+        handles[i] = t.insert(boxes[i], &node);
+        t.data(handles[i]) = i;
+    }
+    std::uniform_real_distribution<float> u(-90, 90), d(-1, 1), s(0, 1);
+    auto sorted = [](std::vector<uint32_t> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    };
+    for (int frame = 0; frame < 20; frame++) {
+        // 参照数据按记录顺序逐次平移, 与树中的浮点结果相同
+        std::vector<Tree::Box> moved = boxes;
+        std::vector<uint8_t> queued(n, 0);
+        for (uint32_t k = 0; k < n / 4; k++) {
+            uint32_t i = rng() % n;
+            float scale = s(rng) < 0.1f ? 20 : 1;
+            Vec3 delta = Vec3(d(rng), d(rng), d(rng)) * scale;
+            if (k % 500 == 0)
+                delta.x() += 500;  // 移出根范围
+            t.queueMove(handles[i], delta);
+            moved[i].min() += delta;
+            moved[i].max() += delta;
+            queued[i] = 1;
+        }
+        std::vector<uint32_t> rejected{12345}, expectRejected{12345};
+        for (uint32_t i = 0; i < n; i++) {
+            if (!queued[i])
+                continue;
+            if (intersectTest(root, moved[i]) != CollisionResult::inner)
+                expectRejected.push_back(handles[i]);
+            else
+                boxes[i] = moved[i];
+        }
+        t.commitMoves(&rejected);
+        BL_CHECK(sorted(rejected) == sorted(expectRejected),
+                 "frame %d: %zu rejected, expected %zu", frame,
+                 rejected.size() - 1, expectRejected.size() - 1);
+        for (uint32_t i = 0; i < n; i++) {
+            const Tree::Box& b = t.block(handles[i]).objectBox;
+            BL_CHECK(b.min() == boxes[i].min() && b.max() == boxes[i].max(),
+                     "frame %d: box of object %u", frame, i);
+        }
+        for (int q = 0; q < 50; q++) {
+            Vec3 c(u(rng), u(rng), u(rng));
+            // find
+            Tree::Box area{c + Vec3::Constant(8), c - Vec3::Constant(8)};
+            std::vector<uint32_t> got, expect;
+            t.find(area, [&](const Tree::Box&, uint32_t& i) {
+                got.push_back(i);
+            });
+            for (uint32_t i = 0; i < n; i++)
+                if (intersectTest(area, boxes[i]) >=
+                    CollisionResult::intersect)
+                    expect.push_back(i);
+            BL_CHECK(sorted(got) == expect, "frame %d find %d: %zu vs %zu",
+                     frame, q, got.size(), expect.size());
+            // radius
+            got.clear(), expect.clear();
+            float r = 10 * s(rng);
+            for (uint32_t b : t.radius(c, r))
+                got.push_back(t.data(b));
+            for (uint32_t i = 0; i < n; i++)
+                if (distanceSquared(c, boxes[i]) <= r * r)
+                    expect.push_back(i);
+            BL_CHECK(sorted(got) == expect, "frame %d radius %d: %zu vs %zu",
+                     frame, q, got.size(), expect.size());
+            // raycast, 最近交点的距离与逐个测试的最小值相同
+            Vec3 dir = Vec3(d(rng), d(rng), d(rng)).normalized();
+            Vec3 invD = dir.cwiseInverse();
+            Tree::RayHit hit = t.raycast(c, dir, 300);
+            float best = 300, tt;
+            uint32_t bestObj = n;
+            for (uint32_t i = 0; i < n; i++)
+                if (intersectRay(c, invD, boxes[i], 0.0f, 300.0f, &tt) &&
+                    (tt < best || bestObj == n))
+                    best = tt, bestObj = i;
+            BL_CHECK((hit.block == Tree::NULL_NEXT) == (bestObj == n) &&
+                         (bestObj == n || hit.t == best),
+                     "frame %d ray %d: t %g vs %g", frame, q, hit.t, best);
+        }
+        // cull
+        for (int q = 0; q < 5; q++) {
+            std::array<Plane<float>, 6> planes;
+            Vec3 c(u(rng), u(rng), u(rng));
+            for (auto& p : planes) {
+                Vec3 nrm = Vec3(d(rng), d(rng), d(rng)).normalized();
+                p.set(nrm, -nrm.dot(c) - 20 - 60 * s(rng));
+            }
+            std::vector<uint32_t> got, expect;
+            std::vector<uint32_t> blocks;
+            t.cull(planes, blocks);
+            for (uint32_t b : blocks)
+                got.push_back(t.data(b));
+            for (uint32_t i = 0; i < n; i++)
+                if (std::none_of(planes.begin(), planes.end(),
+                                 [&](const Plane<float>& p) {
+                                     return intersectTest(p, boxes[i]) ==
+                                            CollisionResult::outer;
+                                 }))
+                    expect.push_back(i);
+            BL_CHECK(sorted(got) == expect, "frame %d cull %d: %zu vs %zu",
+                     frame, q, got.size(), expect.size());
+        }
+    }
+    return bl_test_result();
+}
@@ -0,0 +1,147 @@
+// OctTree::save/load的往返: 载入后查询结果与数据块索引和原树相同,
+// 之后的插入, 删除与移动也一致; 损坏, 截断或布局不符的文件被拒绝且树不变
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "bl_octtree.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using Tree = OctTree<uint32_t, float>;
+using Vec3 = Tree::Vec3;
+// 一组固定查询的结果, 以数据块索引表示
+static std::vector<uint32_t> query_all(const Tree& t, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> u(-90, 90), d(-1, 1);
+    std::vector<uint32_t> res;
+    Tree& mt = const_cast<Tree&>(t);
+    for (int q = 0; q < 100; q++) {
+        Vec3 c(u(rng), u(rng), u(rng));
+        Tree::Box area{c + Vec3::Constant(6), c - Vec3::Constant(6)};
+        std::vector<uint32_t> found;
+        mt.find(area, [&](const Tree::Box&, uint32_t& i) {
+            found.push_back(i);
+        });
+        std::sort(found.begin(), found.end());
+        res.insert(res.end(), found.begin(), found.end());
+        res.push_back(t.raycast(c, Vec3(d(rng), d(rng), d(rng)), 200).block);
+        for (const auto& h : t.knn(c, 5))
+            res.push_back(h.block);
+        std::vector<uint32_t> near = t.radius(c, 5);
+        std::sort(near.begin(), near.end());
+        res.insert(res.end(), near.begin(), near.end());
+    }
+    return res;
+}
+static void write_bytes(const std::string& path,
+                        const std::vector<char>& bytes) {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f.write(bytes.data(), bytes.size());
+}
+int main() {
+    // 载入失败时的错误日志写到std::cerr, 测试中关闭
+    std::cerr.rdbuf(nullptr);
+    auto tmp = std::filesystem::temp_directory_path();
+    std::string path = (tmp / "bl_test_octtree.snap").string();
+    std::string bad = (tmp / "bl_test_octtree_bad.snap").string();
+    const uint32_t n = 20000;
+    std::mt19937 rng(11);
+    Tree a;
+    a.create({{100, 100, 100}, {-100, -100, -100}});
+    std::vector<uint32_t> handles(n);
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t node;
+        handles[i] = a.insert(random_box(rng, 95, 0.05f, 3), &node);
+        a.data(handles[i]) = i;
+    }
+    // 删除一部分, 使空闲块链表与回收的节点组非空
+    for (uint32_t i = 0; i < n; i += 7) {
+        a.drop(handles[i]);
+        handles[i] = Tree::NULL_NEXT;
+    }
+    a.save(path);
+    std::vector<uint32_t> expect = query_all(a, 1);
+
+    Tree b;
+    b.create({{1, 1, 1}, {-1, -1, -1}});
+    BL_CHECK(b.load(path), "load failed");
+    BL_CHECK(query_all(b, 1) == expect, "queries differ after load");
+    for (uint32_t i = 0; i < n; i++)
+        if (handles[i] != Tree::NULL_NEXT)
+            BL_CHECK(b.data(handles[i]) == i &&
+                         b.nodeOf(handles[i]) == a.nodeOf(handles[i]),
+                     "block %u differs", handles[i]);
+    // 载入后的修改与原树相同: 复用同样的空闲块, 得到同样的节点
+    std::uniform_real_distribution<float> d(-2, 2);
+    for (int k = 0; k < 3000; k++) {
+        uint32_t i = rng() % n;
+        if (handles[i] == Tree::NULL_NEXT) {
+            Tree::Box box = random_box(rng, 95, 0.05f, 3);
+            uint32_t na, nb;
+            uint32_t ha = a.insert(box, &na), hb = b.insert(box, &nb);
+            BL_CHECK(ha == hb && na == nb, "insert %d: %u vs %u", k, ha, hb);
+            a.data(ha) = b.data(hb) = i;
+            handles[i] = ha;
+        } else if (k % 3 == 0) {
+            BL_CHECK(a.drop(handles[i]) == b.drop(handles[i]), "drop %d", k);
+            handles[i] = Tree::NULL_NEXT;
+        } else {
+            Vec3 delta(d(rng), d(rng), d(rng));
+            a.queueMove(handles[i], delta);
+            b.queueMove(handles[i], delta);
+        }
+    }
+    std::vector<uint32_t> ra, rb;
+    BL_CHECK(a.commitMoves(&ra) == b.commitMoves(&rb) && ra == rb,
+             "commitMoves differs");
+    expect = query_all(a, 2);
+    BL_CHECK(query_all(b, 2) == expect, "queries differ after edits");
+
+    // 拒绝的文件: 树保持不变
+    a.save(path);
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> good((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+    in.close();
+    std::vector<char> flipped = good;
+    flipped[good.size() / 2] ^= 0x10;
+    write_bytes(bad, flipped);
+    BL_CHECK(!b.load(bad), "corrupt file accepted");
+    write_bytes(bad, std::vector<char>(good.begin(), good.end() - 100));
+    BL_CHECK(!b.load(bad), "truncated file accepted");
+    std::vector<char> wrongHead = good;
+    wrongHead[0] ^= 1;
+    write_bytes(bad, wrongHead);
+    BL_CHECK(!b.load(bad), "wrong head accepted");
+    BL_CHECK(!b.load((tmp / "bl_test_no_such_file.snap").string()),
+             "missing file accepted");
+    {
+        // CRC正确但各数组长度与文件大小不符
+        BL::File::FileWriter w(bad, Tree::SNAPSHOT_HEAD,
+                               Tree::SNAPSHOT_VERSION);
+        Tree::SnapshotInfo info = {.dataSize = sizeof(uint32_t),
+                                   .scalarSize = sizeof(float),
+                                   .nodeMaxData = 12,
+                                   .nodeMaxLayer = 8,
+                                   .nodeCount = 1000,
+                                   .groupCount = 1,
+                                   .freeCount = 0,
+                                   .blockUsed = 0,
+                                   .blockFreeHead = Tree::NULL_NEXT};
+        w.write(&info);
+        w.close();
+        BL_CHECK(!b.load(bad), "size mismatch accepted");
+    }
+    BL_CHECK(query_all(b, 2) == expect, "tree changed by a failed load");
+    // 数据类型或标量类型不同的树
+    OctTree<uint64_t, float> wideData;
+    wideData.create({{1, 1, 1}, {-1, -1, -1}});
+    BL_CHECK(!wideData.load(path), "data size mismatch accepted");
+    OctTree<uint32_t, double> wideScalar;
+    wideScalar.create({{1, 1, 1}, {-1, -1, -1}});
+    BL_CHECK(!wideScalar.load(path), "scalar size mismatch accepted");
+    std::filesystem::remove(path);
+    std::filesystem::remove(bad);
+    return bl_test_result();
+}
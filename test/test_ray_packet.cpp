@@ -0,0 +1,123 @@
+// 射线包与逐条射线的结果一致: slab内核与BVH::raycastPacket在各指令集下
+// 与intersectRay/raycast比较, 包括起点落在盒面上且方向分量为0的射线
+// (该分量为0 * inf = NaN, 须与标量实现一样处理: 落在min面上时该轴被忽略,
+// 落在max面上时不命中)
+#include <vector>
+#include "bl_bvh.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using Bvh = BVH<uint32_t, float>;
+using V = BL::vec3<float>;
+// 盒(i, j, k)各轴为[2i - 1, 2i], 编号i + 10j + 100k
+static AABB<float> cell(uint32_t i, uint32_t j, uint32_t k) {
+    V hi(2.0f * i, 2.0f * j, 2.0f * k);
+    return {hi, hi - V::Constant(1)};
+}
+// 起点与方向的第a轴取盒面坐标与0, 其余随机
+static void face_ray(std::mt19937& rng, const AABB<float>& b, V& o, V& d) {
+    std::uniform_real_distribution<float> u(-1, 1);
+    o = b.c() + V(u(rng), u(rng), u(rng)).cwiseProduct(b.h()) * 3;
+    d = V(u(rng), u(rng), u(rng));
+    uint32_t a = rng() % 3;
+    o[a] = rng() & 1 ? b.max()[a] : b.min()[a];
+    d[a] = 0;
+    if (rng() % 4 == 0) {
+        uint32_t a2 = (a + 1) % 3;
+        o[a2] = rng() & 1 ? b.max()[a2] : b.min()[a2];
+        d[a2] = 0;
+    }
+}
+template <uint32_t N>
+static void check_kernel(std::mt19937& rng, int level) {
+    for (int it = 0; it < 20000; it++) {
+        AABB<float> b = random_box(rng, 20, 0.1f, 5);
+        RayPacket<N> p;
+        V o[N], d[N];
+        for (uint32_t i = 0; i < N; i++) {
+            face_ray(rng, b, o[i], d[i]);
+            p.set(i, o[i], d[i], it % 3 ? 50.0f : INFINITY);
+        }
+        uint32_t active =
+            it % 5 ? RayPacket<N>::ALL : rng() & RayPacket<N>::ALL;
+        alignas(32) float tHit[N];
+        uint32_t m = intersectRayPacket(p, b, tHit, active);
+        for (uint32_t i = 0; i < N; i++) {
+            float t;
+            bool hit = (active >> i & 1) &&
+                       intersectRay(o[i], V(d[i].cwiseInverse()), b, 0.0f,
+                                    p.tMax[i], &t);
+            BL_CHECK(hit == bool(m >> i & 1) && (!hit || t == tHit[i]),
+                     "N=%u level %d ray %u: %d vs %d", N, level, i, hit,
+                     int(m >> i & 1));
+        }
+    }
+}
+int main() {
+    std::mt19937 rng(19);
+    for (int level = int(detect_simd_level()); level >= 0; level--) {
+        set_simd_level(SimdLevel(level));
+        check_kernel<4>(rng, level);
+        check_kernel<8>(rng, level);
+    }
+    // 格点场景, 射线贴着盒面沿坐标轴穿过
+    std::vector<Bvh::Box> boxes;
+    std::vector<uint32_t> data;
+    for (uint32_t k = 0; k < 10; k++)
+        for (uint32_t j = 0; j < 10; j++)
+            for (uint32_t i = 0; i < 10; i++) {
+                data.push_back(boxes.size());
+                boxes.push_back(cell(i, j, k));
+            }
+    // 随机盒放在射线起点范围之外, 避免起点落在多个盒内时t = 0的并列
+    for (int it = 0; it < 2000; it++) {
+        AABB<float> b = random_box(rng, 30, 0.05f, 1);
+        boxes.push_back({b.max() + V(60, 0, 0), b.min() + V(60, 0, 0)});
+    }
+    for (uint32_t i = 1000; i < boxes.size(); i++)
+        data.push_back(i);
+    Bvh bvh;
+    bvh.build(boxes, std::span<uint32_t>(data));
+    for (int level = int(detect_simd_level()); level >= 0; level--) {
+        set_simd_level(SimdLevel(level));
+        // 起点(-10, 3, z)沿+x, y = 3为盒20的min面, 在t = 9处命中
+        RayPacket8 p;
+        for (uint32_t i = 0; i < 8; i++)
+            p.set(i, V(-10, 3, -0.1f - 0.1f * i), V(1, 0, 0));
+        std::array<Bvh::RayHit, 8> hits;
+        bvh.raycastPacket(p, hits);
+        for (uint32_t i = 0; i < 8; i++)
+            BL_CHECK(hits[i].prim == 20 && hits[i].t == 9.0f,
+                     "level %d ray %u: prim %u t %g", level, i, hits[i].prim,
+                     hits[i].t);
+        std::uniform_real_distribution<float> u(-25, 25);
+        for (int it = 0; it < 4000; it++) {
+            RayPacket8 q;
+            V o[8], d[8];
+            for (uint32_t i = 0; i < 8; i++) {
+                if (it % 2) {
+                    // 随机格点盒的面
+                    face_ray(rng, boxes[rng() % 1000], o[i], d[i]);
+                } else {
+                    o[i] = V(u(rng), u(rng), u(rng));
+                    d[i] = V(u(rng), u(rng), u(rng)).normalized();
+                }
+                q.set(i, o[i], d[i], it % 3 ? 40.0f : INFINITY);
+            }
+            uint32_t active = it % 4 ? RayPacket8::ALL : rng() & 0xFF;
+            for (uint32_t i = 0; i < 8; i++)
+                hits[i] = {12345, -1};
+            bvh.raycastPacket(q, hits, active);
+            for (uint32_t i = 0; i < 8; i++) {
+                if (!(active >> i & 1)) {
+                    BL_CHECK(hits[i].prim == 12345, "inactive ray %u", i);
+                    continue;
+                }
+                Bvh::RayHit h = bvh.raycast(o[i], d[i], q.tMax[i]);
+                BL_CHECK(h.prim == hits[i].prim && h.t == hits[i].t,
+                         "level %d ray %u: %u %g vs %u %g", level, i, h.prim,
+                         h.t, hits[i].prim, hits[i].t);
+            }
+        }
+    }
+    return bl_test_result();
+}
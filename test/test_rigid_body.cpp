@@ -0,0 +1,118 @@
+// contactOBB的面接触, 棱接触, margin内的预测接触与分离的情况;
+// RigidWorld中落到地面的盒(包括倾斜落下的)在若干步后静止, 穿透有界
+#include <algorithm>
+#include <cmath>
+#include "bl_rigid_body.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using World = RigidWorld<float>;
+using Vec3 = World::Vec3;
+using Quat = World::Quat;
+static OBB<float> cube(const Vec3& c, const Quat& q = Quat::Identity()) {
+    Eigen::Matrix3f r = q.toRotationMatrix();
+    return {c, r.col(0), r.col(1), Vec3::Constant(0.5f)};
+}
+static Quat rot(float angle, const Vec3& axis) {
+    return Quat(Eigen::AngleAxisf(angle, axis));
+}
+static void test_contact() {
+    const float margin = 0.02f;
+    Vec3 n;
+    ContactPoint<float> p[4];
+    // 面接触: B绕y轴转动后压在A的顶面上, 入射面被裁剪成八边形后保留4个点
+    for (float side : {1.0f, -1.0f}) {
+        OBB<float> A = cube(Vec3::Zero());
+        Quat q = rot(0.3f, Vec3::UnitY());
+        OBB<float> B = cube(Vec3(0, 0.95f * side, 0), q);
+        uint32_t count = contactOBB(A, B, margin, n, p);
+        BL_CHECK(count == 4 && n.dot(Vec3::UnitY() * side) > 0.9999f,
+                 "face %g: %u points, normal %g %g %g", side, count, n.x(),
+                 n.y(), n.z());
+        for (uint32_t i = 0; i < count; i++)
+            BL_CHECK(std::abs(p[i].separation + 0.05f) < 1e-4f &&
+                         std::abs(p[i].position.y() - 0.475f * side) <
+                             1e-4f &&
+                         std::abs(p[i].position.x()) <= 0.5f + 1e-4f &&
+                         std::abs(p[i].position.z()) <= 0.5f + 1e-4f,
+                     "face %g point %u: sep %g at %g %g %g", side, i,
+                     p[i].separation, p[i].position.x(), p[i].position.y(),
+                     p[i].position.z());
+    }
+    // 小盒B的面为参考面: 法线仍从A指向B
+    {
+        OBB<float> A = cube(Vec3::Zero(), rot(0.2f, Vec3::UnitY()));
+        OBB<float> B{Vec3(0, -2.48f, 0), Vec3::UnitX(), Vec3::UnitY(),
+                     Vec3(3, 2, 3)};
+        uint32_t count = contactOBB(A, B, margin, n, p);
+        BL_CHECK(count == 4 && n.dot(-Vec3::UnitY()) > 0.9999f,
+                 "face on B: %u points, normal y %g", count, n.y());
+        for (uint32_t i = 0; i < count; i++)
+            BL_CHECK(std::abs(p[i].separation + 0.02f) < 1e-4f,
+                     "face on B point %u: sep %g", i, p[i].separation);
+    }
+    // 棱接触: A的顶棱沿x, B的底棱沿z, 两棱垂直相交, 只有1个点
+    const float r2 = std::sqrt(2.0f) / 2;
+    OBB<float> A = cube(Vec3::Zero(), rot(float(M_PI) / 4, Vec3::UnitX()));
+    Quat qB = rot(float(M_PI) / 4, Vec3::UnitZ());
+    OBB<float> B = cube(Vec3(0.1f, 2 * r2 - 0.02f, -0.1f), qB);
+    uint32_t count = contactOBB(A, B, margin, n, p);
+    BL_CHECK(count == 1 && n.dot(Vec3::UnitY()) > 0.9999f &&
+                 std::abs(p[0].separation + 0.02f) < 1e-4f &&
+                 (p[0].position - Vec3(0.1f, r2 - 0.01f, 0)).norm() < 1e-4f,
+             "edge: %u points, normal y %g, sep %g at %g %g %g", count, n.y(),
+             p[0].separation, p[0].position.x(), p[0].position.y(),
+             p[0].position.z());
+    // margin以内的间隙: 分离距离为正的预测接触
+    count = contactOBB(A, cube(Vec3(0, 2 * r2 + 0.01f, 0), qB), margin, n, p);
+    BL_CHECK(count == 1 && std::abs(p[0].separation - 0.01f) < 1e-4f,
+             "edge gap: %u points, sep %g", count, p[0].separation);
+    count = contactOBB(cube(Vec3::Zero()), cube(Vec3(0, 1.01f, 0)), margin, n,
+                       p);
+    BL_CHECK(count == 4 && std::abs(p[0].separation - 0.01f) < 1e-4f,
+             "face gap: %u points, sep %g", count, p[0].separation);
+    // 分离超过margin: 只有棱叉积轴分离, 以及面轴分离的情况
+    count = contactOBB(A, cube(Vec3(0, 2 * r2 + 0.1f, 0), qB), margin, n, p);
+    BL_CHECK(count == 0, "edge separated: %u points", count);
+    count = contactOBB(cube(Vec3::Zero()), cube(Vec3(1.2f, 0.3f, 0)), margin,
+                       n, p);
+    BL_CHECK(count == 0, "face separated: %u points", count);
+}
+static void test_settle() {
+    World w;
+    w.addBox(Vec3(10, 1, 10), Vec3(0, -1, 0), 0);
+    uint32_t flat = w.addBox(Vec3::Constant(0.5f), Vec3(-2, 0.8f, 0), 1);
+    uint32_t tilted =
+        w.addBox(Vec3::Constant(0.5f), Vec3(2, 1.5f, 0.5f), 1,
+                 rot(0.35f, Vec3(1, 0, 0.4f).normalized()));
+    // 落地后每步的最大穿透
+    float maxPen = 0;
+    for (int s = 0; s < 240; s++) {
+        w.step(1.0f / 60);
+        for (const auto& m : w.getManifolds())
+            for (uint32_t k = 0; s >= 60 && k < m.count; k++)
+                maxPen = std::max(maxPen, -m.points[k].separation);
+    }
+    BL_CHECK(maxPen < w.settings.slop + 0.01f && w.contactCount() >= 8,
+             "penetration %g, %u contacts", maxPen, w.contactCount());
+    for (uint32_t id : {flat, tilted}) {
+        const World::Body& b = w.body(id);
+        // 静止在某个面上: 中心高0.5, 有一个轴竖直
+        Eigen::Matrix3f r = b.orientation.toRotationMatrix();
+        float up = r.row(1).cwiseAbs().maxCoeff();
+        BL_CHECK(b.linearVelocity.norm() < 0.02f &&
+                     b.angularVelocity.norm() < 0.05f,
+                 "body %u: v %g, w %g", id, b.linearVelocity.norm(),
+                 b.angularVelocity.norm());
+        BL_CHECK(std::abs(b.position.y() - 0.5f) < 0.02f && up > 0.999f,
+                 "body %u: height %g, up %g", id, b.position.y(), up);
+    }
+    BL_CHECK(std::abs(w.body(flat).position.x() + 2) < 0.01f &&
+                 std::abs(w.body(flat).position.z()) < 0.01f,
+             "flat box drifted to %g %g", w.body(flat).position.x(),
+             w.body(flat).position.z());
+}
+int main() {
+    test_contact();
+    test_settle();
+    return bl_test_result();
+}
@@ -0,0 +1,176 @@
+// intersectSweep的接触时间与把位移分成小步逐步测试的结果一致(AABB与OBB),
+// 轴对齐的OBB与AABB的结果相同; OctTree::sweep与逐个对象调用intersectSweep一致,
+// 包括只取最早k个时的顺序
+#include <algorithm>
+#include <vector>
+#include "bl_octtree.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using BL::vec3;
+using Vec3 = vec3<float>;
+static std::mt19937 rng(21);
+static std::uniform_real_distribution<float> u(-1, 1), hs(0.2f, 2.f);
+static OBB<float> random_obb(const Vec3& c) {
+    OBB<float> o;
+    Vec3 x(u(rng), u(rng), u(rng)), y(u(rng), u(rng), u(rng));
+    x.normalize();
+    y = (y - x * x.dot(y)).normalized();
+    o.setBoxSize(x * hs(rng), y * hs(rng), hs(rng));
+    o.setCenter(c);
+    return o;
+}
+static AABB<float> moved(const AABB<float>& b, const Vec3& d) {
+    return {b.max() + d, b.min() + d};
+}
+static OBB<float> moved(OBB<float> b, const Vec3& d) {
+    b.setCenter(b.c() + d);
+    return b;
+}
+static AABB<float> grown(const AABB<float>& b, float e) {
+    return {b.max() + Vec3::Constant(e), b.min() - Vec3::Constant(e)};
+}
+static OBB<float> grown(OBB<float> b, float e) {
+    b.setBoxSize(b.u() * (b.h_u() + e), b.v() * (b.h_v() + e), b.h_w() + e);
+    return b;
+}
+// 以STEPS步逐步移动A, 首次与B相交的步数; 始终分离时为-1
+constexpr int STEPS = 2000;
+constexpr float TOL = 2e-3f;
+template <typename Box>
+static int first_step(const Box& A, const Vec3& delta, const Box& B) {
+    for (int s = 0; s <= STEPS; s++)
+        if (intersectTest(moved(A, delta * (float(s) / STEPS)), B) !=
+            CollisionResult::outer)
+            return s;
+    return -1;
+}
+// 命中时t处两盒接触且之前的各步都分离; 分步未发现的接触须发生在两步之间
+template <typename Box>
+static void check_sweep(const Box& A,
+                        const Vec3& delta,
+                        const Box& B,
+                        int q) {
+    float t = -1;
+    bool hit = intersectSweep(A, delta, B, &t);
+    int s = first_step(A, delta, B);
+    if (s >= 0) {
+        BL_CHECK(hit, "query %d: missed contact at step %d", q, s);
+        if (!hit)
+            return;
+        float ts = float(s) / STEPS;
+        float lo = s == 0 ? 0 : ts - 1.0f / STEPS - TOL;
+        BL_CHECK(s == 0 ? t == 0 : t >= lo && t <= ts + TOL,
+                 "query %d: t %g, substep contact at %g", q, t, ts);
+    } else if (hit) {
+        BL_CHECK(t >= 0 && t <= 1 &&
+                     intersectTest(moved(A, delta * t), grown(B, TOL)) !=
+                         CollisionResult::outer,
+                 "query %d: t %g but no contact there", q, t);
+    }
+}
+static void test_pairs() {
+    int hits = 0;
+    for (int q = 0; q < 3000; q++) {
+        // A从B附近出发, 大致朝向B移动; 部分位移有为0的分量
+        Vec3 cb(u(rng), u(rng), u(rng));
+        Vec3 ca = cb + Vec3(u(rng), u(rng), u(rng)).normalized() * 6 *
+                           (0.3f + std::abs(u(rng)));
+        Vec3 delta = (cb - ca) * (1.5f * std::abs(u(rng))) +
+                     Vec3(u(rng), u(rng), u(rng)) * 2;
+        if (q % 10 == 0)
+            delta[q / 10 % 3] = 0;
+        if (q % 100 == 0)
+            delta.setZero();
+        float ha = hs(rng), hb = hs(rng);
+        AABB<float> A{ca + Vec3::Constant(ha), ca - Vec3::Constant(ha)};
+        Vec3 hB(hb, hb * 0.5f, hb);
+        AABB<float> B{cb + hB, cb - hB};
+        check_sweep(A, delta, B, q);
+        OBB<float> oa = random_obb(ca), ob = random_obb(cb);
+        check_sweep(oa, delta, ob, q);
+        float t;
+        hits += intersectSweep(oa, delta, ob, &t);
+        // 轴对齐的OBB与AABB得到相同的接触时间
+        OBB<float> ia, ib;
+        ia.setBoxSize(A.h().x() * Vec3::UnitX(), A.h().y() * Vec3::UnitY(),
+                      A.h().z());
+        ia.setCenter(A.c());
+        ib.setBoxSize(B.h().x() * Vec3::UnitX(), B.h().y() * Vec3::UnitY(),
+                      B.h().z());
+        ib.setCenter(B.c());
+        float t0 = -1, t1 = -1;
+        bool h0 = intersectSweep(A, delta, B, &t0);
+        bool h1 = intersectSweep(ia, delta, ib, &t1);
+        BL_CHECK(h0 == h1 && (!h0 || std::abs(t0 - t1) < 1e-4f),
+                 "query %d: aabb %d %g, obb %d %g", q, h0, t0, h1, t1);
+    }
+    // 大部分查询应有接触, 否则测试没有意义
+    BL_CHECK(hits > 1000, "only %d obb sweeps hit", hits);
+}
+static void test_tree() {
+    using Tree = OctTree<uint32_t, float>;
+    const uint32_t n = 20000;
+    Tree tree;
+    tree.create({{100, 100, 100}, {-100, -100, -100}});
+    std::vector<AABB<float>> boxes(n);
+    for (uint32_t i = 0; i < n; i++) {
+        boxes[i] = i % 40 ? random_box(rng, 90, 0.1f, 1.5f)
+                          : random_box(rng, 80, 3, 12);
+        uint32_t node;
+        tree.data(tree.insert(boxes[i], &node)) = i;
+    }
+    std::vector<Tree::RayHit> hits;
+    size_t total = 0;
+    struct Ref {
+        float t;
+        uint32_t obj;
+    };
+    for (int q = 0; q < 300; q++) {
+        AABB<float> size = random_box(rng, 80, 0.5f, 4);
+        Vec3 delta = Vec3(u(rng), u(rng), u(rng)) * 60;
+        if (q % 10 == 0)
+            delta[q / 10 % 3] = 0;
+        if (q % 50 == 0)
+            delta.setZero();
+        std::vector<Ref> expect;
+        for (uint32_t i = 0; i < n; i++) {
+            float t;
+            if (intersectSweep(size, delta, boxes[i], &t))
+                expect.push_back({t, i});
+        }
+        total += expect.size();
+        std::sort(expect.begin(), expect.end(),
+                  [](const Ref& a, const Ref& b) { return a.t < b.t; });
+        // 不限个数时对象集合相同; 限k个时为最早接触的k个
+        for (uint32_t k : {~0u, 1u, 4u, 16u}) {
+            uint32_t count = tree.sweep(size, delta, hits, k);
+            size_t want = std::min<size_t>(k, expect.size());
+            bool ok = count == want && hits.size() == want;
+            for (size_t j = 0; ok && j < want; j++) {
+                uint32_t obj = tree.data(hits[j].block);
+                float t;
+                ok = hits[j].t == expect[j].t &&
+                     intersectSweep(size, delta, boxes[obj], &t) &&
+                     t == hits[j].t;
+            }
+            if (ok && k == ~0u) {
+                std::vector<uint32_t> got, ref;
+                for (const auto& h : hits)
+                    got.push_back(tree.data(h.block));
+                for (const auto& r : expect)
+                    ref.push_back(r.obj);
+                std::sort(got.begin(), got.end());
+                std::sort(ref.begin(), ref.end());
+                ok = got == ref;
+            }
+            BL_CHECK(ok, "tree sweep %d k=%u: %u hits, expected %zu", q, k,
+                     count, want);
+        }
+    }
+    BL_CHECK(total > 300 * 8, "only %zu swept contacts", total);
+}
+int main() {
+    test_pairs();
+    test_tree();
+    return bl_test_result();
+}
@@ -0,0 +1,125 @@
+// SweepAndPrune逐帧commit后, collectPairs与逐对测试的结果一致, added与removed
+// 恰为前后两帧重叠对集合之差; 每帧有移动, 瞬移, 插入与删除, 部分帧插入的对象
+// 超过REBUILD_RATIO而整体重建; 一半对象对齐到0.5的网格, 经常恰好接触
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include "bl_sweep_prune.hpp"
+#include "bl_test.hpp"
+using namespace BL::Math;
+using SAP = SweepAndPrune<uint32_t, float>;
+using Vec3 = BL::vec3<float>;
+struct Ref {
+    AABB<float> box;
+    uint32_t handle;
+    bool alive;
+};
+// 对的键由两个对象的编号组成, 小的在高位
+static uint64_t key_of(uint64_t a, uint64_t b) {
+    return std::min(a, b) << 32 | std::max(a, b);
+}
+static std::vector<uint64_t> keys_of(const SAP::PairList& pairs) {
+    std::vector<uint64_t> keys;
+    for (const auto& [a, b] : pairs)
+        keys.push_back(key_of(*a, *b));
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+int main() {
+    std::mt19937 rng(15);
+    std::uniform_real_distribution<float> d(-0.3f, 0.3f), s(0, 1);
+    std::uniform_int_distribution<int> g(-40, 40), step(-2, 2);
+    // 对象编号即refs下标, 删除后不再复用, 句柄由SAP复用
+    std::vector<Ref> refs;
+    SAP sap;
+    auto make_box = [&](uint32_t id) {
+        if (id % 2)
+            return random_box(rng, 20, 0.1f, 1.2f);
+        Vec3 c(g(rng) * 0.5f, g(rng) * 0.5f, g(rng) * 0.5f);
+        return AABB<float>{c + Vec3::Constant(0.5f), c - Vec3::Constant(0.5f)};
+    };
+    auto insert = [&] {
+        uint32_t id = refs.size();
+        AABB<float> b = make_box(id);
+        uint32_t h = sap.insert(b);
+        sap.data(h) = id;
+        refs.push_back({b, h, true});
+    };
+    for (int i = 0; i < 1500; i++)
+        insert();
+    std::vector<uint64_t> prev;
+    for (int frame = 0; frame < 40; frame++) {
+        uint32_t live = 0;
+        for (uint32_t id = 0; id < refs.size(); id++) {
+            Ref& r = refs[id];
+            if (!r.alive)
+                continue;
+            float u = s(rng);
+            if (frame > 0 && u < 0.02f) {
+                sap.drop(r.handle);
+                r.alive = false;
+                continue;
+            }
+            live++;
+            if (u < 0.03f) {
+                r.box = make_box(id);
+                sap.update(r.handle, r.box);
+            } else if (u < 0.5f) {
+                // 网格对象以0.25为步长移动, 保持坐标精确
+                Vec3 delta = id % 2 ? Vec3(d(rng), d(rng), d(rng))
+                                    : Vec3(step(rng), step(rng), step(rng)) *
+                                          0.25f;
+                sap.move(r.handle, delta);
+                r.box = {r.box.max() + delta, r.box.min() + delta};
+            }
+        }
+        // 每10帧插入超过live / REBUILD_RATIO个对象, 触发整体重建
+        uint32_t inserts =
+            frame % 10 == 5 ? live / SAP::REBUILD_RATIO + 10 : rng() % 30;
+        for (uint32_t i = 0; i < inserts; i++)
+            insert();
+        // 插入后立即删除的对象不应出现在任何对中
+        if (frame % 7 == 3) {
+            insert();
+            sap.drop(refs.back().handle);
+            refs.back().alive = false;
+        }
+        sap.commit();
+        std::vector<uint64_t> cur;
+        std::vector<uint32_t> ids;
+        for (uint32_t id = 0; id < refs.size(); id++)
+            if (refs[id].alive)
+                ids.push_back(id);
+        BL_CHECK(sap.size() == ids.size(), "frame %d: size %u vs %zu", frame,
+                 sap.size(), ids.size());
+        for (size_t i = 0; i < ids.size(); i++)
+            for (size_t j = i + 1; j < ids.size(); j++)
+                if (intersectTest(refs[ids[i]].box, refs[ids[j]].box) >=
+                    CollisionResult::intersect)
+                    cur.push_back(key_of(ids[i], ids[j]));
+        std::sort(cur.begin(), cur.end());
+        SAP::PairList pairs;
+        sap.collectPairs(pairs);
+        BL_CHECK(keys_of(pairs) == cur && sap.pairCount() == cur.size(),
+                 "frame %d: %zu pairs, expected %zu", frame, pairs.size(),
+                 cur.size());
+        std::vector<uint64_t> added, removed;
+        std::set_difference(cur.begin(), cur.end(), prev.begin(), prev.end(),
+                            std::back_inserter(added));
+        std::set_difference(prev.begin(), prev.end(), cur.begin(), cur.end(),
+                            std::back_inserter(removed));
+        BL_CHECK(keys_of(sap.added()) == added, "frame %d: %zu added vs %zu",
+                 frame, sap.added().size(), added.size());
+        BL_CHECK(keys_of(sap.removed()) == removed,
+                 "frame %d: %zu removed vs %zu", frame, sap.removed().size(),
+                 removed.size());
+        prev = std::move(cur);
+    }
+    // clear之后从空开始
+    sap.clear();
+    insert();
+    insert();
+    sap.commit();
+    BL_CHECK(sap.size() == 2 && sap.removed().empty(), "after clear");
+    return bl_test_result();
+}
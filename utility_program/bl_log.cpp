@@ -90,7 +90,7 @@ std::string getColorCode(ConsoleColor color) {
         case ConsoleColor::CyanIntensity:
             return "\033[36m;1m";
         default:
-            return 0;
+            return "";
     }
 }
 #endif
@@ -146,7 +146,7 @@ std::string getBackgroundColorCode(ConsoleBackgroundColor color) {
         case ConsoleBackgroundColor::None:
             return "\033[40m";
         default:
-            return 0;
+            return "";
     }
 }
 #endif
@@ -155,7 +155,7 @@ std::ostream& operator<<(std::ostream& os, ConsoleColor data) {
     HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
     SetConsoleTextAttribute(handle, getColorCode(data));
 #else
-    std::cout << GetColorCode(data);
+    os << getColorCode(data);
 #endif
     return os;
 }
@@ -165,7 +165,7 @@ std::ostream& operator<<(std::ostream& os, ConsoleBackgroundColor data) {
     HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
     SetConsoleTextAttribute(handle, getBackgroundColorCode(data));
 #else
-    std::cout << GetBackgroundColorCode(data);
+    os << getBackgroundColorCode(data);
 #endif
     return os;
 }
@@ -13,10 +13,11 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#include "BL/bl_mesh_bounds.hpp"
 #include "BL/ftypes.hpp"
 #include "BL/log.hpp"
 // command:
-// g++ command_program.cpp -ID:\c++programs\BoundlessVK\BoundlessVK\inc -ID:\vulkanSDK\Include -LD:\c++programs\BoundlessVK\BoundlessVK\utility_program -lzlib -lassimp -O3 -oBLC
+// g++ command_program.cpp -std=c++20 -I. -ID:\c++programs\BoundlessVK\BoundlessVK\inc -ID:\eigen3 -ID:\vulkanSDK\Include -LD:\c++programs\BoundlessVK\BoundlessVK\utility_program -lzlib -lassimp -O3 -oBLC
 using namespace BL;
 struct compressed_data {
     uint32_t real_size;
@@ -406,6 +407,24 @@ static uint8_t* collectVertexData(const aiMesh* mesh,
     return data;
 }
 
+static void computeMeshBounds(const aiMesh* mesh, MeshFileHead::Bounds& b) {
+    static_assert(sizeof(aiVector3D) == sizeof(float) * 3);
+    Math::PointStream points{(const uint8_t*)mesh->mVertices,
+                             mesh->mNumVertices, sizeof(aiVector3D)};
+    Math::AABB<float> box = Math::computeAABB(points);
+    Math::Sphere<float> sphere = Math::computeBoundingSphere(points);
+    Math::OBB<float> obb = Math::computeOBB(points);
+    for (uint32_t k = 0; k < 3; k++) {
+        b.aabbMax[k] = box.max()[k];
+        b.aabbMin[k] = box.min()[k];
+        b.sphereCenter[k] = sphere.c()[k];
+        b.obbCenter[k] = obb.c()[k];
+        b.obbU[k] = obb.u()[k];
+        b.obbV[k] = obb.v()[k];
+        b.obbHalf[k] = obb.h()[k];
+    }
+    b.sphereRadius = sphere.r();
+}
 compressed_data* collectIndexData(const aiMesh* mesh) {
     uint8_t *indicesData =
                 (uint8_t*)malloc(mesh->mNumFaces * sizeof(uint32_t) * 3),
@@ -460,6 +479,7 @@ void _makeMeshFile(const aiMesh* mesh,
     head.indexCount = mesh->mNumFaces * 3;
     head.restartEnable = 0; /*false*/
     head.restartIndex = 0;
+    computeMeshBounds(mesh, head.bounds);
 
     uint8_t* outData =
         collectVertexData(mesh, vertBufInfo.stride, vertBufInfo.data.offset);